@@ -0,0 +1,66 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef BOARD_H
+#define BOARD_H
+
+/** \brief Placa simulada para ejecutar el firmware en la computadora
+ **
+ ** Reemplaza al board.h de la EDU-CIAA-NXP, que incluye FreeRTOSConfig.h. En la computadora el tick lo da el puerto
+ ** POSIX de FreeRTOS y las interrupciones de los periféricos simulados las atiende una tarea de la mayor prioridad,
+ ** ver host/src/interrupciones.c. LOW_POWER solo se compila en tiempo virtual, porque el puerto POSIX no tiene la
+ ** supresión del tick; tampoco el núcleo virtual la simula, pero avanza de a un tick sin depender del puerto.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "chip.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#if defined(LOW_POWER) && (LOW_POWER == 1) && !(defined(VIRTUAL_TIME) && (VIRTUAL_TIME == 1))
+#error "LOW_POWER solo se simula en tiempo virtual: el puerto POSIX de FreeRTOS no suprime el tick"
+#endif
+
+    /* === Public data type declarations =========================================================== */
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* BOARD_H */
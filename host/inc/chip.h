@@ -0,0 +1,401 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef CHIP_H
+#define CHIP_H
+
+/** \brief Modelo del LPC4337 para ejecutar el firmware en la computadora
+ **
+ ** Reemplaza al chip.h de LPCOpen en la compilación para la computadora. Declara solo los registros y funciones que
+ ** usan bspreloj.c y digital.c, con los mismos nombres y parámetros, de modo que esos módulos compilan sin cambios.
+ ** Las funciones de GPIO guardan el estado de los puertos e informan cada cambio de las salidas al poncho simulado,
+ ** la UART y el DMA trabajan sobre la pseudo terminal del simulador y el resto de los periféricos no hace nada.
+ **
+ ** El DMA envía cada bloque en el momento y pide su interrupción al terminar. Lo que llega a la pseudo terminal lo
+ ** copia el DMA de recepción en SimulatorHardwareTick, una vez por milisegundo, y ahí mismo la UART pide la
+ ** interrupción de datos recibidos, como también el temporizador repetitivo al cumplir su período y cada canal de
+ ** interrupción de terminal cuyo nivel cambió desde el milisegundo anterior.
+ **
+ ** La EEPROM es un arreglo en memoria que se lee y escribe con las mismas direcciones que arma EEPROM_ADDRESS. Si la
+ ** variable de entorno RELOJ_EEPROM indica un archivo, el contenido se carga de ese archivo al inicializarla y se
+ ** guarda en él con cada comando de programación, de modo que sobrevive de una ejecución a la siguiente.
+ **
+ ** Los registros del RTC se actualizan en cada acceso con el tiempo transcurrido desde el último, que da el reloj
+ ** monótono de la computadora o, en la simulación en tiempo virtual, el tick del núcleo. Como en una placa sin
+ ** batería, el RTC y los registros de respaldo empiezan en cero en cada ejecución.
+ **
+ ** Solo incluye cabeceras que no declaran clock_t, que choca con el tipo de reloj.h.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** \brief Firmware en la computadora con el poncho simulado
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad de puertos GPIO del modelo.
+#define GPIO_PORTS 8
+
+//! Cantidad de canales del DMA.
+#define GPDMA_CHANNELS 8
+
+//! Cantidad de canales de interrupción de terminal.
+#define PININT_CHANNELS 8
+
+//! Bits de prioridad de las interrupciones, los mismos del Cortex-M4.
+#define __NVIC_PRIO_BITS 3
+
+#define LPC_GPIO_PORT (&SimulatedGpio)
+#define LPC_RITIMER   (&SimulatedRitimer)
+#define LPC_USART2    (&SimulatedUsart2)
+#define LPC_EEPROM    (&SimulatedEeprom)
+#define LPC_REGFILE   (&SimulatedRegfile)
+
+#define LPC_GPDMA     (&SimulatedGpdma)
+
+#define LPC_GPIO_PIN_INT (&SimulatedPinInt)
+
+#define PININTCH(ch) (1 << (ch))
+
+//! Cada acceso a los registros del RTC suma los segundos transcurridos, como si el RTC hubiera contado.
+#define LPC_RTC (SimulatorRtc())
+
+#define SCU_MODE_PULLUP    (0x0 << 3)
+#define SCU_MODE_REPEATER  (0x1 << 3)
+#define SCU_MODE_INACT     (0x2 << 3)
+#define SCU_MODE_PULLDOWN  (0x3 << 3)
+#define SCU_MODE_INBUFF_EN (0x1 << 6)
+#define SCU_MODE_FUNC0     0x0
+#define SCU_MODE_FUNC1     0x1
+#define SCU_MODE_FUNC2     0x2
+#define SCU_MODE_FUNC3     0x3
+#define SCU_MODE_FUNC4     0x4
+#define SCU_MODE_FUNC5     0x5
+#define SCU_MODE_FUNC6     0x6
+#define SCU_MODE_FUNC7     0x7
+
+#define UART_LCR_WLEN8       (3 << 0)
+#define UART_LCR_SBS_1BIT    (0 << 2)
+#define UART_LCR_PARITY_DIS  (0 << 3)
+#define UART_FCR_FIFO_EN     (1 << 0)
+#define UART_FCR_TRG_LEV0    (0 << 6)
+#define UART_FCR_DMAMODE_SEL (1 << 3)
+#define UART_IER_RBRINT      (1 << 0)
+#define UART_LSR_RDR         (1 << 0)
+
+#define EEPROM_PAGE_SIZE             128
+#define EEPROM_PAGE_NUM              128
+#define EEPROM_START                 ((uintptr_t)SimulatedEepromMemory)
+#define EEPROM_ADDRESS(page, offset) (EEPROM_START + (EEPROM_PAGE_SIZE * (page)) + (offset))
+#define EEPROM_AUTOPROG_OFF          0
+#define EEPROM_CMD_ERASE_PRG_PAGE    6
+#define EEPROM_INT_ENDOFPROG         (1 << 2)
+
+#define RTC_CCR_CLKEN (1 << 0)
+
+#define REGFILE_REGISTERS 64
+
+#define GPDMA_CONN_MEMORY   0
+#define GPDMA_CONN_UART2_Tx 10
+#define GPDMA_CONN_UART2_Rx 12
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Resultado de las funciones de LPCOpen.
+    typedef enum
+    {
+        ERROR = 0,
+        SUCCESS = !ERROR
+    } Status;
+
+    //! Habilitación de un periférico en las funciones de LPCOpen.
+    typedef enum
+    {
+        DISABLE = 0,
+        ENABLE = !DISABLE
+    } FunctionalState;
+
+    //! Relojes de los periféricos que consulta el firmware.
+    typedef enum
+    {
+        CLK_MX_RITIMER,
+    } CHIP_CCU_CLK_T;
+
+    //! Interrupciones que usa el firmware, con los números del LPC43xx.
+    typedef enum
+    {
+        SysTick_IRQn = -1,
+        DMA_IRQn = 2,
+        RITIMER_IRQn = 11,
+        USART2_IRQn = 26,
+        PIN_INT0_IRQn = 32,
+        PIN_INT1_IRQn = 33,
+        PIN_INT2_IRQn = 34,
+        PIN_INT3_IRQn = 35,
+        PIN_INT4_IRQn = 36,
+        PIN_INT5_IRQn = 37,
+        PIN_INT6_IRQn = 38,
+        PIN_INT7_IRQn = 39,
+    } IRQn_Type;
+
+    //! Puertos GPIO: dirección, nivel de las entradas y nivel escrito en las salidas.
+    typedef struct
+    {
+        uint32_t DIR[GPIO_PORTS];
+        uint32_t PIN[GPIO_PORTS];
+        uint32_t SET[GPIO_PORTS];
+        uint32_t MASK[GPIO_PORTS];
+    } LPC_GPIO_T;
+
+    //! Temporizador repetitivo, en tiempo virtual cuenta milisegundos e interrumpe al llegar a COMPVAL.
+    typedef struct
+    {
+        uint32_t COMPVAL;
+        uint32_t CTRL;
+        uint32_t COUNTER;
+    } LPC_RITIMER_T;
+
+    //! Interrupciones de terminal: modo por nivel, flancos habilitados y flancos detectados de cada canal.
+    typedef struct
+    {
+        uint32_t ISEL;
+        uint32_t IENR;
+        uint32_t IENF;
+        uint32_t IST;
+    } LPC_PIN_INT_T;
+
+    //! UART, guarda la configuración y las interrupciones habilitadas; los datos los mueve el DMA.
+    typedef struct
+    {
+        uint32_t BAUD;
+        uint32_t LCR;
+        uint32_t FCR;
+        uint32_t TER;
+        uint32_t IER;
+    } LPC_USART_T;
+
+    //! EEPROM, el contenido está en SimulatedEepromMemory.
+    typedef struct
+    {
+        uint32_t CMD;
+        uint32_t AUTOPROG;
+        uint32_t INTSTAT;
+    } LPC_EEPROM_T;
+
+    //! Campos de la hora del RTC.
+    typedef enum
+    {
+        RTC_TIMETYPE_SECOND,
+        RTC_TIMETYPE_MINUTE,
+        RTC_TIMETYPE_HOUR,
+        RTC_TIMETYPE_DAYOFMONTH,
+        RTC_TIMETYPE_DAYOFWEEK,
+        RTC_TIMETYPE_DAYOFYEAR,
+        RTC_TIMETYPE_MONTH,
+        RTC_TIMETYPE_YEAR,
+        RTC_TIMETYPE_LAST
+    } RTC_TIMEINDEX_T;
+
+    //! RTC, cuenta segundos, minutos y horas; CTIME[0] los tiene juntos como en el LPC43xx.
+    typedef struct
+    {
+        uint32_t ILR;
+        uint32_t RESERVED0;
+        uint32_t CCR;
+        uint32_t CIIR;
+        uint32_t AMR;
+        uint32_t CTIME[3];
+        uint32_t TIME[RTC_TIMETYPE_LAST];
+    } LPC_RTC_T;
+
+    //! Registros de respaldo del dominio de la batería.
+    typedef struct
+    {
+        uint32_t REGFILE[REGFILE_REGISTERS];
+    } LPC_REGFILE_T;
+
+    //! Tipos de transferencia del DMA.
+    typedef enum
+    {
+        GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA = 0,
+        GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA = 1,
+        GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA = 2,
+        GPDMA_TRANSFERTYPE_P2P_CONTROLLER_DMA = 3,
+    } GPDMA_FLOW_CONTROL_T;
+
+    //! Descriptor de una transferencia encadenada, con direcciones del ancho de un puntero de la computadora.
+    typedef struct
+    {
+        uintptr_t src;
+        uintptr_t dst;
+        uintptr_t lli;
+        uint32_t ctrl;
+    } DMA_TransferDescriptor_t;
+
+    //! Canal del DMA, CONTROL guarda la cantidad de bytes que faltan transferir.
+    typedef struct
+    {
+        uintptr_t SRCADDR;
+        uintptr_t DESTADDR;
+        uintptr_t LLI;
+        uint32_t CONTROL;
+        uint32_t CONFIG;
+    } GPDMA_CH_T;
+
+    //! Controlador del DMA.
+    typedef struct
+    {
+        uint32_t INTTCSTAT;
+        GPDMA_CH_T CH[GPDMA_CHANNELS];
+    } LPC_GPDMA_T;
+
+    /* === Public variable declarations ============================================================ */
+
+    extern uint32_t SystemCoreClock;
+    extern LPC_GPIO_T SimulatedGpio;
+    extern LPC_RITIMER_T SimulatedRitimer;
+    extern LPC_PIN_INT_T SimulatedPinInt;
+    extern LPC_USART_T SimulatedUsart2;
+    extern LPC_EEPROM_T SimulatedEeprom;
+    extern uint32_t SimulatedEepromMemory[EEPROM_PAGE_NUM * EEPROM_PAGE_SIZE / sizeof(uint32_t)];
+    extern LPC_REGFILE_T SimulatedRegfile;
+    extern LPC_GPDMA_T SimulatedGpdma;
+
+    /* === Public function declarations ============================================================ */
+
+    static inline void __disable_irq(void)
+    {
+    }
+
+    static inline void __enable_irq(void)
+    {
+    }
+
+    static inline uint32_t __get_PRIMASK(void)
+    {
+        return 0;
+    }
+
+    static inline void __set_PRIMASK(uint32_t priMask)
+    {
+        (void)priMask;
+    }
+
+    //! No hay tarea inactiva que duerma: el puerto POSIX y el núcleo virtual esperan por su cuenta.
+    static inline void __WFI(void)
+    {
+    }
+
+    /**
+     * @brief Número de la excepción en curso, como el registro IPSR: distinto de cero mientras el modelo atiende una
+     * interrupción.
+     */
+    uint32_t __get_IPSR(void);
+
+    void SystemCoreClockUpdate(void);
+    uint32_t SysTick_Config(uint32_t ticks);
+    void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+    void NVIC_EnableIRQ(IRQn_Type IRQn);
+
+    void Chip_SCU_PinMuxSet(uint8_t port, uint8_t pin, uint16_t modefunc);
+    void Chip_SCU_GPIOIntPinSel(uint8_t PortSel, uint8_t PortNum, uint8_t PinNum);
+
+    void Chip_GPIO_SetPinDIR(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool output);
+    void Chip_GPIO_SetPortDIRInput(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pinMask);
+    void Chip_GPIO_SetPinState(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool setting);
+    void Chip_GPIO_SetPinToggle(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin);
+    void Chip_GPIO_SetValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue);
+    void Chip_GPIO_ClearValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue);
+    void Chip_GPIO_SetPortToggle(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pins);
+    void Chip_GPIO_SetPortMask(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t mask);
+    void Chip_GPIO_SetMaskedPortValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t value);
+    bool Chip_GPIO_ReadPortBit(LPC_GPIO_T * pGPIO, uint32_t port, uint8_t pin);
+    uint32_t Chip_GPIO_GetPortValue(LPC_GPIO_T * pGPIO, uint8_t port);
+
+    void Chip_PININT_Init(LPC_PIN_INT_T * pPININT);
+    void Chip_PININT_SetPinModeEdge(LPC_PIN_INT_T * pPININT, uint32_t pins);
+    void Chip_PININT_EnableIntHigh(LPC_PIN_INT_T * pPININT, uint32_t pins);
+    void Chip_PININT_DisableIntHigh(LPC_PIN_INT_T * pPININT, uint32_t pins);
+    void Chip_PININT_EnableIntLow(LPC_PIN_INT_T * pPININT, uint32_t pins);
+    void Chip_PININT_DisableIntLow(LPC_PIN_INT_T * pPININT, uint32_t pins);
+    void Chip_PININT_ClearIntStatus(LPC_PIN_INT_T * pPININT, uint32_t pins);
+
+    void Chip_RIT_Init(LPC_RITIMER_T * pRITimer);
+    void Chip_RIT_SetTimerInterval(LPC_RITIMER_T * pRITimer, uint32_t time_interval);
+    void Chip_RIT_ClearInt(LPC_RITIMER_T * pRITimer);
+    uint32_t Chip_RIT_GetCounter(LPC_RITIMER_T * pRITimer);
+
+    uint32_t Chip_Clock_GetRate(CHIP_CCU_CLK_T clk);
+
+    void Chip_UART_Init(LPC_USART_T * pUART);
+    uint32_t Chip_UART_SetBaud(LPC_USART_T * pUART, uint32_t baudrate);
+    void Chip_UART_ConfigData(LPC_USART_T * pUART, uint32_t config);
+    void Chip_UART_SetupFIFOS(LPC_USART_T * pUART, uint32_t fcr);
+    void Chip_UART_TXEnable(LPC_USART_T * pUART);
+    void Chip_UART_IntEnable(LPC_USART_T * pUART, uint32_t intMask);
+    uint32_t Chip_UART_ReadIntIDReg(LPC_USART_T * pUART);
+    uint32_t Chip_UART_ReadLineStatus(LPC_USART_T * pUART);
+
+    void Chip_EEPROM_Init(LPC_EEPROM_T * pEEPROM);
+    void Chip_EEPROM_SetAutoProg(LPC_EEPROM_T * pEEPROM, uint32_t mode);
+    uint32_t Chip_EEPROM_GetIntStatus(LPC_EEPROM_T * pEEPROM);
+    void Chip_EEPROM_ClearIntStatus(LPC_EEPROM_T * pEEPROM, uint32_t mask);
+    void Chip_EEPROM_SetCmd(LPC_EEPROM_T * pEEPROM, uint32_t cmd);
+
+    LPC_RTC_T * SimulatorRtc(void);
+    void Chip_RTC_Init(LPC_RTC_T * pRTC);
+    void Chip_RTC_Enable(LPC_RTC_T * pRTC, FunctionalState NewState);
+    void Chip_RTC_SetTime(LPC_RTC_T * pRTC, RTC_TIMEINDEX_T Timetype, uint32_t TimeValue);
+    uint32_t Chip_REGFILE_Read(LPC_REGFILE_T * pRegFile, int index);
+    void Chip_REGFILE_Write(LPC_REGFILE_T * pRegFile, int index, uint32_t value);
+
+    void Chip_GPDMA_Init(LPC_GPDMA_T * pGPDMA);
+    uint8_t Chip_GPDMA_GetFreeChannel(LPC_GPDMA_T * pGPDMA, uint32_t PeripheralConnection_ID);
+    Status Chip_GPDMA_Transfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, uintptr_t src, uintptr_t dst,
+                               GPDMA_FLOW_CONTROL_T TransferType, uint32_t Size);
+    Status Chip_GPDMA_InitDescriptor(LPC_GPDMA_T * pGPDMA, DMA_TransferDescriptor_t * DMADescriptor, uintptr_t src,
+                                     uintptr_t dst, uint32_t Size, GPDMA_FLOW_CONTROL_T TransferType,
+                                     const DMA_TransferDescriptor_t * NextDescriptor);
+    Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, const DMA_TransferDescriptor_t * DMADescriptor,
+                                 GPDMA_FLOW_CONTROL_T TransferType);
+    Status Chip_GPDMA_Interrupt(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* CHIP_H */
@@ -0,0 +1,133 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef MODELO_H
+#define MODELO_H
+
+/** \brief Modelo del poncho
+ **
+ ** Reconstruye lo que muestra la pantalla y el estado del zumbador a partir de las salidas de los puertos GPIO, y
+ ** ubica las teclas por nombre. Lo comparten el simulador en tiempo real y la simulación en tiempo virtual, que solo
+ ** difieren en cómo reciben los comandos y en qué base de tiempo usan.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#ifndef DIGITOS
+#define DIGITOS 4
+#endif
+
+//! Tamaño del texto de un cuadro: un carácter y un punto por dígito, más el terminador.
+#define MODEL_TEXT_SIZE (2 * DIGITOS + 1)
+
+//! Columna de una tecla que no está en el teclado matricial y se lee en su propio terminal.
+#define MODEL_KEY_DIRECT (-1)
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Tecla del poncho.
+    typedef struct
+    {
+        const char * name; //!< Nombre en los comandos: f1, f2, f3, f4, aceptar o cancelar.
+        uint8_t gpio;      //!< Puerto GPIO de la tecla.
+        uint8_t bit;       //!< Terminal dentro del puerto, la fila con el teclado matricial.
+        int8_t column;     //!< Columna del teclado matricial o MODEL_KEY_DIRECT.
+    } model_key_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Actualiza el modelo con las salidas de un puerto.
+     *
+     * @param port      Número de puerto.
+     * @param outputs   Nivel de los terminales configurados como salida.
+     * @return true Con este cambio terminó un barrido completo de la pantalla.
+     * @return false El barrido sigue en curso o el puerto no maneja la pantalla.
+     */
+    bool ModelOutputsChanged(uint8_t port, uint32_t outputs);
+
+    /**
+     * @brief Devuelve el último cuadro que se repitió en dos barridos seguidos, lo que descarta los cuadros de
+     * transición mientras la tarea cambia el contenido de la pantalla.
+     *
+     * @return uint64_t Un byte por dígito con los segmentos encendidos, el dígito de la izquierda en el byte menos
+     * significativo.
+     */
+    uint64_t ModelFrame(void);
+
+    /**
+     * @brief Consulta si el zumbador está sonando.
+     */
+    bool ModelBuzzer(void);
+
+    /**
+     * @brief Escribe un cuadro como texto, con un espacio por cada dígito apagado y '?' si los segmentos no forman un
+     * número.
+     *
+     * @param frame Cuadro como lo devuelve ModelFrame.
+     * @param text  Destino de MODEL_TEXT_SIZE caracteres.
+     */
+    void ModelFrameText(uint64_t frame, char * text);
+
+    /**
+     * @brief Presiona o suelta una tecla.
+     *
+     * Una tecla directa cambia el nivel de su terminal. Una tecla del teclado matricial cambia el nivel de su fila
+     * solo mientras la pantalla enciende su columna. Se puede llamar desde el hilo del simulador mientras corren las
+     * tareas.
+     *
+     * @param key       Tecla como la devuelve ModelFindKey.
+     * @param pressed   Verdadero para presionarla, falso para soltarla.
+     */
+    void ModelSetKey(const model_key_t * key, bool pressed);
+
+    /**
+     * @brief Busca una tecla por su nombre.
+     *
+     * @return const model_key_t* Tecla encontrada, NULL si el nombre no existe o es NULL.
+     */
+    const model_key_t * ModelFindKey(const char * name);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* MODELO_H */
@@ -0,0 +1,68 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef MONOTONICO_H
+#define MONOTONICO_H
+
+/** \brief Fuente de la hora con el reloj monótono de la computadora
+ **
+ ** Fuente para ClockSetSource que cuenta la hora con CLOCK_MONOTONIC desde el momento en que se fijó, de modo que un
+ ** programa de la computadora no tiene que llamar a ClockRefresh en cada milisegundo para que el reloj avance, ni
+ ** acumula la deriva de dormir un período fijo. No tiene hora fijada hasta la primera escritura.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "reloj.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* === Public macros definitions =============================================================== */
+
+    /* === Public data type declarations =========================================================== */
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Devuelve la fuente de la hora con el reloj monótono.
+     *
+     * @return clock_source_t Puntero a la fuente, la misma en cada llamada.
+     */
+    clock_source_t MonotonicClockCreate(void);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* MONOTONICO_H */
@@ -0,0 +1,121 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef SIMULADOR_H
+#define SIMULADOR_H
+
+/** \brief Poncho simulado
+ **
+ ** El modelo de GPIO de chip.c informa cada cambio de las salidas al poncho simulado, que arma con los dígitos y los
+ ** segmentos una pantalla sin gráficos y sigue el estado del zumbador. Un hilo propio, fuera de FreeRTOS, lee comandos
+ ** de la entrada estándar para presionar las teclas e informa por la salida estándar los cambios de la pantalla y del
+ ** zumbador, de modo que una prueba puede guiar al equipo con un guion y comparar lo que muestra.
+ **
+ ** Comandos, uno por línea, las líneas vacías y las que empiezan con '#' se ignoran:
+ **
+ **     presionar TECLA         deja presionada la tecla: f1, f2, f3, f4, aceptar o cancelar
+ **     soltar TECLA            suelta la tecla
+ **     pulsar TECLA [MS]       presiona la tecla durante MS milisegundos, 200 si no se indica
+ **     esperar MS              demora los comandos siguientes
+ **     pantalla                muestra lo que indica la pantalla
+ **     salir                   termina el programa, como el fin de la entrada estándar
+ **
+ ** Salida, una línea por evento:
+ **
+ **     uart /dev/pts/N         pseudo terminal conectada a la UART de depuración, para tools/consola.py
+ **     pantalla [12.34]        contenido de la pantalla, con un espacio por cada dígito apagado
+ **     zumbador si|no          el zumbador empieza o deja de sonar
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+    /* === Public data type declarations =========================================================== */
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Informa que cambiaron las salidas de un puerto GPIO, lo llama el modelo de GPIO desde las tareas.
+     *
+     * @param port      Número de puerto.
+     * @param outputs   Nivel de los terminales configurados como salida.
+     */
+    void SimulatorOutputsChanged(uint8_t port, uint32_t outputs);
+
+    /**
+     * @brief Fija el nivel que leen los terminales configurados como entrada, lo implementa el modelo de GPIO.
+     *
+     * Se puede llamar desde el hilo del simulador mientras corren las tareas.
+     *
+     * @param port      Número de puerto.
+     * @param pin       Número de terminal dentro del puerto.
+     * @param level     Nivel del terminal.
+     */
+    void SimulatorSetInput(uint8_t port, uint8_t pin, bool level);
+
+    /**
+     * @brief Devuelve el extremo maestro de la pseudo terminal conectada a la UART de depuración.
+     *
+     * @return int Descriptor de archivo en modo no bloqueante, negativo si no se pudo abrir.
+     */
+    int SimulatorSerial(void);
+
+    /**
+     * @brief Cuenta un milisegundo en los periféricos del modelo de la placa y atiende sus interrupciones, lo
+     * implementa el modelo del LPC4337.
+     *
+     * Copia lo que llegó por la UART de depuración al buffer del DMA de recepción y pide la interrupción de la UART,
+     * después hace avanzar el temporizador repetitivo y revisa los flancos de las interrupciones de terminal. Se
+     * llama una vez por tick, desde el núcleo virtual o desde la tarea que hace de controlador de interrupciones con
+     * el puerto POSIX de FreeRTOS.
+     */
+    void SimulatorHardwareTick(void);
+
+    /**
+     * @brief Crea la tarea que atiende las interrupciones de los periféricos simulados con el puerto POSIX de FreeRTOS,
+     * la llama el modelo del SysTick antes de arrancar el planificador.
+     */
+    void SimulatorStartInterrupts(void);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* SIMULADOR_H */
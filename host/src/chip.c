@@ -0,0 +1,875 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Modelo del LPC4337 para ejecutar el firmware en la computadora
+ **
+ ** Los puertos GPIO guardan la dirección, el nivel escrito en las salidas y el nivel de las entradas, que fija el
+ ** poncho simulado desde su propio hilo. La transmisión por DMA escribe de una vez en la pseudo terminal y atiende la
+ ** interrupción de fin de transferencia antes de volver. La recepción se hace en SimulatorHardwareTick: lo que llegó a
+ ** la pseudo terminal se copia al buffer del canal, se sigue el descriptor enlazado al llegar al final, como lo haría
+ ** el hardware, y se pide la interrupción de datos recibidos de la UART.
+ **
+ ** Las interrupciones de terminal comparan, también en SimulatorHardwareTick, el nivel de cada canal asignado con el
+ ** del milisegundo anterior: un cambio es un flanco, y si está habilitado queda pendiente hasta que la atención lo
+ ** borre. Un pulso más corto que un milisegundo no se ve, como no lo vería el poncho simulado.
+ **
+ ** La programación de una página de la EEPROM termina en el momento, guardando la memoria entera en el archivo de
+ ** RELOJ_EEPROM si se indicó.
+ **
+ ** El RTC guarda el momento en que contó el último segundo; cada acceso a sus registros suma los segundos enteros
+ ** transcurridos desde entonces y arma CTIME[0] con la hora resultante. Escribir la hora no cambia ese momento, como
+ ** en el LPC43xx, donde el divisor sigue contando.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "chip.h"
+#include "simulador.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(VIRTUAL_TIME) && (VIRTUAL_TIME == 1)
+#include "virtual.h"
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+//! Bit de habilitación del registro CONFIG de un canal.
+#define CANAL_HABILITADO (1 << 0)
+
+//! Posición del tipo de transferencia en el registro CONFIG de un canal.
+#define CANAL_TIPO_POS 11
+
+//! Segundos de un día.
+#define SEGUNDOS_DIA 86400
+
+//! Excepciones del Cortex-M4 anteriores a la primera interrupción de los periféricos, para el valor de IPSR.
+#define EXCEPCIONES_INTERNAS 16
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+//! Atención de las interrupciones del DMA, del temporizador repetitivo y de la UART, definidas en bspreloj.c.
+void DMA_IRQHandler(void);
+void RIT_IRQHandler(void);
+void UART2_IRQHandler(void);
+
+//! Atención de las interrupciones de terminal; las que bspreloj.c no define valen NULL, como un vector sin usar.
+void GPIO0_IRQHandler(void) __attribute__((weak));
+void GPIO1_IRQHandler(void) __attribute__((weak));
+void GPIO2_IRQHandler(void) __attribute__((weak));
+void GPIO3_IRQHandler(void) __attribute__((weak));
+void GPIO4_IRQHandler(void) __attribute__((weak));
+void GPIO5_IRQHandler(void) __attribute__((weak));
+void GPIO6_IRQHandler(void) __attribute__((weak));
+void GPIO7_IRQHandler(void) __attribute__((weak));
+
+/**
+ * @brief Atiende una interrupción si está habilitada, con el número de excepción que devuelve __get_IPSR.
+ */
+static void Interrumpir(IRQn_Type irq, void (*atencion)(void));
+
+/**
+ * @brief Marca los flancos habilitados de los canales de interrupción de terminal y atiende los pendientes.
+ */
+static void InterrumpirTerminales(void);
+
+/**
+ * @brief Informa al poncho simulado el nivel de las salidas de un puerto.
+ */
+static void ActualizarSalidas(uint8_t port);
+
+/**
+ * @brief Termina el bloque actual de un canal: carga el descriptor enlazado o deshabilita el canal y pide la
+ * interrupción de fin de transferencia.
+ */
+static void TerminarBloque(LPC_GPDMA_T * dma, uint8_t canal);
+
+/**
+ * @brief Copia lo recibido por la pseudo terminal al buffer de un canal de recepción habilitado.
+ *
+ * @return true Se copió al menos un byte.
+ */
+static bool Recibir(LPC_GPDMA_T * dma, uint8_t canal);
+
+/**
+ * @brief Milisegundos desde un origen fijo: el reloj monótono o, en tiempo virtual, un milisegundo por tick.
+ */
+static uint64_t Milisegundos(void);
+
+/* === Public variable definitions ============================================================= */
+
+uint32_t SystemCoreClock = 204000000;
+LPC_GPIO_T SimulatedGpio = {0};
+LPC_RITIMER_T SimulatedRitimer = {0};
+LPC_PIN_INT_T SimulatedPinInt = {0};
+LPC_USART_T SimulatedUsart2 = {0};
+LPC_EEPROM_T SimulatedEeprom = {0};
+uint32_t SimulatedEepromMemory[EEPROM_PAGE_NUM * EEPROM_PAGE_SIZE / sizeof(uint32_t)] = {0};
+LPC_REGFILE_T SimulatedRegfile = {0};
+LPC_GPDMA_T SimulatedGpdma = {0};
+
+/* === Private variable definitions ============================================================ */
+
+static bool canal_asignado[GPDMA_CHANNELS] = {0};
+static uint64_t interrupciones_habilitadas = 0;
+static uint32_t excepcion = 0; // Excepción en curso, la que devuelve __get_IPSR
+static uint32_t informadas[GPIO_PORTS] = {0};
+static int eeprom = -1;
+static LPC_RTC_T rtc = {0};
+static uint64_t rtc_segundo = 0; // Momento en milisegundos en que el RTC contó el último segundo
+
+// Terminal asignado a cada canal de interrupción y nivel que tenía en el milisegundo anterior
+static uint8_t terminal_puerto[PININT_CHANNELS] = {0};
+static uint8_t terminal_bit[PININT_CHANNELS] = {0};
+static uint32_t terminales_asignados = 0;
+static uint32_t terminales_niveles = 0;
+static void (*const terminal_atencion[PININT_CHANNELS])(void) = {
+    GPIO0_IRQHandler, GPIO1_IRQHandler, GPIO2_IRQHandler, GPIO3_IRQHandler,
+    GPIO4_IRQHandler, GPIO5_IRQHandler, GPIO6_IRQHandler, GPIO7_IRQHandler,
+};
+
+/* === Private function implementation ========================================================= */
+
+static void ActualizarSalidas(uint8_t port)
+{
+    uint32_t salidas = SimulatedGpio.SET[port] & SimulatedGpio.DIR[port];
+
+    // Las escrituras que no cambian las salidas no se informan, el barrido de la pantalla repite muchas
+    if (salidas != informadas[port])
+    {
+        informadas[port] = salidas;
+        SimulatorOutputsChanged(port, salidas);
+    }
+
+    return;
+}
+
+static void TerminarBloque(LPC_GPDMA_T * dma, uint8_t canal)
+{
+    GPDMA_CH_T * registros = &dma->CH[canal];
+
+    if (registros->LLI)
+    {
+        const DMA_TransferDescriptor_t * siguiente = (const DMA_TransferDescriptor_t *)registros->LLI;
+
+        registros->SRCADDR = siguiente->src;
+        registros->DESTADDR = siguiente->dst;
+        registros->LLI = siguiente->lli;
+        registros->CONTROL = siguiente->ctrl;
+    }
+    else
+    {
+        registros->CONFIG &= ~CANAL_HABILITADO;
+        dma->INTTCSTAT |= (1 << canal);
+        Interrumpir(DMA_IRQn, DMA_IRQHandler);
+    }
+
+    return;
+}
+
+static bool Recibir(LPC_GPDMA_T * dma, uint8_t canal)
+{
+    GPDMA_CH_T * registros = &dma->CH[canal];
+    int puerto = SimulatorSerial();
+    bool recibido = false;
+
+    // Dos lecturas alcanzan cuando lo recibido da la vuelta al buffer circular
+    for (int vuelta = 0; (vuelta < 2) && (puerto >= 0) && (registros->CONFIG & CANAL_HABILITADO); vuelta++)
+    {
+        ssize_t leidos = read(puerto, (void *)registros->DESTADDR, registros->CONTROL);
+
+        if (leidos <= 0)
+        {
+            break;
+        }
+        registros->DESTADDR += leidos;
+        registros->CONTROL -= leidos;
+        recibido = true;
+        if (registros->CONTROL == 0)
+        {
+            TerminarBloque(dma, canal);
+        }
+    }
+
+    return recibido;
+}
+
+static void Interrumpir(IRQn_Type irq, void (*atencion)(void))
+{
+    uint32_t anterior = excepcion; // La atención de la UART puede enviar, y el fin del DMA se atiende adentro
+
+    if (atencion && (interrupciones_habilitadas & (1ULL << irq)))
+    {
+        excepcion = irq + EXCEPCIONES_INTERNAS;
+#if defined(VIRTUAL_TIME) && (VIRTUAL_TIME == 1)
+        VirtualInterruptEnter();
+        atencion();
+        VirtualInterruptExit();
+#else
+        atencion();
+#endif
+        excepcion = anterior;
+    }
+
+    return;
+}
+
+static void InterrumpirTerminales(void)
+{
+    for (uint8_t canal = 0; canal < PININT_CHANNELS; canal++)
+    {
+        uint32_t bit = PININTCH(canal);
+
+        if (terminales_asignados & bit)
+        {
+            bool nivel = Chip_GPIO_ReadPortBit(&SimulatedGpio, terminal_puerto[canal], terminal_bit[canal]);
+            uint32_t habilitado = nivel ? SimulatedPinInt.IENR : SimulatedPinInt.IENF;
+
+            if (nivel != ((terminales_niveles & bit) != 0))
+            {
+                terminales_niveles ^= bit;
+                // Solo se modela la detección de flancos, la que usa el firmware
+                if (!(SimulatedPinInt.ISEL & bit) && (habilitado & bit))
+                {
+                    SimulatedPinInt.IST |= bit;
+                }
+            }
+        }
+
+        // Un flanco pendiente sigue pidiendo la interrupción hasta que la atención lo borre
+        if (SimulatedPinInt.IST & bit)
+        {
+            Interrumpir(PIN_INT0_IRQn + canal, terminal_atencion[canal]);
+        }
+    }
+
+    return;
+}
+
+static uint64_t Milisegundos(void)
+{
+#if defined(VIRTUAL_TIME) && (VIRTUAL_TIME == 1)
+    return VirtualTicks();
+#else
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+
+    return (uint64_t)ahora.tv_sec * 1000 + ahora.tv_nsec / 1000000;
+#endif
+}
+
+/* === Public function implementation ========================================================== */
+
+void SystemCoreClockUpdate(void)
+{
+    return;
+}
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+    (void)ticks; // El tick lo genera el puerto POSIX de FreeRTOS, o el núcleo virtual junto con las interrupciones
+
+#if !(defined(VIRTUAL_TIME) && (VIRTUAL_TIME == 1))
+    SimulatorStartInterrupts();
+#endif
+
+    return 0;
+}
+
+uint32_t __get_IPSR(void)
+{
+    return excepcion;
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    (void)IRQn;
+    (void)priority;
+
+    return;
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    if (IRQn >= 0)
+    {
+        interrupciones_habilitadas |= (1ULL << IRQn);
+    }
+
+    return;
+}
+
+void Chip_SCU_PinMuxSet(uint8_t port, uint8_t pin, uint16_t modefunc)
+{
+    (void)port;
+    (void)pin;
+    (void)modefunc;
+
+    return;
+}
+
+void Chip_SCU_GPIOIntPinSel(uint8_t PortSel, uint8_t PortNum, uint8_t PinNum)
+{
+    terminal_puerto[PortSel] = PortNum;
+    terminal_bit[PortSel] = PinNum;
+    terminales_asignados |= PININTCH(PortSel);
+
+    // El nivel al asignar el terminal no es un flanco
+    if (Chip_GPIO_ReadPortBit(&SimulatedGpio, PortNum, PinNum))
+    {
+        terminales_niveles |= PININTCH(PortSel);
+    }
+    else
+    {
+        terminales_niveles &= ~PININTCH(PortSel);
+    }
+
+    return;
+}
+
+void Chip_GPIO_SetPinDIR(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool output)
+{
+    if (output)
+    {
+        pGPIO->DIR[port] |= (1 << pin);
+    }
+    else
+    {
+        pGPIO->DIR[port] &= ~(1 << pin);
+    }
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetPortDIRInput(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pinMask)
+{
+    pGPIO->DIR[port] &= ~pinMask;
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetPinState(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool setting)
+{
+    if (setting)
+    {
+        pGPIO->SET[port] |= (1 << pin);
+    }
+    else
+    {
+        pGPIO->SET[port] &= ~(1 << pin);
+    }
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetPinToggle(LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin)
+{
+    pGPIO->SET[port] ^= (1 << pin);
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue)
+{
+    pGPIO->SET[port] |= bitValue;
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_ClearValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue)
+{
+    pGPIO->SET[port] &= ~bitValue;
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetPortToggle(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pins)
+{
+    pGPIO->SET[port] ^= pins;
+    ActualizarSalidas(port);
+
+    return;
+}
+
+void Chip_GPIO_SetPortMask(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t mask)
+{
+    pGPIO->MASK[port] = mask;
+
+    return;
+}
+
+void Chip_GPIO_SetMaskedPortValue(LPC_GPIO_T * pGPIO, uint8_t port, uint32_t value)
+{
+    // Como el registro MPIN, solo cambian los terminales con el bit en cero en MASK
+    pGPIO->SET[port] = (pGPIO->SET[port] & pGPIO->MASK[port]) | (value & ~pGPIO->MASK[port]);
+    ActualizarSalidas(port);
+
+    return;
+}
+
+bool Chip_GPIO_ReadPortBit(LPC_GPIO_T * pGPIO, uint32_t port, uint8_t pin)
+{
+    return (Chip_GPIO_GetPortValue(pGPIO, port) >> pin) & 1;
+}
+
+uint32_t Chip_GPIO_GetPortValue(LPC_GPIO_T * pGPIO, uint8_t port)
+{
+    uint32_t entradas = __atomic_load_n(&pGPIO->PIN[port], __ATOMIC_ACQUIRE);
+
+    // Los terminales configurados como salida leen el nivel que se les escribió
+    return (entradas & ~pGPIO->DIR[port]) | (pGPIO->SET[port] & pGPIO->DIR[port]);
+}
+
+void SimulatorSetInput(uint8_t port, uint8_t pin, bool level)
+{
+    if (level)
+    {
+        __atomic_fetch_or(&SimulatedGpio.PIN[port], 1 << pin, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_fetch_and(&SimulatedGpio.PIN[port], ~(1 << pin), __ATOMIC_RELEASE);
+    }
+
+    return;
+}
+
+void Chip_PININT_Init(LPC_PIN_INT_T * pPININT)
+{
+    (void)pPININT;
+
+    return;
+}
+
+void Chip_PININT_SetPinModeEdge(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->ISEL &= ~pins;
+
+    return;
+}
+
+void Chip_PININT_EnableIntHigh(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->IENR |= pins;
+
+    return;
+}
+
+void Chip_PININT_DisableIntHigh(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->IENR &= ~pins;
+
+    return;
+}
+
+void Chip_PININT_EnableIntLow(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->IENF |= pins;
+
+    return;
+}
+
+void Chip_PININT_DisableIntLow(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->IENF &= ~pins;
+
+    return;
+}
+
+void Chip_PININT_ClearIntStatus(LPC_PIN_INT_T * pPININT, uint32_t pins)
+{
+    pPININT->IST &= ~pins;
+
+    return;
+}
+
+void Chip_RIT_Init(LPC_RITIMER_T * pRITimer)
+{
+    pRITimer->CTRL = 0;
+    pRITimer->COUNTER = 0;
+
+    return;
+}
+
+void Chip_RIT_SetTimerInterval(LPC_RITIMER_T * pRITimer, uint32_t time_interval)
+{
+    pRITimer->COMPVAL = time_interval;
+
+    return;
+}
+
+void Chip_RIT_ClearInt(LPC_RITIMER_T * pRITimer)
+{
+    (void)pRITimer;
+
+    return;
+}
+
+uint32_t Chip_RIT_GetCounter(LPC_RITIMER_T * pRITimer)
+{
+    return pRITimer->COUNTER;
+}
+
+uint32_t Chip_Clock_GetRate(CHIP_CCU_CLK_T clk)
+{
+    (void)clk;
+
+    return 1000; // El temporizador repetitivo cuenta milisegundos
+}
+
+void Chip_UART_Init(LPC_USART_T * pUART)
+{
+    pUART->TER = 0;
+
+    return;
+}
+
+uint32_t Chip_UART_SetBaud(LPC_USART_T * pUART, uint32_t baudrate)
+{
+    pUART->BAUD = baudrate; // La pseudo terminal transmite a la velocidad que permita la computadora
+
+    return baudrate;
+}
+
+void Chip_UART_ConfigData(LPC_USART_T * pUART, uint32_t config)
+{
+    pUART->LCR = config;
+
+    return;
+}
+
+void Chip_UART_SetupFIFOS(LPC_USART_T * pUART, uint32_t fcr)
+{
+    pUART->FCR = fcr;
+
+    return;
+}
+
+void Chip_UART_TXEnable(LPC_USART_T * pUART)
+{
+    pUART->TER = 1;
+
+    return;
+}
+
+void Chip_UART_IntEnable(LPC_USART_T * pUART, uint32_t intMask)
+{
+    pUART->IER |= intMask;
+
+    return;
+}
+
+uint32_t Chip_UART_ReadIntIDReg(LPC_USART_T * pUART)
+{
+    (void)pUART;
+
+    return 0;
+}
+
+uint32_t Chip_UART_ReadLineStatus(LPC_USART_T * pUART)
+{
+    (void)pUART;
+
+    return 0; // Los bytes ya están en el buffer del DMA cuando se pide la interrupción, la FIFO queda vacía
+}
+
+void Chip_EEPROM_Init(LPC_EEPROM_T * pEEPROM)
+{
+    const char * archivo = getenv("RELOJ_EEPROM");
+
+    pEEPROM->INTSTAT = 0;
+    if (archivo && (eeprom < 0))
+    {
+        eeprom = open(archivo, O_RDWR | O_CREAT, 0644);
+        if (eeprom < 0)
+        {
+            perror(archivo);
+        }
+        else if (pread(eeprom, SimulatedEepromMemory, sizeof(SimulatedEepromMemory), 0) < 0)
+        {
+            perror(archivo);
+        }
+    }
+
+    return;
+}
+
+void Chip_EEPROM_SetAutoProg(LPC_EEPROM_T * pEEPROM, uint32_t mode)
+{
+    pEEPROM->AUTOPROG = mode;
+
+    return;
+}
+
+uint32_t Chip_EEPROM_GetIntStatus(LPC_EEPROM_T * pEEPROM)
+{
+    return pEEPROM->INTSTAT;
+}
+
+void Chip_EEPROM_ClearIntStatus(LPC_EEPROM_T * pEEPROM, uint32_t mask)
+{
+    pEEPROM->INTSTAT &= ~mask;
+
+    return;
+}
+
+void Chip_EEPROM_SetCmd(LPC_EEPROM_T * pEEPROM, uint32_t cmd)
+{
+    pEEPROM->CMD = cmd;
+    if (cmd == EEPROM_CMD_ERASE_PRG_PAGE)
+    {
+        // Las escrituras ya quedaron en la memoria, se guarda entera porque el comando no indica la página
+        if ((eeprom >= 0) && (pwrite(eeprom, SimulatedEepromMemory, sizeof(SimulatedEepromMemory), 0) < 0))
+        {
+            perror("RELOJ_EEPROM");
+        }
+        pEEPROM->INTSTAT |= EEPROM_INT_ENDOFPROG;
+    }
+
+    return;
+}
+
+LPC_RTC_T * SimulatorRtc(void)
+{
+    uint64_t ahora = Milisegundos();
+    uint32_t segundos;
+
+    if (!(rtc.CCR & RTC_CCR_CLKEN)) // Detenido, el divisor no avanza
+    {
+        rtc_segundo = ahora;
+    }
+    else if ((ahora - rtc_segundo) >= 1000)
+    {
+        segundos = (rtc.TIME[RTC_TIMETYPE_HOUR] * 60 + rtc.TIME[RTC_TIMETYPE_MINUTE]) * 60 +
+                   rtc.TIME[RTC_TIMETYPE_SECOND] + (ahora - rtc_segundo) / 1000;
+        rtc_segundo += ((ahora - rtc_segundo) / 1000) * 1000;
+        segundos %= SEGUNDOS_DIA;
+        rtc.TIME[RTC_TIMETYPE_SECOND] = segundos % 60;
+        rtc.TIME[RTC_TIMETYPE_MINUTE] = (segundos / 60) % 60;
+        rtc.TIME[RTC_TIMETYPE_HOUR] = segundos / 3600;
+    }
+
+    rtc.CTIME[0] = rtc.TIME[RTC_TIMETYPE_SECOND] | (rtc.TIME[RTC_TIMETYPE_MINUTE] << 8) |
+                   (rtc.TIME[RTC_TIMETYPE_HOUR] << 16);
+
+    return &rtc;
+}
+
+void Chip_RTC_Init(LPC_RTC_T * pRTC)
+{
+    pRTC->CCR = 0;
+    pRTC->ILR = 0;
+    pRTC->CIIR = 0;
+    pRTC->AMR = 0xFF;
+    rtc_segundo = Milisegundos();
+
+    return;
+}
+
+void Chip_RTC_Enable(LPC_RTC_T * pRTC, FunctionalState NewState)
+{
+    if (NewState == ENABLE)
+    {
+        pRTC->CCR |= RTC_CCR_CLKEN;
+    }
+    else
+    {
+        pRTC->CCR &= ~RTC_CCR_CLKEN;
+    }
+
+    return;
+}
+
+void Chip_RTC_SetTime(LPC_RTC_T * pRTC, RTC_TIMEINDEX_T Timetype, uint32_t TimeValue)
+{
+    pRTC->TIME[Timetype] = TimeValue;
+
+    return;
+}
+
+uint32_t Chip_REGFILE_Read(LPC_REGFILE_T * pRegFile, int index)
+{
+    return pRegFile->REGFILE[index];
+}
+
+void Chip_REGFILE_Write(LPC_REGFILE_T * pRegFile, int index, uint32_t value)
+{
+    pRegFile->REGFILE[index] = value;
+
+    return;
+}
+
+void Chip_GPDMA_Init(LPC_GPDMA_T * pGPDMA)
+{
+    pGPDMA->INTTCSTAT = 0;
+
+    return;
+}
+
+uint8_t Chip_GPDMA_GetFreeChannel(LPC_GPDMA_T * pGPDMA, uint32_t PeripheralConnection_ID)
+{
+    (void)PeripheralConnection_ID;
+
+    for (uint8_t canal = 0; canal < GPDMA_CHANNELS; canal++)
+    {
+        if (!canal_asignado[canal] && !(pGPDMA->CH[canal].CONFIG & CANAL_HABILITADO))
+        {
+            canal_asignado[canal] = true;
+            return canal;
+        }
+    }
+
+    return 0;
+}
+
+Status Chip_GPDMA_Transfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, uintptr_t src, uintptr_t dst,
+                           GPDMA_FLOW_CONTROL_T TransferType, uint32_t Size)
+{
+    GPDMA_CH_T * registros = &pGPDMA->CH[ChannelNum];
+    const uint8_t * datos = (const uint8_t *)src;
+    int puerto = SimulatorSerial();
+
+    if ((TransferType != GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA) || (dst != GPDMA_CONN_UART2_Tx))
+    {
+        return ERROR;
+    }
+
+    registros->SRCADDR = src;
+    registros->DESTADDR = dst;
+    registros->LLI = 0;
+    registros->CONTROL = Size;
+    registros->CONFIG = CANAL_HABILITADO | (TransferType << CANAL_TIPO_POS);
+
+    while ((registros->CONTROL > 0) && (puerto >= 0))
+    {
+        ssize_t escritos = write(puerto, datos, registros->CONTROL);
+
+        if (escritos > 0)
+        {
+            datos += escritos;
+            registros->CONTROL -= escritos;
+        }
+        else if ((escritos == 0) || (errno != EINTR))
+        {
+            break; // Si nadie lee la pseudo terminal se llena y lo que sobra se pierde, como con la UART
+        }
+    }
+    registros->CONTROL = 0;
+    TerminarBloque(pGPDMA, ChannelNum);
+
+    return SUCCESS;
+}
+
+Status Chip_GPDMA_InitDescriptor(LPC_GPDMA_T * pGPDMA, DMA_TransferDescriptor_t * DMADescriptor, uintptr_t src,
+                                 uintptr_t dst, uint32_t Size, GPDMA_FLOW_CONTROL_T TransferType,
+                                 const DMA_TransferDescriptor_t * NextDescriptor)
+{
+    (void)pGPDMA;
+
+    if ((TransferType != GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA) || (src != GPDMA_CONN_UART2_Rx))
+    {
+        return ERROR;
+    }
+
+    DMADescriptor->src = src;
+    DMADescriptor->dst = dst;
+    DMADescriptor->lli = (uintptr_t)NextDescriptor;
+    DMADescriptor->ctrl = Size;
+
+    return SUCCESS;
+}
+
+Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, const DMA_TransferDescriptor_t * DMADescriptor,
+                             GPDMA_FLOW_CONTROL_T TransferType)
+{
+    GPDMA_CH_T * registros = &pGPDMA->CH[ChannelNum];
+
+    registros->SRCADDR = DMADescriptor->src;
+    registros->DESTADDR = DMADescriptor->dst;
+    registros->LLI = DMADescriptor->lli;
+    registros->CONTROL = DMADescriptor->ctrl;
+    registros->CONFIG = CANAL_HABILITADO | (TransferType << CANAL_TIPO_POS);
+
+    return SUCCESS;
+}
+
+Status Chip_GPDMA_Interrupt(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum)
+{
+    if (pGPDMA->INTTCSTAT & (1 << ChannelNum))
+    {
+        pGPDMA->INTTCSTAT &= ~(1 << ChannelNum);
+        return SUCCESS;
+    }
+
+    return ERROR;
+}
+
+void SimulatorHardwareTick(void)
+{
+    LPC_RITIMER_T * rit = &SimulatedRitimer;
+    bool recibido = false;
+
+    // Lo que llegó desde el tick anterior pide una sola interrupción, con los bytes ya copiados por el DMA
+    for (uint8_t canal = 0; canal < GPDMA_CHANNELS; canal++)
+    {
+        if ((SimulatedGpdma.CH[canal].CONFIG & CANAL_HABILITADO) &&
+            (SimulatedGpdma.CH[canal].SRCADDR == GPDMA_CONN_UART2_Rx))
+        {
+            recibido = Recibir(&SimulatedGpdma, canal) || recibido;
+        }
+    }
+    if (recibido && (SimulatedUsart2.IER & UART_IER_RBRINT))
+    {
+        Interrumpir(USART2_IRQn, UART2_IRQHandler);
+    }
+
+    // Los flancos ocurrieron durante el milisegundo anterior, antes de que venza el temporizador repetitivo
+    InterrumpirTerminales();
+
+    // Como Chip_RIT_SetTimerInterval, COMPVAL está en milisegundos; un período más corto que la cuenta vuelve a cero
+    if ((interrupciones_habilitadas & (1ULL << RITIMER_IRQn)) && rit->COMPVAL && (++rit->COUNTER >= rit->COMPVAL))
+    {
+        rit->COUNTER = 0;
+        Interrumpir(RITIMER_IRQn, RIT_IRQHandler);
+    }
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
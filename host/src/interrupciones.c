@@ -0,0 +1,92 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Controlador de interrupciones del modelo de la placa con el puerto POSIX de FreeRTOS
+ **
+ ** El puerto POSIX genera el tick con una señal y su portYIELD_FROM_ISR cambia de hilo, lo que no se puede hacer desde
+ ** el manejador de la señal. Las interrupciones de los periféricos simulados se atienden entonces desde una tarea con
+ ** la mayor prioridad, que despierta en cada tick y llama a SimulatorHardwareTick: mientras corre ninguna otra tarea
+ ** avanza, como mientras el procesador atiende una interrupción.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "simulador.h"
+#include <stdbool.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Tarea que atiende las interrupciones de los periféricos simulados una vez por tick.
+ */
+static void Interrupciones(void * parameters);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StackType_t pila[configMINIMAL_STACK_SIZE];
+static StaticTask_t control;
+#endif
+
+/* === Private function implementation ========================================================= */
+
+static void Interrupciones(void * parameters)
+{
+    TickType_t ultimo = xTaskGetTickCount();
+
+    (void)parameters;
+
+    while (true)
+    {
+        vTaskDelayUntil(&ultimo, 1);
+        SimulatorHardwareTick();
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+void SimulatorStartInterrupts(void)
+{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    xTaskCreateStatic(Interrupciones, "Interrupciones", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, pila,
+                      &control);
+#else
+    xTaskCreate(Interrupciones, "Interrupciones", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL);
+#endif
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
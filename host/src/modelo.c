@@ -0,0 +1,285 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Modelo del poncho
+ **
+ ** Las salidas llegan desde las tareas del firmware, que se ejecutan de a una, por lo que el modelo no necesita
+ ** exclusión. Quien lo consulte desde otro hilo debe publicar los resultados por su cuenta.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "modelo.h"
+#include "chip.h"
+#include "pantalla.h"
+#include "poncho.h"
+#include "simulador.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+// Columna del teclado matricial de las teclas F1 a F4, la del primer dígito como las espera main.c
+#if (KEY_MATRIX == 1)
+#define COLUMNA_AJUSTE 0
+#else
+#define COLUMNA_AJUSTE MODEL_KEY_DIRECT
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+//! Carácter que forma un conjunto de segmentos, sin el punto.
+typedef struct
+{
+    uint8_t segmentos;
+    char caracter;
+} caracter_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Arma la pantalla con las salidas de los dígitos y los segmentos.
+ *
+ * @return true Empezó un barrido nuevo, por lo que terminó el anterior.
+ */
+static bool ActualizarPantalla(void);
+
+#if (KEY_MATRIX == 1)
+/**
+ * @brief Fija el nivel de las filas del teclado matricial con las teclas presionadas en las columnas encendidas.
+ */
+static void ActualizarFilas(void);
+#endif
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const model_key_t TECLAS[] = {
+    {"f1", KEY_F1_GPIO, KEY_F1_BIT, COLUMNA_AJUSTE},
+    {"f2", KEY_F2_GPIO, KEY_F2_BIT, COLUMNA_AJUSTE},
+    {"f3", KEY_F3_GPIO, KEY_F3_BIT, COLUMNA_AJUSTE},
+    {"f4", KEY_F4_GPIO, KEY_F4_BIT, COLUMNA_AJUSTE},
+    {"aceptar", KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT, MODEL_KEY_DIRECT},
+    {"cancelar", KEY_CANCEL_GPIO, KEY_CANCEL_BIT, MODEL_KEY_DIRECT},
+};
+
+static const caracter_t CARACTERES[] = {
+    {0, ' '},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_C | SEGMENTO_D | SEGMENTO_E | SEGMENTO_F, '0'},
+    {SEGMENTO_B | SEGMENTO_C, '1'},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_D | SEGMENTO_E | SEGMENTO_G, '2'},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_C | SEGMENTO_D | SEGMENTO_G, '3'},
+    {SEGMENTO_B | SEGMENTO_C | SEGMENTO_F | SEGMENTO_G, '4'},
+    {SEGMENTO_A | SEGMENTO_C | SEGMENTO_D | SEGMENTO_F | SEGMENTO_G, '5'},
+    {SEGMENTO_A | SEGMENTO_C | SEGMENTO_D | SEGMENTO_E | SEGMENTO_F | SEGMENTO_G, '6'},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_C, '7'},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_C | SEGMENTO_D | SEGMENTO_E | SEGMENTO_F | SEGMENTO_G, '8'},
+    {SEGMENTO_A | SEGMENTO_B | SEGMENTO_C | SEGMENTO_F | SEGMENTO_G, '9'},
+    {SEGMENTO_G, '-'},
+};
+
+static uint32_t salidas[GPIO_PORTS] = {0};
+static uint8_t barrido[DIGITOS] = {0};
+static uint64_t barrido_anterior = 0;
+static uint64_t cuadro = 0;
+static uint8_t ultimo_digito = DIGITOS - 1;
+static bool digito_encendido = false;
+
+// Teclas presionadas del teclado matricial con un bit por tecla como en DisplayGetKeys, las cambia el hilo que ejecuta
+// los comandos
+static uint32_t matriz = 0;
+
+/* === Private function implementation ========================================================= */
+
+static bool ActualizarPantalla(void)
+{
+    uint32_t digitos = salidas[DIGITS_GPIO] & DIGITS_MASK;
+    uint8_t segmentos = salidas[SEGMENTS_GPIO] & SEGMENTS_MASK; // Los bits del puerto coinciden con SEGMENTO_A a G
+    uint8_t digito;
+    bool completo = false;
+
+    if (salidas[SEGMENT_P_GPIO] & (1 << SEGMENT_P_BIT))
+    {
+        segmentos |= SEGMENTO_P;
+    }
+
+    if ((digitos == 0) || (digitos & (digitos - 1))) // Ninguno o más de un dígito encendido
+    {
+        digito_encendido = false;
+        return false;
+    }
+
+    // DigitTurnOn enciende los dígitos de izquierda a derecha desde el bit más alto
+    digito = (DIGITOS - 1) - __builtin_ctz(digitos);
+    if (!digito_encendido && (digito <= ultimo_digito)) // Empieza un barrido nuevo
+    {
+        uint64_t actual = 0;
+
+        for (int indice = 0; indice < DIGITOS; indice++)
+        {
+            actual |= (uint64_t)barrido[indice] << (8 * indice);
+        }
+        if (actual == barrido_anterior)
+        {
+            cuadro = actual;
+        }
+        barrido_anterior = actual;
+        memset(barrido, 0, sizeof(barrido));
+        completo = true;
+    }
+
+    barrido[digito] = segmentos;
+    ultimo_digito = digito;
+    digito_encendido = true;
+
+    return completo;
+}
+
+#if (KEY_MATRIX == 1)
+static void ActualizarFilas(void)
+{
+    uint32_t presionadas = __atomic_load_n(&matriz, __ATOMIC_ACQUIRE);
+    uint32_t digitos = salidas[DIGITS_GPIO] & DIGITS_MASK;
+
+    for (int fila = 0; fila < DISPLAY_KEY_ROWS; fila++)
+    {
+        bool nivel = false;
+
+        // Como en ActualizarPantalla, DigitTurnOn enciende la columna de cada dígito desde el bit más alto
+        for (int columna = 0; columna < DIGITOS; columna++)
+        {
+            if ((digitos & (1 << ((DIGITOS - 1) - columna))) &&
+                (presionadas & (1 << (columna * DISPLAY_KEY_ROWS + fila))))
+            {
+                nivel = true;
+            }
+        }
+        SimulatorSetInput(KEY_ROWS_GPIO, KEY_ROWS_SHIFT + fila, nivel);
+    }
+
+    return;
+}
+#endif
+
+/* === Public function implementation ========================================================== */
+
+bool ModelOutputsChanged(uint8_t port, uint32_t outputs)
+{
+    salidas[port] = outputs;
+
+#if (KEY_MATRIX == 1)
+    if (port == DIGITS_GPIO) // Las filas siguen a la columna encendida antes de que la tarea vuelva a leerlas
+    {
+        ActualizarFilas();
+    }
+#endif
+
+    if ((port == DIGITS_GPIO) || (port == SEGMENTS_GPIO) || (port == SEGMENT_P_GPIO))
+    {
+        return ActualizarPantalla();
+    }
+
+    return false;
+}
+
+uint64_t ModelFrame(void)
+{
+    return cuadro;
+}
+
+bool ModelBuzzer(void)
+{
+    return (salidas[BUZZER_GPIO] >> BUZZER_BIT) & 1;
+}
+
+void ModelFrameText(uint64_t frame, char * text)
+{
+    for (int digito = 0; digito < DIGITOS; digito++)
+    {
+        uint8_t segmentos = (frame >> (8 * digito)) & 0xFF;
+
+        *text = '?';
+        for (size_t indice = 0; indice < sizeof(CARACTERES) / sizeof(CARACTERES[0]); indice++)
+        {
+            if (CARACTERES[indice].segmentos == (segmentos & ~SEGMENTO_P))
+            {
+                *text = CARACTERES[indice].caracter;
+            }
+        }
+        text++;
+        if (segmentos & SEGMENTO_P)
+        {
+            *text++ = '.';
+        }
+    }
+    *text = '\0';
+
+    return;
+}
+
+void ModelSetKey(const model_key_t * key, bool pressed)
+{
+    if (key->column != MODEL_KEY_DIRECT) // La fila se lee en el próximo barrido de la columna de la tecla
+    {
+        uint32_t bit = 1 << (key->column * DISPLAY_KEY_ROWS + (key->bit - KEY_ROWS_SHIFT));
+
+        if (pressed)
+        {
+            __atomic_fetch_or(&matriz, bit, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            __atomic_fetch_and(&matriz, ~bit, __ATOMIC_RELEASE);
+        }
+#if (KEY_MATRIX == 1)
+        // Con las columnas quietas, como con el barrido detenido, la fila cambia sin esperar a que se encienda otra
+        ActualizarFilas();
+#endif
+    }
+    else
+    {
+        // Las teclas se configuran sin invertir, por lo que una tecla presionada lee un nivel alto
+        SimulatorSetInput(key->gpio, key->bit, pressed);
+    }
+
+    return;
+}
+
+const model_key_t * ModelFindKey(const char * name)
+{
+    for (size_t indice = 0; name && (indice < sizeof(TECLAS) / sizeof(TECLAS[0])); indice++)
+    {
+        if (!strcmp(TECLAS[indice].name, name))
+        {
+            return &TECLAS[indice];
+        }
+    }
+
+    return NULL;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
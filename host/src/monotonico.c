@@ -0,0 +1,108 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Fuente de la hora con el reloj monótono de la computadora
+ **
+ ** Guarda los segundos fijados y el momento de la escritura; una lectura suma los segundos enteros transcurridos.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+// reloj.h llama clock_t a la referencia del reloj, que choca con el tipo de la biblioteca estándar
+#define clock_t reloj_t
+#include "monotonico.h"
+#undef clock_t
+
+#include <stddef.h>
+#include <time.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Segundos de un día.
+#define SEGUNDOS_DIA 86400
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static bool Leer(uint32_t * seconds);
+static void Escribir(uint32_t seconds);
+static uint64_t Milisegundos(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static uint32_t fijados = 0;
+static uint64_t origen = 0; // Momento de la escritura en milisegundos
+static bool fijada = false;
+
+/* === Private function implementation ========================================================= */
+
+static bool Leer(uint32_t * seconds)
+{
+    *seconds = (fijados + (Milisegundos() - origen) / 1000) % SEGUNDOS_DIA;
+
+    return fijada;
+}
+
+static void Escribir(uint32_t seconds)
+{
+    fijados = seconds;
+    origen = Milisegundos();
+    fijada = true;
+
+    return;
+}
+
+static uint64_t Milisegundos(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+
+    return (uint64_t)ahora.tv_sec * 1000 + ahora.tv_nsec / 1000000;
+}
+
+/* === Public function implementation ========================================================== */
+
+clock_source_t MonotonicClockCreate(void)
+{
+    static const struct clock_source_s fuente = {
+        .Read = Leer,
+        .Write = Escribir,
+    };
+
+    if (!fijada)
+    {
+        origen = Milisegundos();
+    }
+
+    return &fuente;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
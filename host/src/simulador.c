@@ -0,0 +1,399 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Poncho simulado
+ **
+ ** Las salidas de los puertos se reciben desde las tareas del firmware y las interpreta el modelo del poncho. Lo que
+ ** se informa al hilo del simulador se publica con operaciones atómicas: el cuadro que muestra la pantalla, la
+ ** cantidad de barridos y el estado del zumbador. Solo el hilo del simulador escribe en la salida estándar, de modo
+ ** que las tareas nunca esperan un bloqueo que tenga una tarea suspendida.
+ **
+ ** \addtogroup simulador SIMULADOR
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include "simulador.h"
+#include "modelo.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Período de revisión de las salidas y de la entrada estándar en milisegundos.
+#define PERIODO_SIMULADOR 5
+
+//! Tiempo sin barridos completos después del cual la pantalla se considera apagada, en milisegundos.
+#define PANTALLA_APAGADA 100
+
+//! Duración de una pulsación si el comando no la indica, en milisegundos.
+#define PULSACION 200
+
+//! Largo máximo de un comando.
+#define LARGO_COMANDO 128
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Abre la pseudo terminal de la UART y arranca el hilo del simulador antes que main.
+ */
+static void Iniciar(void) __attribute__((constructor));
+
+/**
+ * @brief Hilo del simulador: ejecuta los comandos de la entrada estándar e informa los cambios de las salidas.
+ */
+static void * Atender(void * argumento);
+
+/**
+ * @brief Informa los cambios de la pantalla y del zumbador desde la revisión anterior.
+ */
+static void RevisarSalidas(uint64_t ahora);
+
+/**
+ * @brief Escribe una línea en la salida estándar.
+ */
+static void Informar(const char * formato, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Escribe el contenido de la pantalla.
+ */
+static void MostrarPantalla(uint64_t actual);
+
+/**
+ * @brief Espera datos de la entrada estándar como mucho un período del simulador y los agrega a los pendientes.
+ */
+static void LeerEntrada(void);
+
+/**
+ * @brief Quita de los datos pendientes la próxima línea completa.
+ *
+ * @return true Hay una línea en el parámetro.
+ * @return false Todavía no llegó una línea completa.
+ */
+static bool TomarLinea(char * linea);
+
+/**
+ * @brief Ejecuta un comando, los que demoran a los siguientes fijan el momento en que termina la espera.
+ */
+static void Ejecutar(char * linea, uint64_t ahora);
+
+static uint64_t Milisegundos(void);
+static void Terminar(int codigo);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static int serial = -1;
+
+// Publicado por las tareas para el hilo del simulador
+static uint64_t cuadro = 0;
+static uint32_t cuadros = 0;
+static bool zumbador = false;
+
+// Estado del hilo del simulador
+static char entrada[LARGO_COMANDO];
+static size_t pendientes = 0;
+static bool fin_entrada = false;
+static uint64_t espera = 0;
+static const model_key_t * soltar = NULL;
+
+/* === Private function implementation ========================================================= */
+
+static void Iniciar(void)
+{
+    struct termios modo;
+    sigset_t todas, anteriores;
+    pthread_t hilo;
+
+    serial = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((serial < 0) || grantpt(serial) || unlockpt(serial))
+    {
+        perror("posix_openpt");
+        serial = -1;
+    }
+    else
+    {
+        // El extremo esclavo queda abierto y en modo crudo para que la terminal no altere los bytes ni haga eco
+        int esclavo = open(ptsname(serial), O_RDWR | O_NOCTTY);
+
+        tcgetattr(esclavo, &modo);
+        cfmakeraw(&modo);
+        tcsetattr(esclavo, TCSANOW, &modo);
+        fcntl(serial, F_SETFL, O_NONBLOCK);
+        Informar("uart %s", ptsname(serial));
+    }
+
+    // El hilo bloquea todas las señales para que las que usa el puerto POSIX de FreeRTOS lleguen solo a las tareas
+    sigfillset(&todas);
+    pthread_sigmask(SIG_SETMASK, &todas, &anteriores);
+    if (pthread_create(&hilo, NULL, Atender, NULL))
+    {
+        perror("pthread_create");
+        exit(1);
+    }
+    pthread_sigmask(SIG_SETMASK, &anteriores, NULL);
+
+    return;
+}
+
+static void * Atender(void * argumento)
+{
+    char linea[LARGO_COMANDO + 1];
+
+    (void)argumento;
+
+    while (true)
+    {
+        uint64_t ahora = Milisegundos();
+
+        RevisarSalidas(ahora);
+        if (ahora >= espera)
+        {
+            if (soltar) // Termina la pulsación en curso
+            {
+                ModelSetKey(soltar, false);
+                soltar = NULL;
+            }
+
+            if (TomarLinea(linea))
+            {
+                Ejecutar(linea, ahora);
+                continue;
+            }
+
+            if (fin_entrada)
+            {
+                Terminar(0);
+            }
+        }
+
+        LeerEntrada();
+    }
+
+    return NULL;
+}
+
+static void RevisarSalidas(uint64_t ahora)
+{
+    static uint64_t mostrado = 0;
+    static uint32_t cuadros_anteriores = 0;
+    static uint64_t ultimo_barrido = 0;
+    static bool sonando = false;
+
+    uint64_t actual = __atomic_load_n(&cuadro, __ATOMIC_ACQUIRE);
+    uint32_t contados = __atomic_load_n(&cuadros, __ATOMIC_ACQUIRE);
+    bool zumbando = __atomic_load_n(&zumbador, __ATOMIC_ACQUIRE);
+
+    if (contados != cuadros_anteriores)
+    {
+        cuadros_anteriores = contados;
+        ultimo_barrido = ahora;
+    }
+    else if ((ahora - ultimo_barrido) > PANTALLA_APAGADA) // Sin barridos, por ejemplo con la pantalla apagada
+    {
+        actual = 0;
+    }
+
+    if (actual != mostrado)
+    {
+        mostrado = actual;
+        MostrarPantalla(actual);
+    }
+
+    if (zumbando != sonando)
+    {
+        sonando = zumbando;
+        Informar("zumbador %s", sonando ? "si" : "no");
+    }
+
+    return;
+}
+
+static void Informar(const char * formato, ...)
+{
+    va_list argumentos;
+
+    va_start(argumentos, formato);
+    vprintf(formato, argumentos);
+    va_end(argumentos);
+    putchar('\n');
+    fflush(stdout);
+
+    return;
+}
+
+static void MostrarPantalla(uint64_t actual)
+{
+    char texto[MODEL_TEXT_SIZE];
+
+    ModelFrameText(actual, texto);
+    Informar("pantalla [%s]", texto);
+
+    return;
+}
+
+static void LeerEntrada(void)
+{
+    struct pollfd consulta = {.fd = STDIN_FILENO, .events = POLLIN};
+
+    if (fin_entrada || (pendientes == sizeof(entrada)))
+    {
+        usleep(PERIODO_SIMULADOR * 1000);
+    }
+    else if (poll(&consulta, 1, PERIODO_SIMULADOR) > 0)
+    {
+        ssize_t leidos = read(STDIN_FILENO, entrada + pendientes, sizeof(entrada) - pendientes);
+
+        if (leidos > 0)
+        {
+            pendientes += leidos;
+        }
+        else
+        {
+            fin_entrada = true;
+        }
+    }
+
+    return;
+}
+
+static bool TomarLinea(char * linea)
+{
+    char * fin = memchr(entrada, '\n', pendientes);
+    size_t largo = fin ? (size_t)(fin - entrada) : pendientes;
+
+    // Una línea demasiado larga, o la última sin fin de línea, se toman como están
+    if (!fin && (pendientes < sizeof(entrada)) && !(fin_entrada && pendientes))
+    {
+        return false;
+    }
+
+    memcpy(linea, entrada, largo);
+    linea[largo] = '\0';
+    linea[strcspn(linea, "\r#")] = '\0';
+    largo += fin ? 1 : 0;
+    pendientes -= largo;
+    memmove(entrada, entrada + largo, pendientes);
+
+    return true;
+}
+
+static void Ejecutar(char * linea, uint64_t ahora)
+{
+    char * comando = strtok(linea, " \t");
+    char * argumento = strtok(NULL, " \t");
+    char * duracion = strtok(NULL, " \t");
+    const model_key_t * tecla = ModelFindKey(argumento);
+
+    if (!comando) // Línea vacía o comentario
+    {
+        return;
+    }
+
+    if (!strcmp(comando, "presionar") && tecla)
+    {
+        ModelSetKey(tecla, true);
+    }
+    else if (!strcmp(comando, "soltar") && tecla)
+    {
+        ModelSetKey(tecla, false);
+    }
+    else if (!strcmp(comando, "pulsar") && tecla)
+    {
+        ModelSetKey(tecla, true);
+        soltar = tecla;
+        espera = ahora + (duracion ? strtoul(duracion, NULL, 10) : PULSACION);
+    }
+    else if (!strcmp(comando, "esperar") && argumento)
+    {
+        espera = ahora + strtoul(argumento, NULL, 10);
+    }
+    else if (!strcmp(comando, "pantalla"))
+    {
+        MostrarPantalla(__atomic_load_n(&cuadro, __ATOMIC_ACQUIRE));
+    }
+    else if (!strcmp(comando, "salir"))
+    {
+        Terminar(0);
+    }
+    else
+    {
+        fprintf(stderr, "error: comando desconocido %s%s%s\n", comando, argumento ? " " : "", argumento ? argumento : "");
+    }
+
+    return;
+}
+
+static uint64_t Milisegundos(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+
+    return (uint64_t)ahora.tv_sec * 1000 + ahora.tv_nsec / 1000000;
+}
+
+static void Terminar(int codigo)
+{
+    // Sin pasar por exit, que ejecutaría los destructores mientras las tareas siguen corriendo
+    fflush(stdout);
+    _exit(codigo);
+}
+
+/* === Public function implementation ========================================================== */
+
+void SimulatorOutputsChanged(uint8_t port, uint32_t outputs)
+{
+    if (ModelOutputsChanged(port, outputs))
+    {
+        __atomic_store_n(&cuadro, ModelFrame(), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&cuadros, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&zumbador, ModelBuzzer(), __ATOMIC_RELEASE);
+
+    return;
+}
+
+int SimulatorSerial(void)
+{
+    return serial;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
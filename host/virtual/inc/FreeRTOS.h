@@ -0,0 +1,108 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+/** \brief Núcleo en tiempo virtual
+ **
+ ** Reemplaza a FreeRTOS en la simulación en tiempo virtual con la misma interfaz que usa el firmware, de modo que
+ ** main.c y los módulos compilan sin cambios. Las tareas se ejecutan de a una, cada una con su propio contexto, y el
+ ** tick avanza recién cuando todas están bloqueadas: el código de las tareas no consume tiempo virtual, como en un
+ ** procesador infinitamente rápido, y el resultado depende solo del guion y no de la carga de la computadora.
+ **
+ ** Solo implementa lo que usa el firmware. Los envíos a una cola llena no esperan aunque se indique un tiempo, y
+ ** los temporizadores por software se ejecutan en el tick, antes que las tareas, como lo haría la tarea de
+ ** temporizadores con su prioridad alta.
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** \brief Simulación del firmware en tiempo virtual
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOSConfig.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#if (RUN_TIME_STATS == 1)
+#error "RUN_TIME_STATS no se puede simular: el tiempo de ejecución de las tareas es nulo en tiempo virtual"
+#endif
+
+#define pdFALSE       ((BaseType_t)0)
+#define pdTRUE        ((BaseType_t)1)
+#define pdPASS        pdTRUE
+#define pdFAIL        pdFALSE
+#define errQUEUE_FULL ((BaseType_t)0)
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / (TickType_t)1000U))
+
+//! Las tareas no se interrumpen entre sí, por lo que las secciones críticas no hacen nada.
+#define taskDISABLE_INTERRUPTS()
+#define taskENABLE_INTERRUPTS()
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+//! Los envíos desde interrupciones nunca cambian de tarea en el momento.
+#define portYIELD_FROM_ISR(x) (void)(x)
+
+    /* === Public data type declarations =========================================================== */
+
+    typedef long BaseType_t;
+    typedef unsigned long UBaseType_t;
+    typedef uint32_t TickType_t;
+    typedef uintptr_t StackType_t;
+
+    //! Memoria de los objetos creados con las funciones *Static, el núcleo solo usa las pilas y los datos de las colas.
+    typedef struct
+    {
+        void * reservado;
+    } StaticTask_t, StaticQueue_t, StaticTimer_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Memoria libre del heap simulado, que solo descuenta lo que reservaron las funciones de creación.
+     */
+    size_t xPortGetFreeHeapSize(void);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* INC_FREERTOS_H */
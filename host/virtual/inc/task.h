@@ -0,0 +1,104 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+/** \brief Tareas del núcleo en tiempo virtual
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "FreeRTOS.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0U)
+
+    /* === Public data type declarations =========================================================== */
+
+    typedef struct tarea_s * TaskHandle_t;
+
+    typedef void (*TaskFunction_t)(void *);
+
+    //! Estado de una tarea, con los campos que consultan memoria.c y estadisticas.c.
+    typedef struct
+    {
+        TaskHandle_t xHandle;
+        const char * pcTaskName;
+        UBaseType_t uxCurrentPriority;
+        uint32_t ulRunTimeCounter;           //!< Siempre cero, las tareas no consumen tiempo virtual.
+        uint16_t usStackHighWaterMark;       //!< Menor cantidad de palabras libres que tuvo la pila.
+    } TaskStatus_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName, const uint16_t usStackDepth,
+                           void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask);
+
+    TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth,
+                                   void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer,
+                                   StaticTask_t * const pxTaskBuffer);
+
+    void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+
+    void vTaskDelay(const TickType_t xTicksToDelay);
+
+    TickType_t xTaskGetTickCount(void);
+
+    TickType_t xTaskGetTickCountFromISR(void);
+
+    /**
+     * @brief Ejecuta las tareas hasta que el guion de la simulación termina el programa, por lo que no retorna si
+     * hay alguna tarea creada.
+     */
+    void vTaskStartScheduler(void);
+
+    void vTaskSuspendAll(void);
+
+    BaseType_t xTaskResumeAll(void);
+
+    UBaseType_t uxTaskGetSystemState(TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                     uint32_t * const pulTotalRunTime);
+
+    //! No hay tarea inactiva, el núcleo avanza el tick cuando ninguna tarea puede ejecutarse.
+    TaskHandle_t xTaskGetIdleTaskHandle(void);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* INC_TASK_H */
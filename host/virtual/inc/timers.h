@@ -0,0 +1,83 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef INC_TIMERS_H
+#define INC_TIMERS_H
+
+/** \brief Temporizadores por software del núcleo en tiempo virtual
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "FreeRTOS.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Los temporizadores se atienden dentro del tick, desde una interrupción se cambian igual que desde una tarea.
+#define xTimerStartFromISR(xTimer, pxHigherPriorityTaskWoken)                                                          \
+    (*(pxHigherPriorityTaskWoken) = pdFALSE, xTimerStart((xTimer), 0))
+#define xTimerStopFromISR(xTimer, pxHigherPriorityTaskWoken)                                                           \
+    (*(pxHigherPriorityTaskWoken) = pdFALSE, xTimerStop((xTimer), 0))
+
+    /* === Public data type declarations =========================================================== */
+
+    typedef struct temporizador_s * TimerHandle_t;
+
+    typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    TimerHandle_t xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                               const UBaseType_t uxAutoReload, void * const pvTimerID,
+                               TimerCallbackFunction_t pxCallbackFunction);
+
+    TimerHandle_t xTimerCreateStatic(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                     const UBaseType_t uxAutoReload, void * const pvTimerID,
+                                     TimerCallbackFunction_t pxCallbackFunction, StaticTimer_t * pxTimerBuffer);
+
+    BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+
+    BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+
+    BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+
+    void * pvTimerGetTimerID(const TimerHandle_t xTimer);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* INC_TIMERS_H */
@@ -0,0 +1,114 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef VIRTUAL_H
+#define VIRTUAL_H
+
+/** \brief Base de tiempo de la simulación en tiempo virtual
+ **
+ ** Interfaz entre el núcleo en tiempo virtual y el guion que maneja el poncho simulado.
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include "perfil.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+    /* === Public data type declarations =========================================================== */
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Devuelve los ticks transcurridos desde el arranque, sin el desborde de los 32 bits del tick de FreeRTOS.
+     */
+    uint64_t VirtualTicks(void);
+
+    /**
+     * @brief Atiende un tick nuevo antes que las tareas, lo implementa el guion.
+     *
+     * Se llama con las tareas bloqueadas, desde el contexto de cualquiera de ellas, por lo que puede cambiar las
+     * entradas del poncho pero no debe llamar a funciones del núcleo que bloqueen.
+     *
+     * @param ticks Ticks transcurridos desde el arranque.
+     */
+    void VirtualTick(uint64_t ticks);
+
+    /**
+     * @brief Registra que la tarea actual ejecutó una sonda, lo llama ProbeRecord con PROFILING en 1.
+     *
+     * @param probe Sonda ejecutada.
+     */
+    void VirtualProbe(probe_t probe);
+
+    /**
+     * @brief Marca el comienzo de la atención de una interrupción del modelo de la placa, lo llama chip.c.
+     *
+     * Desde ahí hasta VirtualInterruptExit el tiempo de la computadora es de la interrupción y no del trabajo en curso,
+     * y las sondas no se registran: respuesta.py cuenta cada interrupción con su costo fijo.
+     */
+    void VirtualInterruptEnter(void);
+
+    /**
+     * @brief Marca el final de la atención de una interrupción del modelo de la placa, lo llama chip.c.
+     */
+    void VirtualInterruptExit(void);
+
+    /**
+     * @brief Informa las interrupciones atendidas desde el aviso anterior, lo implementa el guion.
+     *
+     * @param count Cantidad de interrupciones atendidas.
+     * @param cost  Nanosegundos que ocuparon la computadora.
+     */
+    void VirtualInterrupts(uint32_t count, uint64_t cost);
+
+    /**
+     * @brief Informa un trabajo terminado de una tarea, lo implementa el guion.
+     *
+     * @param task      Nombre de la tarea.
+     * @param release   Tick en que la tarea quedó lista para el trabajo.
+     * @param cost      Nanosegundos que el trabajo ocupó la computadora, sin contar el tiempo en que otra tarea lo
+     *                  desplazó.
+     * @param probes    Cantidad de veces que el trabajo ejecutó cada sonda.
+     */
+    void VirtualJob(const char * task, uint64_t release, uint64_t cost, const uint16_t probes[PROBES_COUNT]);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* VIRTUAL_H */
@@ -0,0 +1,967 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Guion de la simulación en tiempo virtual
+ **
+ ** Maneja el poncho simulado con un guion que se lee de la entrada estándar, con los mismos comandos de teclas que el
+ ** simulador en tiempo real pero medidos en ticks, y verifica lo que muestra la pantalla y el zumbador. El programa
+ ** termina con código 0 al final del guion, 1 en la primera verificación que falla y 2 si el guion tiene un error.
+ **
+ ** Comandos, uno por línea, las líneas vacías y el texto desde un '#' se ignoran:
+ **
+ **     presionar TECLA         deja presionada la tecla: f1, f2, f3, f4, aceptar o cancelar
+ **     soltar TECLA            suelta la tecla
+ **     pulsar TECLA [TIEMPO]   presiona la tecla durante TIEMPO, 200 ms si no se indica
+ **     esperar TIEMPO          avanza el tiempo virtual antes del comando siguiente
+ **     pantalla                muestra lo que indica la pantalla
+ **     pantalla [12.34]        verifica lo que indica la pantalla, con un espacio por cada dígito apagado
+ **     aguardar [12  ] TIEMPO  avanza el tiempo hasta que la pantalla indique el texto y falla si no lo indica antes de
+ **                             TIEMPO; con los dígitos que parpadean apagados identifica el modo de la interfaz
+ **     zumbador si|no          verifica si el zumbador está sonando
+ **     alarmas N               verifica cuántas veces empezó a sonar el zumbador desde el arranque
+ **     eventos si|no           informa o no cada cambio de la pantalla y del zumbador
+ **     referencia ARCHIVO      verifica cada cambio siguiente de la pantalla y del zumbador contra el archivo
+ **     reproducir ARCHIVO      reproduce una grabación de las entradas y espera a que termine
+ **     guardar ARCHIVO         guarda la grabación de las entradas del firmware, compilado con RECORDING en 1
+ **     trafico [borrar]        informa los accesos a los puertos GPIO por puerto y por lugar de llamada, o los pone
+ **                             en cero, con el firmware compilado con GPIO_ACCOUNTING en 1
+ **     activaciones ARCHIVO    escribe en el archivo cada trabajo terminado de cada tarea, para tools/respuesta.py
+ **     carga [borrar]          informa los despertares por segundo virtual de cada tarea y el tiempo que sus trabajos
+ **                             ocuparon la computadora por segundo virtual, desde el arranque o desde carga borrar; las
+ **                             interrupciones del modelo de la placa se informan juntas como una tarea más
+ **     reposo TIEMPO           verifica que desde el arranque o desde carga borrar el procesador pasó al menos TIEMPO
+ **                             seguido sin despertar, ni por un trabajo de una tarea ni por una interrupción
+ **     escribir [texto]        envía el texto y un fin de línea por la UART de depuración, a la consola del firmware
+ **     respuesta [texto] TIEMPO
+ **                             avanza el tiempo hasta que el firmware envíe el texto por la UART y falla si no lo
+ **                             envía antes de TIEMPO; lo que se envió hasta el texto ya no se vuelve a revisar
+ **     salir                   termina el guion
+ **
+ ** Los tiempos son un número seguido opcionalmente de ms, s, m o h, en milisegundos si no se indica la unidad. Cada
+ ** línea que se informa empieza con el tiempo virtual desde el arranque.
+ **
+ ** Una grabación, hecha en la placa o con guardar, tiene los ticks desde el arranque, por lo que reproducir va al
+ ** principio del guion. La referencia tiene las líneas que informa eventos si, como las escribió una ejecución que se
+ ** considera correcta; al terminar el guion tienen que haberse visto todas.
+ **
+ ** La UART de depuración se conecta al guion con un par de sockets que se crea con el primer escribir o respuesta;
+ ** hasta entonces el firmware no recibe nada y lo que envía se descarta.
+ **
+ ** Las activaciones se escriben una por línea, con campos separados por tabulaciones: el tick en que la tarea quedó
+ ** lista, el nombre de la tarea y las sondas que ejecutó el trabajo como nombre:veces separadas por comas. Las sondas
+ ** solo se registran con el firmware compilado con PROFILING en 1.
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _GNU_SOURCE
+
+#include "FreeRTOS.h"
+#include "grabacion.h"
+#include "modelo.h"
+#include "simulador.h"
+#include "trafico.h"
+#include "virtual.h"
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Ticks sin barridos completos después de los cuales la pantalla se considera apagada.
+#define PANTALLA_APAGADA pdMS_TO_TICKS(100)
+
+//! Duración de una pulsación si el comando no la indica, en milisegundos.
+#define PULSACION 200
+
+//! Largo máximo de una línea del guion.
+#define LARGO_LINEA 128
+
+//! Mayor cantidad de registros de una grabación que se puede reproducir.
+#define REGISTROS_MAXIMO 4096
+
+//! Mayor cantidad de tareas de las que se informa la carga, con la de temporizadores y las interrupciones.
+#define TAREAS_CARGA 8
+
+//! Nombre con el que se informa la carga de las interrupciones del modelo de la placa.
+#define CARGA_INTERRUPCIONES "interrupciones"
+
+//! Bytes enviados por el firmware que se conservan para el comando respuesta, los más antiguos se descartan.
+#define SALIDA_UART 4096
+
+//! Códigos de salida del programa.
+#define GUION_CORRECTO 0
+#define GUION_FALLIDO  1
+#define GUION_ERRONEO  2
+
+/* === Private data type declarations ========================================================== */
+
+//! Trabajos terminados de una tarea y tiempo de la computadora que ocuparon.
+typedef struct
+{
+    const char * nombre;
+    uint64_t trabajos;
+    uint64_t costo;
+} carga_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Devuelve lo que muestra la pantalla, vacía si no hubo barridos recientes.
+ */
+static uint64_t Cuadro(uint64_t ahora);
+
+/**
+ * @brief Informa los cambios de la pantalla y del zumbador desde el tick anterior.
+ */
+static void RevisarSalidas(uint64_t ahora);
+
+/**
+ * @brief Informa un cambio de las salidas si los eventos están habilitados y lo compara con la referencia.
+ */
+static void Informar(uint64_t ahora, const char * formato, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Verifica si la pantalla ya indica el texto del comando aguardar, en ese caso termina la espera.
+ */
+static void Aguardar(uint64_t ahora);
+
+/**
+ * @brief Crea el par de sockets de la UART de depuración si todavía no existe.
+ */
+static void ConectarUart(void);
+
+/**
+ * @brief Agrega a la salida lo que envió el firmware por la UART y, si el comando respuesta espera un texto, termina
+ * la espera cuando aparece.
+ */
+static void LeerUart(uint64_t ahora);
+
+/**
+ * @brief Carga una grabación de las entradas y devuelve el tick de su último cambio.
+ */
+static uint64_t Cargar(const char * archivo, uint64_t ahora);
+
+/**
+ * @brief Aplica los cambios de la grabación que corresponden hasta el tick actual.
+ */
+static void Reproducir(uint64_t ahora);
+
+/**
+ * @brief Escribe en un archivo la grabación de las entradas del firmware.
+ */
+static void Guardar(const char * archivo);
+
+/**
+ * @brief Informa los accesos a los puertos GPIO contados desde el arranque o desde trafico borrar.
+ */
+static void InformarTrafico(uint64_t ahora);
+
+/**
+ * @brief Suma trabajos y tiempo de la computadora a la carga de una tarea.
+ */
+static void Contar(const char * nombre, uint32_t trabajos, uint64_t costo);
+
+/**
+ * @brief Informa la carga de cada tarea contada desde el arranque o desde carga borrar.
+ */
+static void InformarCarga(uint64_t ahora);
+
+/**
+ * @brief Anota un despertar del procesador y el reposo que lo precedió, si es el más largo.
+ */
+static void Despertar(uint64_t tick);
+
+/**
+ * @brief Ejecuta un comando, los que demoran a los siguientes fijan el tick en que termina la espera.
+ */
+static void Ejecutar(char * linea, uint64_t ahora);
+
+/**
+ * @brief Convierte un tiempo con unidad opcional a ticks.
+ *
+ * @return true El texto es un tiempo válido.
+ */
+static bool LeerTiempo(const char * texto, uint64_t * ticks);
+
+/**
+ * @brief Escribe el tiempo virtual desde el arranque como horas, minutos, segundos y milisegundos.
+ */
+static const char * Tiempo(uint64_t ticks);
+
+/**
+ * @brief Informa que el guion tiene un error en la línea actual y termina el programa.
+ */
+static void Error(const char * mensaje, const char * detalle);
+
+/**
+ * @brief Informa una verificación fallida en la línea actual y termina el programa.
+ */
+static void Fallar(uint64_t ahora, const char * formato, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Informa el resultado del guion y termina el programa.
+ */
+static void Terminar(uint64_t ahora);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static unsigned int numero_linea = 0;
+static uint64_t espera = 0;
+static const model_key_t * soltar = NULL;
+static bool eventos = false;
+static struct timespec inicio;
+static FILE * referencia = NULL;
+static FILE * activaciones = NULL;
+
+// Carga de cada tarea y tick desde el que se cuenta
+static carga_t cargas[TAREAS_CARGA];
+static uint64_t carga_desde = 0;
+
+// Tick del último despertar del procesador y reposo más largo desde carga_desde, en ticks
+static uint64_t ultimo_despertar = 0;
+static uint64_t reposo_maximo = 0;
+
+// Grabación en reproducción y tick del próximo cambio
+static recording_entry_t registros[REGISTROS_MAXIMO];
+static uint32_t cantidad = 0;
+static uint32_t reproducidos = 0;
+static uint64_t proximo = 0;
+
+// Estado de las salidas, lo actualizan las tareas
+static uint64_t ultimo_barrido = 0;
+static bool zumbador = false;
+static uint32_t alarmas = 0;
+
+// Texto que aguarda el comando aguardar, vacío si no hay ninguno
+static char aguardado[MODEL_TEXT_SIZE] = "";
+
+// Extremos de la UART del firmware y del guion, lo enviado por el firmware y el texto que espera el comando respuesta
+static int uart[2] = {-1, -1};
+static char salida[SALIDA_UART];
+static size_t enviados = 0;
+static char respuesta[LARGO_LINEA + 1] = "";
+
+/* === Private function implementation ========================================================= */
+
+static uint64_t Cuadro(uint64_t ahora)
+{
+    return ((ahora - ultimo_barrido) > PANTALLA_APAGADA) ? 0 : ModelFrame();
+}
+
+static void RevisarSalidas(uint64_t ahora)
+{
+    static uint64_t mostrado = 0;
+    static bool sonando = false;
+    uint64_t actual = Cuadro(ahora);
+    char texto[MODEL_TEXT_SIZE];
+
+    if (actual != mostrado)
+    {
+        mostrado = actual;
+        ModelFrameText(actual, texto);
+        Informar(ahora, "pantalla [%s]", texto);
+    }
+
+    if (zumbador != sonando)
+    {
+        sonando = zumbador;
+        Informar(ahora, "zumbador %s", sonando ? "si" : "no");
+    }
+
+    return;
+}
+
+static void Informar(uint64_t ahora, const char * formato, ...)
+{
+    char evento[LARGO_LINEA + 1];
+    char esperado[LARGO_LINEA + 1];
+    va_list argumentos;
+    int largo = snprintf(evento, sizeof(evento), "%s ", Tiempo(ahora));
+
+    va_start(argumentos, formato);
+    vsnprintf(evento + largo, sizeof(evento) - largo, formato, argumentos);
+    va_end(argumentos);
+
+    if (eventos)
+    {
+        printf("%s\n", evento);
+    }
+
+    if (referencia)
+    {
+        if (!fgets(esperado, sizeof(esperado), referencia))
+        {
+            Fallar(ahora, "la referencia no tiene el evento %s", evento);
+        }
+        esperado[strcspn(esperado, "\r\n")] = '\0';
+        if (strcmp(esperado, evento))
+        {
+            Fallar(ahora, "se esperaba el evento %s y ocurrio %s", esperado, evento);
+        }
+    }
+
+    return;
+}
+
+static void Aguardar(uint64_t ahora)
+{
+    char texto[MODEL_TEXT_SIZE];
+
+    ModelFrameText(Cuadro(ahora), texto);
+    if (!strcmp(texto, aguardado))
+    {
+        aguardado[0] = '\0';
+        espera = ahora;
+    }
+    else if (ahora >= espera)
+    {
+        Fallar(ahora, "la pantalla no indico [%s], muestra [%s]", aguardado, texto);
+    }
+
+    return;
+}
+
+static void ConectarUart(void)
+{
+    if (uart[0] >= 0)
+    {
+        return;
+    }
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, uart) < 0)
+    {
+        Error("no se puede crear la uart", "socketpair");
+    }
+    fcntl(uart[0], F_SETFL, O_NONBLOCK);
+    fcntl(uart[1], F_SETFL, O_NONBLOCK);
+
+    return;
+}
+
+static void LeerUart(uint64_t ahora)
+{
+    ssize_t leidos;
+    const char * encontrado;
+    size_t largo = strlen(respuesta);
+
+    if (enviados == sizeof(salida)) // Lo más antiguo deja lugar, el texto esperado entra en la mitad que queda
+    {
+        memmove(salida, salida + sizeof(salida) / 2, sizeof(salida) / 2);
+        enviados = sizeof(salida) / 2;
+    }
+    leidos = read(uart[1], salida + enviados, sizeof(salida) - enviados);
+    if (leidos > 0)
+    {
+        enviados += leidos;
+    }
+
+    if (!largo)
+    {
+        return;
+    }
+
+    // La telemetría comparte la UART y sus tramas tienen bytes en cero, por eso no se busca como cadena
+    encontrado = memmem(salida, enviados, respuesta, largo);
+    if (encontrado)
+    {
+        enviados -= encontrado + largo - salida;
+        memmove(salida, encontrado + largo, enviados);
+        respuesta[0] = '\0';
+        espera = ahora;
+    }
+    else if (ahora >= espera)
+    {
+        Fallar(ahora, "el firmware no envio [%s] por la uart", respuesta);
+    }
+
+    return;
+}
+
+static uint64_t Cargar(const char * archivo, uint64_t ahora)
+{
+    recording_buffer_t encabezado;
+    FILE * entrada = fopen(archivo, "rb");
+    size_t leidos = 0;
+    uint64_t final;
+
+    if (!entrada)
+    {
+        Error("no se puede abrir", archivo);
+    }
+
+    // La capacidad de la grabación depende de RECORDING_ENTRIES en el equipo, los registros se leen por separado
+    if ((fread(&encabezado, offsetof(recording_buffer_t, entries), 1, entrada) != 1) ||
+        (encabezado.magic != RECORDING_MAGIC) || (encabezado.entry_size != sizeof(recording_entry_t)) ||
+        (encabezado.written > encabezado.capacity) || (encabezado.written > REGISTROS_MAXIMO))
+    {
+        Error("no es una grabacion valida", archivo);
+    }
+    leidos = fread(registros, sizeof(recording_entry_t), encabezado.written, entrada);
+    fclose(entrada);
+    if (leidos != encabezado.written)
+    {
+        Error("grabacion incompleta", archivo);
+    }
+    if (encabezado.dropped)
+    {
+        fprintf(stderr, "linea %u: la grabacion perdio %u cambios al llenarse\n", numero_linea, encabezado.dropped);
+    }
+
+    cantidad = encabezado.written;
+    reproducidos = 0;
+    proximo = cantidad ? registros[0].delay : ahora;
+    if (proximo < ahora)
+    {
+        Error("la grabacion empieza antes del tick actual", archivo);
+    }
+
+    final = proximo;
+    for (uint32_t indice = 1; indice < cantidad; indice++)
+    {
+        final += registros[indice].delay;
+    }
+
+    return final;
+}
+
+static void Reproducir(uint64_t ahora)
+{
+    while ((reproducidos < cantidad) && (proximo <= ahora))
+    {
+        const recording_entry_t * registro = &registros[reproducidos++];
+
+        if (registro->pin != RECORDING_PAUSE)
+        {
+            SimulatorSetInput(registro->pin >> 5, registro->pin & 0x1F, registro->level);
+        }
+        if (reproducidos < cantidad)
+        {
+            proximo += registros[reproducidos].delay;
+        }
+    }
+
+    return;
+}
+
+static void Guardar(const char * archivo)
+{
+    size_t tamanio;
+    const void * grabacion = RecordingGetBuffer(&tamanio);
+    FILE * salida = fopen(archivo, "wb");
+
+    if (!salida || (fwrite(grabacion, tamanio, 1, salida) != 1) || fclose(salida))
+    {
+        Error("no se puede escribir", archivo);
+    }
+
+    return;
+}
+
+static void InformarTrafico(uint64_t ahora)
+{
+    traffic_counts_t accesos;
+
+    for (uint8_t puerto = 0; puerto < TRAFFIC_PORTS; puerto++)
+    {
+        TrafficGetPort(puerto, &accesos);
+        if (accesos.reads || accesos.writes)
+        {
+            printf("%s trafico gpio%u lecturas %u escrituras %u redundantes %u\n", Tiempo(ahora), puerto,
+                   accesos.reads, accesos.writes, accesos.redundant);
+        }
+    }
+
+    for (const traffic_site_t * lugar = TrafficGetSites(); lugar; lugar = lugar->next)
+    {
+        if (lugar->counts.reads || lugar->counts.writes)
+        {
+            printf("%s trafico %s:%u lecturas %u escrituras %u redundantes %u\n", Tiempo(ahora), lugar->function,
+                   lugar->line, lugar->counts.reads, lugar->counts.writes, lugar->counts.redundant);
+        }
+    }
+
+    return;
+}
+
+static void Contar(const char * nombre, uint32_t trabajos, uint64_t costo)
+{
+    for (uint8_t indice = 0; indice < TAREAS_CARGA; indice++)
+    {
+        if (!cargas[indice].nombre || !strcmp(cargas[indice].nombre, nombre))
+        {
+            cargas[indice].nombre = nombre;
+            cargas[indice].trabajos += trabajos;
+            cargas[indice].costo += costo;
+            break;
+        }
+    }
+
+    return;
+}
+
+static void Despertar(uint64_t tick)
+{
+    // Un trabajo se informa al terminar, cuando las interrupciones de su mismo tick ya se anotaron
+    if (tick > ultimo_despertar)
+    {
+        if (tick - ultimo_despertar > reposo_maximo)
+        {
+            reposo_maximo = tick - ultimo_despertar;
+        }
+        ultimo_despertar = tick;
+    }
+
+    return;
+}
+
+static void InformarCarga(uint64_t ahora)
+{
+    double segundos = (double)(ahora - carga_desde) / configTICK_RATE_HZ;
+    uint64_t trabajos = 0;
+    uint64_t costo = 0;
+
+    if (ahora == carga_desde)
+    {
+        return;
+    }
+
+    for (uint8_t indice = 0; (indice < TAREAS_CARGA) && cargas[indice].nombre; indice++)
+    {
+        printf("%s carga %s despertares %.2f/s cpu %.2f us/s\n", Tiempo(ahora), cargas[indice].nombre,
+               cargas[indice].trabajos / segundos, cargas[indice].costo / segundos / 1000);
+        trabajos += cargas[indice].trabajos;
+        costo += cargas[indice].costo;
+    }
+    printf("%s carga total despertares %.2f/s cpu %.2f us/s en %.0f s\n", Tiempo(ahora), trabajos / segundos,
+           costo / segundos / 1000, segundos);
+
+    return;
+}
+
+static void Ejecutar(char * linea, uint64_t ahora)
+{
+    char texto[MODEL_TEXT_SIZE];
+    char esperado[LARGO_LINEA + 1] = "";
+    char limite[LARGO_LINEA + 1] = "";
+    char * apertura = strchr(linea, '[');
+    char * cierre = strrchr(linea, ']');
+    char * comando;
+    char * argumento;
+    char * duracion;
+    const model_key_t * tecla;
+    uint64_t tiempo;
+    uint64_t reposo;
+
+    // El texto se copia antes de separar las palabras porque los dígitos apagados son espacios
+    if (apertura && (cierre > apertura))
+    {
+        memcpy(esperado, apertura + 1, cierre - apertura - 1);
+        esperado[cierre - apertura - 1] = '\0';
+        sscanf(cierre + 1, "%128s", limite);
+    }
+
+    comando = strtok(linea, " \t");
+    argumento = strtok(NULL, " \t");
+    duracion = strtok(NULL, " \t");
+    tecla = ModelFindKey(argumento);
+
+    if (!comando) // Línea vacía o comentario
+    {
+        return;
+    }
+
+    if (!strcmp(comando, "presionar") && tecla)
+    {
+        ModelSetKey(tecla, true);
+    }
+    else if (!strcmp(comando, "soltar") && tecla)
+    {
+        ModelSetKey(tecla, false);
+    }
+    else if (!strcmp(comando, "pulsar") && tecla)
+    {
+        tiempo = pdMS_TO_TICKS(PULSACION);
+        if (duracion && !LeerTiempo(duracion, &tiempo))
+        {
+            Error("tiempo invalido", duracion);
+        }
+        ModelSetKey(tecla, true);
+        soltar = tecla;
+        espera = ahora + tiempo;
+    }
+    else if (!strcmp(comando, "esperar") && argumento)
+    {
+        if (!LeerTiempo(argumento, &tiempo))
+        {
+            Error("tiempo invalido", argumento);
+        }
+        espera = ahora + tiempo;
+    }
+    else if (!strcmp(comando, "pantalla") && !argumento)
+    {
+        ModelFrameText(Cuadro(ahora), texto);
+        printf("%s pantalla [%s]\n", Tiempo(ahora), texto);
+    }
+    else if (!strcmp(comando, "pantalla") && apertura && (cierre > apertura))
+    {
+        ModelFrameText(Cuadro(ahora), texto);
+        if (strcmp(texto, esperado))
+        {
+            Fallar(ahora, "se esperaba pantalla [%s] y muestra [%s]", esperado, texto);
+        }
+    }
+    else if (!strcmp(comando, "aguardar") && apertura && (cierre > apertura) && (strlen(esperado) < MODEL_TEXT_SIZE))
+    {
+        if (!LeerTiempo(limite, &tiempo))
+        {
+            Error("tiempo invalido", limite);
+        }
+        strcpy(aguardado, esperado);
+        espera = ahora + tiempo;
+        Aguardar(ahora);
+    }
+    else if (!strcmp(comando, "zumbador") && argumento && (!strcmp(argumento, "si") || !strcmp(argumento, "no")))
+    {
+        if (zumbador != !strcmp(argumento, "si"))
+        {
+            Fallar(ahora, "se esperaba zumbador %s", argumento);
+        }
+    }
+    else if (!strcmp(comando, "alarmas") && argumento)
+    {
+        if (strtoul(argumento, NULL, 10) != alarmas)
+        {
+            Fallar(ahora, "se esperaban %s alarmas y sonaron %u", argumento, alarmas);
+        }
+    }
+    else if (!strcmp(comando, "eventos") && argumento && (!strcmp(argumento, "si") || !strcmp(argumento, "no")))
+    {
+        eventos = !strcmp(argumento, "si");
+    }
+    else if (!strcmp(comando, "referencia") && argumento)
+    {
+        if (referencia)
+        {
+            fclose(referencia);
+        }
+        referencia = fopen(argumento, "r");
+        if (!referencia)
+        {
+            Error("no se puede abrir", argumento);
+        }
+    }
+    else if (!strcmp(comando, "reproducir") && argumento)
+    {
+        espera = Cargar(argumento, ahora);
+        Reproducir(ahora);
+    }
+    else if (!strcmp(comando, "guardar") && argumento)
+    {
+        Guardar(argumento);
+    }
+    else if (!strcmp(comando, "activaciones") && argumento)
+    {
+        if (activaciones)
+        {
+            fclose(activaciones);
+        }
+        activaciones = fopen(argumento, "w");
+        if (!activaciones)
+        {
+            Error("no se puede escribir", argumento);
+        }
+    }
+    else if (!strcmp(comando, "trafico") && !argumento)
+    {
+        InformarTrafico(ahora);
+    }
+    else if (!strcmp(comando, "trafico") && !strcmp(argumento, "borrar"))
+    {
+        TrafficClear();
+    }
+    else if (!strcmp(comando, "carga") && !argumento)
+    {
+        InformarCarga(ahora);
+    }
+    else if (!strcmp(comando, "carga") && !strcmp(argumento, "borrar"))
+    {
+        memset(cargas, 0, sizeof(cargas));
+        carga_desde = ahora;
+        ultimo_despertar = ahora;
+        reposo_maximo = 0;
+    }
+    else if (!strcmp(comando, "reposo") && argumento)
+    {
+        if (!LeerTiempo(argumento, &tiempo))
+        {
+            Error("tiempo invalido", argumento);
+        }
+        reposo = ahora - ultimo_despertar; // El reposo en curso también cuenta
+        if (reposo < reposo_maximo)
+        {
+            reposo = reposo_maximo;
+        }
+        if (reposo < tiempo)
+        {
+            Fallar(ahora, "se esperaba un reposo de %llu ticks y el mayor fue de %llu", (unsigned long long)tiempo,
+                   (unsigned long long)reposo);
+        }
+    }
+    else if (!strcmp(comando, "escribir") && apertura && (cierre > apertura) && (strlen(esperado) < LARGO_LINEA))
+    {
+        ConectarUart();
+        strcat(esperado, "\n");
+        if (write(uart[1], esperado, strlen(esperado)) != (ssize_t)strlen(esperado))
+        {
+            Error("no se puede escribir en la uart", esperado);
+        }
+    }
+    else if (!strcmp(comando, "respuesta") && apertura && (cierre > apertura + 1))
+    {
+        if (!LeerTiempo(limite, &tiempo))
+        {
+            Error("tiempo invalido", limite);
+        }
+        ConectarUart();
+        strcpy(respuesta, esperado);
+        espera = ahora + tiempo;
+        LeerUart(ahora);
+    }
+    else if (!strcmp(comando, "salir"))
+    {
+        Terminar(ahora);
+    }
+    else
+    {
+        Error("comando desconocido", comando);
+    }
+
+    return;
+}
+
+static bool LeerTiempo(const char * texto, uint64_t * ticks)
+{
+    char * unidad;
+    uint64_t valor = strtoull(texto, &unidad, 10);
+    uint64_t milisegundos;
+
+    if (unidad == texto)
+    {
+        return false;
+    }
+
+    if (!strcmp(unidad, "") || !strcmp(unidad, "ms"))
+    {
+        milisegundos = valor;
+    }
+    else if (!strcmp(unidad, "s"))
+    {
+        milisegundos = valor * 1000;
+    }
+    else if (!strcmp(unidad, "m"))
+    {
+        milisegundos = valor * 60 * 1000;
+    }
+    else if (!strcmp(unidad, "h"))
+    {
+        milisegundos = valor * 60 * 60 * 1000;
+    }
+    else
+    {
+        return false;
+    }
+
+    *ticks = milisegundos * configTICK_RATE_HZ / 1000;
+
+    return true;
+}
+
+static const char * Tiempo(uint64_t ticks)
+{
+    static char texto[32];
+    uint64_t milisegundos = ticks * 1000 / configTICK_RATE_HZ;
+
+    snprintf(texto, sizeof(texto), "%02u:%02u:%02u.%03u", (unsigned int)(milisegundos / 3600000),
+             (unsigned int)(milisegundos / 60000 % 60), (unsigned int)(milisegundos / 1000 % 60),
+             (unsigned int)(milisegundos % 1000));
+
+    return texto;
+}
+
+static void Error(const char * mensaje, const char * detalle)
+{
+    fprintf(stderr, "linea %u: %s %s\n", numero_linea, mensaje, detalle);
+    fflush(stdout);
+    exit(GUION_ERRONEO);
+}
+
+static void Fallar(uint64_t ahora, const char * formato, ...)
+{
+    va_list argumentos;
+
+    fprintf(stderr, "linea %u, %s: ", numero_linea, Tiempo(ahora));
+    va_start(argumentos, formato);
+    vfprintf(stderr, formato, argumentos);
+    va_end(argumentos);
+    fputc('\n', stderr);
+    fflush(stdout);
+    exit(GUION_FALLIDO);
+}
+
+static void Terminar(uint64_t ahora)
+{
+    struct timespec fin;
+    char pendiente[LARGO_LINEA + 1];
+
+    if (referencia && fgets(pendiente, sizeof(pendiente), referencia))
+    {
+        pendiente[strcspn(pendiente, "\r\n")] = '\0';
+        Fallar(ahora, "no ocurrio el evento %s de la referencia", pendiente);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    printf("guion correcto: %s simulados en %.2f s\n", Tiempo(ahora),
+           (fin.tv_sec - inicio.tv_sec) + (fin.tv_nsec - inicio.tv_nsec) / 1e9);
+    fflush(stdout);
+    exit(GUION_CORRECTO);
+}
+
+/* === Public function implementation ========================================================== */
+
+void VirtualTick(uint64_t ticks)
+{
+    char linea[LARGO_LINEA + 1];
+
+    if (ticks == 1)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+    }
+
+    Reproducir(ticks);
+    if (eventos || referencia)
+    {
+        RevisarSalidas(ticks);
+    }
+
+    if (aguardado[0])
+    {
+        Aguardar(ticks);
+    }
+
+    if (uart[1] >= 0) // Se lee siempre para que el firmware no llene el socket
+    {
+        LeerUart(ticks);
+    }
+
+    while (ticks >= espera)
+    {
+        if (soltar) // Termina la pulsación en curso
+        {
+            ModelSetKey(soltar, false);
+            soltar = NULL;
+        }
+
+        if (!fgets(linea, sizeof(linea), stdin))
+        {
+            Terminar(ticks);
+        }
+        numero_linea++;
+        linea[strcspn(linea, "\r\n#")] = '\0';
+        Ejecutar(linea, ticks);
+    }
+
+    return;
+}
+
+void VirtualJob(const char * task, uint64_t release, uint64_t cost, const uint16_t probes[PROBES_COUNT])
+{
+    const char * separador = "\t";
+
+    Contar(task, 1, cost);
+    Despertar(release);
+    if (!activaciones)
+    {
+        return;
+    }
+
+    fprintf(activaciones, "%llu\t%s", (unsigned long long)release, task);
+    for (int sonda = 0; sonda < PROBES_COUNT; sonda++)
+    {
+        if (probes[sonda])
+        {
+            fprintf(activaciones, "%s%s:%u", separador, ProbeName(sonda), probes[sonda]);
+            separador = ",";
+        }
+    }
+    fputc('\n', activaciones);
+
+    return;
+}
+
+void VirtualInterrupts(uint32_t count, uint64_t cost)
+{
+    Contar(CARGA_INTERRUPCIONES, count, cost);
+    Despertar(VirtualTicks());
+
+    return;
+}
+
+void SimulatorOutputsChanged(uint8_t port, uint32_t outputs)
+{
+    bool sonando;
+
+    if (ModelOutputsChanged(port, outputs))
+    {
+        ultimo_barrido = VirtualTicks();
+    }
+
+    sonando = ModelBuzzer();
+    if (sonando && !zumbador)
+    {
+        alarmas++;
+    }
+    zumbador = sonando;
+
+    return;
+}
+
+int SimulatorSerial(void)
+{
+    return uart[0]; // Sin el par de sockets lo que se envía se descarta
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,792 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Núcleo en tiempo virtual
+ **
+ ** Cada tarea tiene un contexto de ucontext sobre su propia pila. Solo se cambia de contexto cuando otra tarea tiene
+ ** que ejecutarse: si la tarea que se bloquea es la primera que queda lista después de avanzar el tick, como la
+ ** principal cuando el barrido le envía un evento, el avance ocurre dentro de la llamada que la bloqueó y la tarea
+ ** sigue sin cambiar de contexto. Así el costo de cada tick es el del código del firmware y una hora simulada dura
+ ** menos de un segundo.
+ **
+ ** Cada trabajo de una tarea, desde que queda lista hasta que se vuelve a bloquear, se informa al guion con el tick en
+ ** que se liberó, las sondas de perfil.h que ejecutó y los nanosegundos que el trabajo ocupó la computadora. Los
+ ** temporizadores vencidos en un mismo tick forman un trabajo de la tarea de temporizadores, como en FreeRTOS. El costo
+ ** cuenta solo el código de las tareas y de los temporizadores: el avance del tick, con el gancho del tick y el guion,
+ ** queda afuera. Las interrupciones del modelo de la placa se miden aparte, también las que pide el código de un
+ ** trabajo, y se informan al guion una vez por tick.
+ **
+ ** \addtogroup virtual VIRTUAL
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "perfil.h"
+#include "simulador.h"
+#include "virtual.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Cantidad máxima de objetos de cada tipo.
+#define TAREAS_MAXIMO         4
+#define COLAS_MAXIMO          4
+#define TEMPORIZADORES_MAXIMO 8
+
+//! Valor con el que se llenan las pilas para medir la menor cantidad de memoria libre que tuvieron.
+#define RELLENO_PILA 0xA5
+
+//! Nombre de la tarea que ejecuta los temporizadores, el de FreeRTOS.
+#define TAREA_TEMPORIZADORES "Tmr Svc"
+
+/* === Private data type declarations ========================================================== */
+
+//! Descriptor de una tarea.
+struct tarea_s
+{
+    ucontext_t contexto;
+    TaskFunction_t funcion;
+    void * parametros;
+    const char * nombre;
+    UBaseType_t prioridad;
+    StackType_t * pila;
+    uint32_t palabras;
+    bool lista;           // Puede ejecutarse
+    bool con_limite;      // Está bloqueada hasta el tick despertar
+    TickType_t despertar;
+    uint64_t liberacion;           // Tick en que quedó lista para el trabajo actual
+    uint16_t sondas[PROBES_COUNT]; // Sondas ejecutadas en el trabajo actual
+    uint64_t costo;                // Nanosegundos de la computadora que lleva el trabajo actual
+};
+
+//! Descriptor de una cola, con una sola tarea que recibe.
+struct cola_s
+{
+    uint8_t * datos;
+    UBaseType_t largo;
+    UBaseType_t tamanio;
+    UBaseType_t cantidad;
+    UBaseType_t lectura;
+    struct tarea_s * receptor; // Tarea bloqueada esperando un elemento
+};
+
+//! Descriptor de un temporizador por software.
+struct temporizador_s
+{
+    TimerCallbackFunction_t funcion;
+    void * identificador;
+    TickType_t periodo;
+    TickType_t vencimiento;
+    bool repetir;
+    bool activo;
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+#if (configUSE_TICK_HOOK == 1)
+//! Gancho del tick, definido en main.c.
+void vApplicationTickHook(void);
+#endif
+
+/**
+ * @brief Primera función de cada contexto, ejecuta la tarea actual.
+ */
+static void Arrancar(void);
+
+static struct tarea_s * CrearTarea(TaskFunction_t funcion, const char * nombre, uint32_t palabras, void * parametros,
+                                   UBaseType_t prioridad, StackType_t * pila);
+
+/**
+ * @brief Arma el contexto de una tarea sobre su pila para que empiece en Arrancar.
+ */
+static void PrepararContexto(struct tarea_s * tarea);
+
+static struct cola_s * CrearCola(UBaseType_t largo, UBaseType_t tamanio, uint8_t * datos);
+
+static struct temporizador_s * CrearTemporizador(TickType_t periodo, bool repetir, void * identificador,
+                                                  TimerCallbackFunction_t funcion);
+
+/**
+ * @brief Reserva memoria del heap simulado.
+ *
+ * @return void* Bloque reservado, NULL si se supera configTOTAL_HEAP_SIZE.
+ */
+static void * Reservar(size_t tamanio);
+
+/**
+ * @brief Devuelve la tarea lista de mayor prioridad, o NULL si todas están bloqueadas.
+ */
+static struct tarea_s * Elegir(void);
+
+/**
+ * @brief Avanza un tick: ejecuta los temporizadores vencidos y el guion, y despierta las tareas cuya espera venció.
+ */
+static void AvanzarTick(void);
+
+/**
+ * @brief Cambia a otra tarea, la actual retoma su ejecución cuando vuelva a elegirse.
+ */
+static void Cambiar(struct tarea_s * siguiente);
+
+/**
+ * @brief Bloquea la tarea actual y avanza el tick hasta que alguna tarea pueda ejecutarse.
+ *
+ * @param espera Ticks de espera, portMAX_DELAY para esperar sin límite.
+ */
+static void Bloquear(TickType_t espera);
+
+/**
+ * @brief Agrega un elemento a una cola y deja lista a la tarea que lo espera.
+ *
+ * @return struct tarea_s* Tarea que se despertó, NULL si no había ninguna esperando.
+ */
+static struct tarea_s * Agregar(struct cola_s * cola, const void * elemento, bool * agregado);
+
+/**
+ * @brief Suma al trabajo de la tarea actual el tiempo de la computadora desde que retomó su ejecución.
+ */
+static void Cobrar(void);
+
+static uint64_t Nanosegundos(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct tarea_s tareas[TAREAS_MAXIMO];
+static struct cola_s colas[COLAS_MAXIMO];
+static struct temporizador_s temporizadores[TEMPORIZADORES_MAXIMO];
+static uint8_t tareas_creadas = 0;
+static uint8_t colas_creadas = 0;
+static uint8_t temporizadores_creados = 0;
+static size_t heap_reservado = 0;
+
+static ucontext_t inicio;
+static struct tarea_s * actual = NULL;
+static TickType_t tick = 0;
+static uint64_t ticks = 0;
+static bool en_tick = false; // Se está avanzando el tick, por lo que no se puede cambiar de tarea
+static bool en_temporizador = false;
+static uint16_t sondas_temporizadores[PROBES_COUNT];
+static uint64_t costo_temporizadores = 0;
+static uint64_t retomada = 0; // Momento en que la tarea actual retomó su ejecución, en nanosegundos
+static uint8_t interrupciones_anidadas = 0;
+static uint64_t interrupcion_comienzo = 0;
+static uint32_t interrupciones = 0; // Atendidas desde el último aviso al guion
+static uint64_t costo_interrupciones = 0;
+
+/* === Private function implementation ========================================================= */
+
+static void Arrancar(void)
+{
+    retomada = Nanosegundos();
+    actual->funcion(actual->parametros);
+
+    abort(); // Las tareas de FreeRTOS no deben retornar
+}
+
+static struct tarea_s * CrearTarea(TaskFunction_t funcion, const char * nombre, uint32_t palabras, void * parametros,
+                                   UBaseType_t prioridad, StackType_t * pila)
+{
+    struct tarea_s * tarea;
+
+    if (!pila || (tareas_creadas == TAREAS_MAXIMO))
+    {
+        return NULL;
+    }
+
+    tarea = &tareas[tareas_creadas++];
+    tarea->funcion = funcion;
+    tarea->parametros = parametros;
+    tarea->nombre = nombre;
+    tarea->prioridad = prioridad;
+    tarea->pila = pila;
+    tarea->palabras = palabras;
+    tarea->lista = true;
+    tarea->con_limite = false;
+    tarea->liberacion = 0;
+
+    memset(pila, RELLENO_PILA, palabras * sizeof(StackType_t));
+    PrepararContexto(tarea);
+
+    return tarea;
+}
+
+static void PrepararContexto(struct tarea_s * tarea)
+{
+    getcontext(&tarea->contexto);
+    tarea->contexto.uc_stack.ss_sp = tarea->pila;
+    tarea->contexto.uc_stack.ss_size = tarea->palabras * sizeof(StackType_t);
+    tarea->contexto.uc_link = NULL;
+    makecontext(&tarea->contexto, Arrancar, 0);
+
+    return;
+}
+
+static struct cola_s * CrearCola(UBaseType_t largo, UBaseType_t tamanio, uint8_t * datos)
+{
+    struct cola_s * cola;
+
+    if (!datos || (colas_creadas == COLAS_MAXIMO))
+    {
+        return NULL;
+    }
+
+    cola = &colas[colas_creadas++];
+    cola->datos = datos;
+    cola->largo = largo;
+    cola->tamanio = tamanio;
+    cola->cantidad = 0;
+    cola->lectura = 0;
+    cola->receptor = NULL;
+
+    return cola;
+}
+
+static struct temporizador_s * CrearTemporizador(TickType_t periodo, bool repetir, void * identificador,
+                                                  TimerCallbackFunction_t funcion)
+{
+    struct temporizador_s * temporizador;
+
+    if (temporizadores_creados == TEMPORIZADORES_MAXIMO)
+    {
+        return NULL;
+    }
+
+    temporizador = &temporizadores[temporizadores_creados++];
+    temporizador->funcion = funcion;
+    temporizador->identificador = identificador;
+    temporizador->periodo = periodo;
+    temporizador->repetir = repetir;
+    temporizador->activo = false;
+
+    return temporizador;
+}
+
+static void * Reservar(size_t tamanio)
+{
+    if (heap_reservado + tamanio > configTOTAL_HEAP_SIZE)
+    {
+        return NULL;
+    }
+
+    heap_reservado += tamanio;
+
+    return malloc(tamanio);
+}
+
+static struct tarea_s * Elegir(void)
+{
+    struct tarea_s * elegida = NULL;
+
+    for (uint8_t indice = 0; indice < tareas_creadas; indice++)
+    {
+        if (tareas[indice].lista && (!elegida || (tareas[indice].prioridad > elegida->prioridad)))
+        {
+            elegida = &tareas[indice];
+        }
+    }
+
+    return elegida;
+}
+
+static void AvanzarTick(void)
+{
+    bool vencidos = false;
+
+    en_tick = true;
+    tick++;
+    ticks++;
+#if (configUSE_TICK_HOOK == 1)
+    vApplicationTickHook(); // Como en FreeRTOS, antes de que corran los temporizadores
+#endif
+    SimulatorHardwareTick(); // Las interrupciones de los periféricos, antes que los temporizadores por software
+
+    en_temporizador = true;
+    for (uint8_t indice = 0; indice < temporizadores_creados; indice++)
+    {
+        struct temporizador_s * temporizador = &temporizadores[indice];
+
+        if (temporizador->activo && (temporizador->vencimiento == tick))
+        {
+            uint64_t comienzo = Nanosegundos();
+
+            temporizador->activo = temporizador->repetir;
+            temporizador->vencimiento += temporizador->periodo;
+            temporizador->funcion(temporizador);
+            costo_temporizadores += Nanosegundos() - comienzo;
+            vencidos = true;
+        }
+    }
+    en_temporizador = false;
+    if (vencidos)
+    {
+        VirtualJob(TAREA_TEMPORIZADORES, ticks, costo_temporizadores, sondas_temporizadores);
+        memset(sondas_temporizadores, 0, sizeof(sondas_temporizadores));
+        costo_temporizadores = 0;
+    }
+
+    if (interrupciones)
+    {
+        VirtualInterrupts(interrupciones, costo_interrupciones);
+        interrupciones = 0;
+        costo_interrupciones = 0;
+    }
+
+    VirtualTick(ticks);
+
+    for (uint8_t indice = 0; indice < tareas_creadas; indice++)
+    {
+        if (tareas[indice].con_limite && (tareas[indice].despertar == tick))
+        {
+            tareas[indice].con_limite = false;
+            tareas[indice].lista = true;
+            tareas[indice].liberacion = ticks;
+        }
+    }
+    en_tick = false;
+
+    return;
+}
+
+static void Cambiar(struct tarea_s * siguiente)
+{
+    struct tarea_s * anterior = actual;
+
+    if (siguiente != anterior)
+    {
+        actual = siguiente;
+        swapcontext(&anterior->contexto, &siguiente->contexto);
+    }
+    retomada = Nanosegundos();
+
+    return;
+}
+
+static void Bloquear(TickType_t espera)
+{
+    struct tarea_s * siguiente;
+
+    Cobrar();
+    VirtualJob(actual->nombre, actual->liberacion, actual->costo, actual->sondas);
+    memset(actual->sondas, 0, sizeof(actual->sondas));
+    actual->costo = 0;
+
+    actual->lista = false;
+    actual->con_limite = (espera != portMAX_DELAY);
+    actual->despertar = tick + espera;
+
+    while (!(siguiente = Elegir()))
+    {
+        AvanzarTick();
+    }
+    Cambiar(siguiente);
+
+    return;
+}
+
+static struct tarea_s * Agregar(struct cola_s * cola, const void * elemento, bool * agregado)
+{
+    struct tarea_s * receptor = cola->receptor;
+
+    *agregado = (cola->cantidad < cola->largo);
+    if (!*agregado)
+    {
+        return NULL;
+    }
+
+    memcpy(cola->datos + ((cola->lectura + cola->cantidad) % cola->largo) * cola->tamanio, elemento, cola->tamanio);
+    cola->cantidad++;
+
+    if (receptor)
+    {
+        cola->receptor = NULL;
+        receptor->con_limite = false;
+        receptor->lista = true;
+        receptor->liberacion = ticks;
+    }
+
+    return receptor;
+}
+
+static void Cobrar(void)
+{
+    actual->costo += Nanosegundos() - retomada;
+
+    return;
+}
+
+static uint64_t Nanosegundos(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+
+    return (uint64_t)ahora.tv_sec * 1000000000 + ahora.tv_nsec;
+}
+
+/* === Public function implementation ========================================================== */
+
+uint64_t VirtualTicks(void)
+{
+    return ticks;
+}
+
+void VirtualInterruptEnter(void)
+{
+    interrupciones++;
+    if (interrupciones_anidadas++ == 0)
+    {
+        interrupcion_comienzo = Nanosegundos();
+    }
+
+    return;
+}
+
+void VirtualInterruptExit(void)
+{
+    uint64_t costo;
+
+    if (--interrupciones_anidadas)
+    {
+        return;
+    }
+
+    costo = Nanosegundos() - interrupcion_comienzo;
+    costo_interrupciones += costo;
+
+    // Se descuenta del trabajo que la pidió, como el fin de transferencia del DMA al enviar, que sí la incluye
+    if (en_temporizador)
+    {
+        costo_temporizadores -= costo;
+    }
+    else if (!en_tick && actual)
+    {
+        actual->costo -= costo; // Cobrar suma después el tramo entero, con la interrupción adentro
+    }
+
+    return;
+}
+
+void VirtualProbe(probe_t probe)
+{
+    // Las sondas de las interrupciones no son de ningún trabajo, respuesta.py cuenta cada una con su costo fijo
+    if (interrupciones_anidadas)
+    {
+        return;
+    }
+
+    if (en_temporizador)
+    {
+        sondas_temporizadores[probe]++;
+    }
+    else if (actual)
+    {
+        actual->sondas[probe]++;
+    }
+
+    return;
+}
+
+#if (VIRTUAL_TIME == 1)
+uint32_t ProbeTimestamp(void)
+{
+    // Las sondas y el monitor de período ven un milisegundo exacto por tick, sin depender de la computadora
+    return (uint32_t)(ticks * (PROBE_TIMESTAMP_HZ / configTICK_RATE_HZ));
+}
+#endif
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return configTOTAL_HEAP_SIZE - heap_reservado;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName, const uint16_t usStackDepth,
+                       void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    TaskHandle_t tarea = CrearTarea(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+                                    Reservar(usStackDepth * sizeof(StackType_t)));
+
+    if (pxCreatedTask)
+    {
+        *pxCreatedTask = tarea;
+    }
+
+    return tarea ? pdPASS : pdFAIL;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth,
+                               void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer,
+                               StaticTask_t * const pxTaskBuffer)
+{
+    (void)pxTaskBuffer;
+
+    return CrearTarea(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer);
+}
+
+void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+    TickType_t despertar = *pxPreviousWakeTime + xTimeIncrement;
+    bool bloquear;
+
+    // Igual que FreeRTOS: la espera es válida si el tick no pasó el momento de despertar, aun con desborde
+    if (tick < *pxPreviousWakeTime)
+    {
+        bloquear = (despertar < *pxPreviousWakeTime) && (despertar > tick);
+    }
+    else
+    {
+        bloquear = (despertar < *pxPreviousWakeTime) || (despertar > tick);
+    }
+
+    *pxPreviousWakeTime = despertar;
+    if (bloquear)
+    {
+        Bloquear(despertar - tick);
+    }
+
+    return;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    if (xTicksToDelay)
+    {
+        Bloquear(xTicksToDelay);
+    }
+
+    return;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return tick;
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return tick;
+}
+
+void vTaskStartScheduler(void)
+{
+    struct tarea_s * primera = Elegir();
+
+    if (primera)
+    {
+        actual = primera;
+        swapcontext(&inicio, &primera->contexto);
+    }
+
+    return;
+}
+
+void vTaskSuspendAll(void)
+{
+    return;
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t * const pulTotalRunTime)
+{
+    UBaseType_t cantidad = 0;
+
+    for (uint8_t indice = 0; (indice < tareas_creadas) && (cantidad < uxArraySize); indice++, cantidad++)
+    {
+        const uint8_t * pila = (const uint8_t *)tareas[indice].pila;
+        size_t libres = 0;
+
+        // Las pilas crecen hacia las direcciones bajas, lo que nunca se usó conserva el relleno
+        while ((libres < tareas[indice].palabras * sizeof(StackType_t)) && (pila[libres] == RELLENO_PILA))
+        {
+            libres++;
+        }
+
+        pxTaskStatusArray[cantidad].xHandle = &tareas[indice];
+        pxTaskStatusArray[cantidad].pcTaskName = tareas[indice].nombre;
+        pxTaskStatusArray[cantidad].uxCurrentPriority = tareas[indice].prioridad;
+        pxTaskStatusArray[cantidad].ulRunTimeCounter = 0;
+        pxTaskStatusArray[cantidad].usStackHighWaterMark = libres / sizeof(StackType_t);
+    }
+
+    if (pulTotalRunTime)
+    {
+        *pulTotalRunTime = 0;
+    }
+
+    return cantidad;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandle(void)
+{
+    return NULL;
+}
+
+QueueHandle_t xQueueCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize)
+{
+    return CrearCola(uxQueueLength, uxItemSize, Reservar(uxQueueLength * uxItemSize));
+}
+
+QueueHandle_t xQueueCreateStatic(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                 uint8_t * pucQueueStorage, StaticQueue_t * pxStaticQueue)
+{
+    (void)pxStaticQueue;
+
+    return CrearCola(uxQueueLength, uxItemSize, pucQueueStorage);
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait)
+{
+    bool agregado;
+    struct tarea_s * receptor = Agregar(xQueue, pvItemToQueue, &agregado);
+
+    (void)xTicksToWait;
+
+    // Una tarea de mayor prioridad se ejecuta en el momento, salvo que el envío venga de un temporizador
+    if (receptor && !en_tick && actual && (receptor->prioridad > actual->prioridad))
+    {
+        Cobrar();
+        Cambiar(receptor);
+    }
+
+    return agregado ? pdTRUE : errQUEUE_FULL;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                             BaseType_t * const pxHigherPriorityTaskWoken)
+{
+    bool agregado;
+    struct tarea_s * receptor = Agregar(xQueue, pvItemToQueue, &agregado);
+
+    if (pxHigherPriorityTaskWoken && receptor && actual && (receptor->prioridad > actual->prioridad))
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+
+    return agregado ? pdTRUE : errQUEUE_FULL;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait)
+{
+    if ((xQueue->cantidad == 0) && xTicksToWait)
+    {
+        xQueue->receptor = actual;
+        Bloquear(xTicksToWait);
+        xQueue->receptor = NULL;
+    }
+
+    if (xQueue->cantidad == 0) // Venció el tiempo de espera
+    {
+        return pdFALSE;
+    }
+
+    memcpy(pvBuffer, xQueue->datos + xQueue->lectura * xQueue->tamanio, xQueue->tamanio);
+    xQueue->lectura = (xQueue->lectura + 1) % xQueue->largo;
+    xQueue->cantidad--;
+
+    return pdTRUE;
+}
+
+TimerHandle_t xTimerCreate(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                           const UBaseType_t uxAutoReload, void * const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction)
+{
+    (void)pcTimerName;
+
+    return CrearTemporizador(xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction);
+}
+
+TimerHandle_t xTimerCreateStatic(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                 const UBaseType_t uxAutoReload, void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction, StaticTimer_t * pxTimerBuffer)
+{
+    (void)pxTimerBuffer;
+
+    return xTimerCreate(pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction);
+}
+
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+
+    if (!xTimer)
+    {
+        return pdFAIL;
+    }
+
+    xTimer->activo = true;
+    xTimer->vencimiento = tick + xTimer->periodo;
+
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+
+    if (!xTimer)
+    {
+        return pdFAIL;
+    }
+
+    xTimer->activo = false;
+
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait)
+{
+    if (!xTimer || !xNewPeriod)
+    {
+        return pdFAIL;
+    }
+
+    // Como en FreeRTOS, el temporizador arranca con el nuevo período aunque estuviera detenido
+    xTimer->periodo = xNewPeriod;
+
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+void * pvTimerGetTimerID(const TimerHandle_t xTimer)
+{
+    return xTimer->identificador;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
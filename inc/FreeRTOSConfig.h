@@ -42,30 +42,79 @@
 
 /* clang-format off */
 
+/* With STATIC_ALLOCATION set to 1 every task, queue and timer is created with the
+ * *Static API from buffers sized at compile time and the FreeRTOS heap is dropped,
+ * so the whole RAM footprint is known at link time. No heap_x.c file may be linked
+ * in this mode. */
+#ifndef STATIC_ALLOCATION
+#define STATIC_ALLOCATION 0
+#endif
+
+#if (STATIC_ALLOCATION == 1)
+#define configSUPPORT_STATIC_ALLOCATION  1
+#define configSUPPORT_DYNAMIC_ALLOCATION 0
+#define configTOTAL_HEAP_SIZE            ((size_t)0)
+#else
 #define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE            ((size_t)(16 * 1024)) /* 16 Kbytes. */
+#endif
+#endif
+
+/* With RUN_TIME_STATS set to 1 the kernel measures the run time of every task in
+ * microseconds of TIMER3 and counts context switches, see estadisticas.h. */
+#ifndef RUN_TIME_STATS
+#define RUN_TIME_STATS 0
+#endif
+
+#if (RUN_TIME_STATS == 1)
+void CpuStatsTimerInit(void);
+uint32_t CpuStatsTimerRead(void);
+void CpuStatsSwitchedIn(void * task);
+
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() CpuStatsTimerInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         CpuStatsTimerRead()
+#define traceTASK_SWITCHED_IN()                  CpuStatsSwitchedIn(pxCurrentTCB)
+#endif
+
+/* The uptime of tiempo.h advances one tick at a time in the tick hook, and by the
+ * ticks that tickless idle suppressed when the kernel steps the tick count. */
+void UptimeAdvance(uint32_t milliseconds);
+
+#define traceINCREASE_TICK_COUNT(x) UptimeAdvance((x) * (1000 / configTICK_RATE_HZ))
+
+/* With LOW_POWER set to 1 the idle task sleeps with WFI, the RTOS tick is
+ * suppressed while no task has a pending deadline and the display scan stops
+ * while the display is off, waking only once per second. */
+#ifndef LOW_POWER
+#define LOW_POWER 0
+#endif
 
 #define configUSE_PREEMPTION             1
-#define configUSE_IDLE_HOOK              0
-#define configUSE_TICKLESS_IDLE          0
-#define configUSE_TICK_HOOK              0
+#define configUSE_IDLE_HOOK              LOW_POWER
+#define configUSE_TICKLESS_IDLE          LOW_POWER
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#define configUSE_TICK_HOOK              1
 #define configCPU_CLOCK_HZ               (SystemCoreClock)
 #define configTICK_RATE_HZ               ((TickType_t)1000) // 1000 ticks per second => 1ms tick rate
 #define configMAX_PRIORITIES             (15)
+#ifndef configMINIMAL_STACK_SIZE
 #define configMINIMAL_STACK_SIZE         ((uint16_t)128)
+#endif
 #define configAPPLICATION_ALLOCATED_HEAP 0
-#define configTOTAL_HEAP_SIZE            ((size_t)(16 * 1024)) /* 16 Kbytes. */
 #define configMAX_TASK_NAME_LEN          (16)
 #define configUSE_TRACE_FACILITY         1
 #define configUSE_16_BIT_TICKS           0
 #define configIDLE_SHOULD_YIELD          1
 #define configUSE_MUTEXES                1
 #define configQUEUE_REGISTRY_SIZE        8
-#define configCHECK_FOR_STACK_OVERFLOW   0
+#define configCHECK_FOR_STACK_OVERFLOW   2
 #define configUSE_RECURSIVE_MUTEXES      1
 #define configUSE_MALLOC_FAILED_HOOK     0
 #define configUSE_APPLICATION_TASK_TAG   0
 #define configUSE_COUNTING_SEMAPHORES    1
-#define configGENERATE_RUN_TIME_STATS    0
+#define configGENERATE_RUN_TIME_STATS    RUN_TIME_STATS
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
@@ -74,21 +123,28 @@
 /* Software timer definitions. */
 #define configUSE_TIMERS             1
 #define configTIMER_TASK_PRIORITY    (configMAX_PRIORITIES - 3)
+/* Only the main task sends timer commands, and the timer task has a higher priority,
+ * so each command is handled before the next one is sent. Before the scheduler starts
+ * the telemetry and console timers queue at most two starts. A command sent without
+ * waiting can therefore never find the queue full; ArmarPlazo and DesarmarPlazo in
+ * main.c assert it. */
 #define configTIMER_QUEUE_LENGTH     10
 #define configTIMER_TASK_STACK_DEPTH (configMINIMAL_STACK_SIZE * 4)
 
 /* Set the following definitions to 1 to include the API function, or zero
  * to exclude the API function. */
-#define INCLUDE_vTaskPrioritySet         1
-#define INCLUDE_uxTaskPriorityGet        1
-#define INCLUDE_vTaskDelete              1
-#define INCLUDE_vTaskCleanUpResources    0
-#define INCLUDE_vTaskSuspend             1
-#define INCLUDE_vTaskDelayUntil          1
-#define INCLUDE_vTaskDelay               1
-#define INCLUDE_xTaskGetSchedulerState   1
-#define INCLUDE_xTimerPendFunctionCall   1
-#define INCLUDE_xSemaphoreGetMutexHolder 1
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskCleanUpResources       0
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_vTaskDelayUntil             1
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTimerPendFunctionCall      1
+#define INCLUDE_xSemaphoreGetMutexHolder    1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -0,0 +1,162 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef AJUSTES_H
+#define AJUSTES_H
+
+/** \brief Ajustes persistentes
+ **
+ ** Guarda la alarma y la configuración en un diario de registros de tamaño fijo sobre una región de memoria no volátil,
+ ** de modo que se recuperan después de un corte de energía. Cada cambio agrega un registro con un número de secuencia,
+ ** la versión del formato y un CRC; nunca se reescribe el último registro válido. Los registros se reparten entre las
+ ** páginas en forma circular, un registro por página en cada vuelta, para que el desgaste sea parejo y para que dos
+ ** registros consecutivos no compartan página: si un corte interrumpe la programación de una página, el registro
+ ** anterior sigue intacto en otra.
+ **
+ ** Al arrancar se recorre la región una sola vez y se toma el registro válido con la mayor secuencia; los registros de
+ ** una versión posterior a SETTINGS_VERSION se ignoran. Un registro lleva el largo de los datos, por lo que una
+ ** versión nueva puede agregar campos al final y seguir leyendo los registros anteriores.
+ **
+ ** Los cambios se guardan con SettingsSave, que solo los anota, y se escriben con SettingsFlush, que no espera a que
+ ** termine la programación: si la memoria sigue ocupada con la escritura anterior, el registro queda pendiente para la
+ ** próxima llamada. Varios cambios entre dos llamadas ocupan un solo registro.
+ **
+ ** \addtogroup ajustes AJUSTES
+ ** \brief Ajustes persistentes en EEPROM
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Con SETTINGS en 1 la alarma y la configuración se guardan en la EEPROM y se restauran al arrancar.
+#ifndef SETTINGS
+#define SETTINGS 1
+#endif
+
+//! Mayor tamaño de página que acepta el diario, en bytes.
+#ifndef SETTINGS_PAGE_SIZE_MAX
+#define SETTINGS_PAGE_SIZE_MAX 128
+#endif
+
+//! Tamaño de un registro del diario en bytes, debe dividir al tamaño de la página.
+#define SETTINGS_RECORD_SIZE 16
+
+//! Versión del formato de los registros que escribe este firmware.
+#define SETTINGS_VERSION 1
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Ajustes que se conservan entre arranques.
+    typedef struct settings_s
+    {
+        uint8_t alarm[6];   //!< Hora de la alarma, un dígito BCD por elemento como en reloj.h.
+        bool alarm_valid;   //!< La alarma fue ajustada.
+        bool alarm_enabled; //!< La alarma está habilitada.
+        bool telemetry;     //!< La telemetría está habilitada.
+    } settings_t;
+
+    //! Función para copiar una página entera de la región.
+    typedef void (*settings_read_t)(uint16_t page, uint32_t * words);
+
+    //! Función para comenzar a programar palabras de una página sin cambiar el resto, false si la memoria está ocupada.
+    typedef bool (*settings_write_t)(uint16_t page, uint16_t offset, const uint32_t * words, uint16_t count);
+
+    //! Estructura con las funciones de bajo nivel de la memoria donde se guarda el diario.
+    typedef struct settings_driver_s
+    {
+        uint16_t pages;         //!< Cantidad de páginas de la región.
+        uint16_t page_size;     //!< Bytes por página, múltiplo de SETTINGS_RECORD_SIZE, hasta SETTINGS_PAGE_SIZE_MAX.
+        settings_read_t Read;   //!< Función para leer una página.
+        settings_write_t Write; //!< Función para escribir un registro, con el desplazamiento en bytes.
+    } const * settings_driver_t; //!< Puntero al controlador de la memoria.
+
+    //! Estado del diario.
+    typedef struct settings_stats_s
+    {
+        uint16_t slots;    //!< Cantidad de registros que caben en la región.
+        uint16_t slot;     //!< Posición del último registro escrito o restaurado.
+        uint32_t sequence; //!< Secuencia del último registro escrito o restaurado, cero si no hay ninguno.
+        uint32_t writes;   //!< Registros escritos desde el arranque.
+        bool pending;      //!< Hay cambios que todavía no se escribieron.
+    } settings_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Configura la memoria donde se guarda el diario, antes de cualquier otra función del módulo.
+     *
+     * @param driver Puntero a la estructura con las funciones de bajo nivel.
+     */
+    void SettingsInit(settings_driver_t driver);
+
+    /**
+     * @brief Busca el último registro válido en una sola pasada por la región.
+     *
+     * @param settings  Puntero donde se guardan los ajustes restaurados, sin cambios si no hay registros válidos.
+     * @return true     Se restauró un registro.
+     * @return false    La región no tiene registros válidos.
+     */
+    bool SettingsRestore(settings_t * settings);
+
+    /**
+     * @brief Anota los ajustes para escribirlos en la próxima llamada a SettingsFlush, si cambiaron.
+     *
+     * @param settings Puntero a los ajustes actuales.
+     */
+    void SettingsSave(const settings_t * settings);
+
+    /**
+     * @brief Comienza a escribir los ajustes pendientes, sin esperar a que termine la programación.
+     *
+     * @return true     No quedan ajustes pendientes.
+     * @return false    La memoria está ocupada, los ajustes siguen pendientes.
+     */
+    bool SettingsFlush(void);
+
+    /**
+     * @brief Consulta el estado del diario.
+     *
+     * @param stats Puntero donde se guarda el estado.
+     */
+    void SettingsGetStats(settings_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* AJUSTES_H */
@@ -32,8 +32,10 @@ SPDX-License-Identifier: MIT
 
 /* === Headers files inclusions ================================================================ */
 
+#include "ajustes.h"
 #include "digital.h"
 #include "pantalla.h"
+#include "reloj.h"
 
 /* === Cabecera C++ ============================================================================ */
 
@@ -42,10 +44,24 @@ extern "C"
 {
 #endif
 
-    /* === Public macros definitions =============================================================== */
+/* === Public macros definitions =============================================================== */
+
+//! Con CLOCK_RTC en 1 la hora la cuenta el RTC del LPC43xx, que sigue con la batería sin alimentación.
+#ifndef CLOCK_RTC
+#define CLOCK_RTC 0
+#endif
 
     /* === Public data type declarations =========================================================== */
 
+    //! Función de callback que se llama en cada interrupción del temporizador de barrido.
+    typedef void (*scan_timer_event_t)(void);
+
+    //! Función de callback que se llama desde la interrupción de flanco de una tecla.
+    typedef void (*keys_event_t)(void);
+
+    //! Función de callback que se llama desde una interrupción de la UART de depuración o de su DMA.
+    typedef void (*serial_event_t)(void);
+
     /**
      * @brief Descriptor de la placa EDU-CIAA-NXP
      *
@@ -55,16 +71,20 @@ extern "C"
      */
     typedef struct board_s
     {
-        digital_input_t ajustar_tiempo; //!< Puntero al descriptor de la entrada tec_f1.
-        digital_input_t ajustar_alarma; //!< Puntero al descriptor de la entrada tec_f2.
-        digital_input_t decrementar;    //!< Puntero al descriptor de la entrada tec_f3.
-        digital_input_t incrementar;    //!< Puntero al descriptor de la entrada tec_f4.
+        digital_input_t ajustar_tiempo; //!< Puntero al descriptor de la entrada tec_f1, NULL con KEY_MATRIX.
+        digital_input_t ajustar_alarma; //!< Puntero al descriptor de la entrada tec_f2, NULL con KEY_MATRIX.
+        digital_input_t decrementar;    //!< Puntero al descriptor de la entrada tec_f3, NULL con KEY_MATRIX.
+        digital_input_t incrementar;    //!< Puntero al descriptor de la entrada tec_f4, NULL con KEY_MATRIX.
         digital_input_t aceptar;        //!< Puntero al descriptor de la entrada tec_acep.
         digital_input_t cancelar;       //!< Puntero al descriptor de la entrada tec_cancel.
 
         digital_output_t buzzer; //!< Puntero al descriptor de la salida led_r.
 
-        display_t display; //!< Puntero al descriptor de la pantalla.
+        display_t display; //!< Puntero al descriptor de la pantalla, con el teclado matricial si KEY_MATRIX es 1.
+
+        settings_driver_t settings; //!< Región de la EEPROM donde se guarda el diario de ajustes.
+
+        clock_source_t clock_source; //!< Fuente de la hora, NULL si el reloj cuenta los tics.
     } const * board_t;
 
     /* === Public variable declarations ============================================================ */
@@ -86,6 +106,112 @@ extern "C"
      * @param ticks Cantidad de ticks por segundo
      */
     void SysTick_Init(int ticks);
+
+    /**
+     * @brief Función para inicializar el temporizador de barrido
+     *
+     * Usa el RITIMER con la menor prioridad de interrupción, por lo que desde la función de callback se pueden usar
+     * las funciones FromISR de FreeRTOS.
+     *
+     * @param periodo   Período entre interrupciones en milisegundos.
+     * @param callback  Función que se llama en cada interrupción.
+     */
+    void ScanTimer_Init(int periodo, scan_timer_event_t callback);
+
+    /**
+     * @brief Función para cambiar el período del temporizador de barrido
+     *
+     * La cuenta vuelve a empezar, por lo que la próxima interrupción llega un período completo después del cambio.
+     *
+     * @param periodo   Período entre interrupciones en milisegundos.
+     */
+    void ScanTimer_SetPeriod(int periodo);
+
+    /**
+     * @brief Función para consultar el tiempo transcurrido desde la última interrupción del temporizador de barrido
+     *
+     * @return Milisegundos completos desde la última interrupción o desde el último cambio de período.
+     */
+    uint32_t ScanTimer_Elapsed(void);
+
+    /**
+     * @brief Función para avisar los cambios de las teclas con interrupciones
+     *
+     * Asigna a cada tecla con entrada propia un canal de interrupción de terminal que detecta los dos flancos, con la
+     * menor prioridad. La interrupción no lee ni filtra el nivel, solo avisa que hubo un cambio: las teclas se
+     * consultan después con sus descriptores. Debe llamarse después de BoardCreate.
+     *
+     * @param changed   Función que se llama desde la interrupción en cada flanco.
+     */
+    void Keys_Init(keys_event_t changed);
+
+    /**
+     * @brief Función para avisar las teclas del teclado matricial sin barrerlo
+     *
+     * Con KEY_MATRIX en 1 habilita o deshabilita la interrupción por flanco ascendente de las filas, que llama a la
+     * función indicada en Keys_Init. Sirve mientras las columnas quedan activas juntas con DisplayWatchKeys; durante el
+     * barrido cada columna levanta las filas de sus teclas, por lo que se deshabilita. Sin teclado matricial no hace
+     * nada.
+     *
+     * @param watch     Verdadero para avisar las teclas de las filas, falso para dejar de hacerlo.
+     */
+    void Keys_WatchRows(bool watch);
+
+    /**
+     * @brief Función para inicializar la UART de depuración
+     *
+     * La transmisión se hace por DMA, de modo que enviar un bloque no ocupa al procesador más que para programar la
+     * transferencia. La interrupción de fin de transferencia, con la menor prioridad, llama a transmitted con la UART
+     * ya libre, por lo que desde ahí se puede enviar el bloque siguiente sin consultar Serial_Busy periódicamente.
+     *
+     * @param baudrate      Velocidad en bits por segundo.
+     * @param transmitted   Función que se llama al terminar de enviar cada bloque, NULL si no se usa.
+     */
+    void Serial_Init(uint32_t baudrate, serial_event_t transmitted);
+
+    /**
+     * @brief Función para enviar un bloque por la UART de depuración
+     *
+     * El bloque no se copia, por lo que no debe modificarse hasta que Serial_Busy devuelva false. Se puede llamar desde
+     * las tareas y desde las interrupciones: la UART se toma con las interrupciones deshabilitadas.
+     *
+     * @param data  Puntero al bloque a enviar.
+     * @param size  Cantidad de bytes, como máximo 4095.
+     * @return true La transferencia comenzó.
+     * @return false Hay una transferencia en curso y el bloque no se envió.
+     */
+    bool Serial_Send(const uint8_t * data, uint16_t size);
+
+    /**
+     * @brief Función para consultar si hay una transmisión en curso
+     *
+     * @return true La UART está enviando un bloque.
+     * @return false La UART está libre.
+     */
+    bool Serial_Busy(void);
+
+    /**
+     * @brief Función para comenzar la recepción continua por la UART de depuración
+     *
+     * El DMA escribe los bytes recibidos en el buffer en forma circular, sin intervención del procesador. La
+     * interrupción de datos recibidos de la UART, con la menor prioridad, llama a received cuando los bytes ya están
+     * en el buffer, y desde ahí se consulta la posición de escritura con Serial_Received: sin bytes nuevos no hay
+     * interrupciones. Debe llamarse después de Serial_Init.
+     *
+     * @param buffer    Buffer circular de recepción.
+     * @param size      Tamaño del buffer, como máximo 4095 bytes.
+     * @param received  Función que se llama desde la interrupción cada vez que llegan bytes.
+     */
+    void Serial_StartReceive(uint8_t * buffer, uint16_t size, serial_event_t received);
+
+    /**
+     * @brief Función para consultar la posición de escritura del DMA de recepción
+     *
+     * @return uint16_t Índice del buffer donde se escribirá el próximo byte recibido. Al completar una vuelta puede
+     * valer el tamaño del buffer, que equivale a cero.
+     */
+    uint16_t Serial_Received(void);
+
     /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,252 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef CONSOLA_H
+#define CONSOLA_H
+
+/** \brief Consola de comandos de texto
+ **
+ ** Los comandos llegan a un buffer circular que escribe directamente el DMA de la UART. La consola busca los fines
+ ** de línea en el mismo buffer y separa los argumentos como posiciones dentro de él, sin copiar la línea, de modo que
+ ** los comandos se atienden con un recorrido de los bytes recibidos y sin interrupciones por carácter.
+ **
+ ** Las respuestas se escriben en un buffer propio que la aplicación envía cuando la UART queda libre. Cada respuesta
+ ** termina con el indicador "> " y un byte cero, que las terminales ignoran y que marca el final de la respuesta para
+ ** las herramientas. Como el texto no contiene otros ceros, el decodificador de telemetría lo descarta como una trama
+ ** inválida cuando la consola y la telemetría comparten la UART.
+ **
+ ** La consola atiende una línea por vez: las siguientes esperan en el buffer de recepción hasta que se envía la
+ ** respuesta anterior, por lo que quien envía comandos seguidos debe esperar cada respuesta.
+ **
+ ** \addtogroup consola CONSOLA
+ ** \brief Consola de comandos por la UART de depuración
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Con CONSOLE en 1 el equipo atiende comandos de texto por la UART de depuración.
+#ifndef CONSOLE
+#define CONSOLE 1
+#endif
+
+//! Tamaño del buffer circular de recepción, debe ser una potencia de dos menor que 4096.
+#ifndef CONSOLE_RX_SIZE
+#define CONSOLE_RX_SIZE 256
+#endif
+
+//! Tamaño del buffer de respuesta.
+#ifndef CONSOLE_TX_SIZE
+#define CONSOLE_TX_SIZE 512
+#endif
+
+//! Largo máximo de una línea, las más largas se descartan.
+#define CONSOLE_MAX_LINE 80
+
+//! Cantidad máxima de argumentos de un comando, sin contar el nombre.
+#define CONSOLE_MAX_ARGUMENTS 4
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Referencia a la consola.
+    typedef struct console_s * console_t;
+
+    //! Argumento de un comando, ubicado dentro del buffer de recepción.
+    typedef struct console_argument_s
+    {
+        uint16_t start; //!< Posición del primer carácter, sin reducir al tamaño del buffer.
+        uint8_t length; //!< Cantidad de caracteres.
+    } console_argument_t;
+
+    /**
+     * @brief Función que atiende un comando.
+     *
+     * @param console   Consola donde se escribe la respuesta.
+     * @param count     Cantidad de argumentos.
+     * @param arguments Argumentos del comando, sin el nombre.
+     */
+    typedef void (*console_handler_t)(console_t console, uint8_t count, const console_argument_t * arguments);
+
+    //! Descripción de un comando.
+    typedef struct console_command_s
+    {
+        const char * name;         //!< Nombre del comando.
+        const char * help;         //!< Uso del comando, se muestra con el comando ayuda.
+        console_handler_t handler; //!< Función que lo atiende.
+    } console_command_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Crea la consola.
+     *
+     * Además de los comandos de la aplicación la consola atiende el comando ayuda, que lista los demás.
+     *
+     * @param commands  Tabla de comandos, debe existir mientras se use la consola.
+     * @param count     Cantidad de comandos.
+     * @return console_t Referencia a la consola.
+     */
+    console_t ConsoleCreate(const console_command_t * commands, uint8_t count);
+
+    /**
+     * @brief Devuelve el buffer circular de recepción, para que lo escriba el DMA de la UART.
+     *
+     * @param console   Consola.
+     * @param size      Puntero donde se devuelve el tamaño del buffer.
+     * @return uint8_t* Buffer de recepción.
+     */
+    uint8_t * ConsoleGetReceiveBuffer(console_t console, uint16_t * size);
+
+    /**
+     * @brief Informa la posición de escritura del buffer de recepción y busca una línea completa.
+     *
+     * Solo revisa los bytes nuevos desde la llamada anterior, por lo que se puede llamar desde la interrupción de la
+     * UART en cada byte. Una línea que supera CONSOLE_MAX_LINE se descarta y deja preparada una respuesta de error.
+     * Mientras una línea o su respuesta están en curso no revisa nada: las líneas que llegan mientras tanto se
+     * encuentran en la primera llamada después de ConsoleTransmitted.
+     *
+     * @param console   Consola.
+     * @param position  Índice del buffer donde se escribirá el próximo byte recibido.
+     * @return true Encontró una línea completa, que espera a ConsoleProcess.
+     * @return false No hay líneas nuevas o la anterior todavía no terminó de responderse.
+     */
+    bool ConsoleReceive(console_t console, uint16_t position);
+
+    /**
+     * @brief Ejecuta el comando de la línea completa y prepara la respuesta.
+     *
+     * No hace nada si no hay una línea esperando, por lo que se puede llamar de más.
+     *
+     * @param console   Consola.
+     */
+    void ConsoleProcess(console_t console);
+
+    /**
+     * @brief Entrega la respuesta preparada para enviarla.
+     *
+     * El buffer devuelto no se modifica hasta que se llama a ConsoleTransmitted.
+     *
+     * @param console   Consola.
+     * @param data      Puntero donde se devuelve el comienzo de la respuesta.
+     * @return uint16_t Cantidad de bytes a enviar, cero si no hay una respuesta preparada.
+     */
+    uint16_t ConsoleTransmit(console_t console, const uint8_t ** data);
+
+    /**
+     * @brief Informa que terminó el envío de la respuesta entregada por ConsoleTransmit.
+     *
+     * @param console   Consola.
+     */
+    void ConsoleTransmitted(console_t console);
+
+    /**
+     * @brief Indica si la consola espera una línea nueva, sin una línea ni una respuesta en curso.
+     *
+     * @param console   Consola.
+     * @return true Terminó de enviarse la respuesta a la última línea.
+     * @return false Hay una línea esperando a ConsoleProcess o una respuesta sin enviar o enviándose.
+     */
+    bool ConsoleIdle(console_t console);
+
+    /**
+     * @brief Compara un argumento con un texto.
+     *
+     * @param console   Consola.
+     * @param argument  Argumento.
+     * @param text      Texto terminado en cero.
+     * @return true El argumento es igual al texto.
+     * @return false El argumento es distinto.
+     */
+    bool ConsoleArgumentIs(console_t console, const console_argument_t * argument, const char * text);
+
+    /**
+     * @brief Convierte un argumento en un número decimal sin signo.
+     *
+     * @param console   Consola.
+     * @param argument  Argumento.
+     * @param value     Puntero donde se guarda el número.
+     * @return true El argumento es un número que entra en 32 bits.
+     * @return false El argumento tiene caracteres que no son dígitos o el número es demasiado grande.
+     */
+    bool ConsoleArgumentNumber(console_t console, const console_argument_t * argument, uint32_t * value);
+
+    /**
+     * @brief Convierte un argumento en dígitos BCD, uno por byte, ignorando los separadores ':'.
+     *
+     * @param console   Consola.
+     * @param argument  Argumento, por ejemplo "07:30".
+     * @param digits    Vector donde se guardan los dígitos.
+     * @param size      Tamaño del vector.
+     * @return uint8_t Cantidad de dígitos, cero si hay otros caracteres o más dígitos que lugar.
+     */
+    uint8_t ConsoleArgumentDigits(console_t console, const console_argument_t * argument, uint8_t * digits,
+                                  uint8_t size);
+
+    /**
+     * @brief Agrega un texto a la respuesta, cada '\n' se envía como "\r\n".
+     *
+     * Si la respuesta no entra en el buffer se trunca y termina con "...".
+     *
+     * @param console   Consola.
+     * @param text      Texto terminado en cero.
+     */
+    void ConsoleWrite(console_t console, const char * text);
+
+    /**
+     * @brief Agrega un número sin signo a la respuesta.
+     *
+     * @param console   Consola.
+     * @param value     Número.
+     * @param decimals  Cantidad de dígitos que se muestran después del punto decimal, por ejemplo 1 para décimas, menor que 10.
+     */
+    void ConsoleWriteNumber(console_t console, uint32_t value, uint8_t decimals);
+
+    /**
+     * @brief Agrega dígitos BCD a la respuesta, separando los pares con ':' como en una hora.
+     *
+     * @param console   Consola.
+     * @param digits    Dígitos, uno por byte.
+     * @param size      Cantidad de dígitos.
+     */
+    void ConsoleWriteDigits(console_t console, const uint8_t * digits, uint8_t size);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* CONSOLA_H */
@@ -92,6 +92,22 @@ extern "C"
      */
     bool HoraValida(const uint8_t * hora);
 
+    /**
+     * @brief Convierte una hora válida en la cantidad de segundos desde la medianoche.
+     *
+     * @param entrada   Puntero al vector con la hora.
+     * @return uint32_t Segundos desde la medianoche.
+     */
+    uint32_t HoraASegundos(const uint8_t * entrada);
+
+    /**
+     * @brief Convierte una cantidad de segundos desde la medianoche, menor a un día, en una hora.
+     *
+     * @param segundos  Segundos desde la medianoche.
+     * @param entrada   Puntero al vector donde se guarda la hora.
+     */
+    void SegundosAHora(uint32_t segundos, uint8_t * entrada);
+
     /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -32,6 +32,7 @@ SPDX-License-Identifier: MIT
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "pool.h"
 
 /* === Cabecera C++ ============================================================================ */
 
@@ -50,12 +51,46 @@ extern "C"
     //! Puntero al descriptor de cada salida digital.
     typedef struct digital_output_s * digital_output_t;
 
+    //! Puntero al descriptor de cada grupo de salidas digitales.
+    typedef struct digital_group_s * digital_group_t;
+
+    //! Función que entrega el tick actual para marcar los eventos de las entradas.
+    typedef uint32_t (*digital_timebase_t)(void);
+
+    //! Función que recibe cada cambio leído en una entrada, con el nivel del terminal sin invertir.
+    typedef void (*digital_recorder_t)(uint8_t gpio, uint8_t bit, bool level, uint32_t timestamp);
+
+    //! Evento de cambio de una entrada digital.
+    typedef struct digital_event_s
+    {
+        bool active;        //!< Estado de la entrada luego del cambio.
+        uint32_t timestamp; //!< Tick en el que se leyó por primera vez el nuevo estado.
+    } digital_event_t;
+
     /* === Public variable declarations ============================================================ */
 
     /* === Public function declarations ============================================================ */
 
     /*********Entradas**********/
 
+    /**
+     * @brief Fija la base de tiempo usada para marcar los cambios de las entradas.
+     *
+     * Sin base de tiempo todas las marcas valen cero.
+     *
+     * @param function Función que entrega el tick actual, por ejemplo xTaskGetTickCount.
+     */
+    void DigitalSetTimebase(digital_timebase_t function);
+
+    /**
+     * @brief Fija la función que recibe los cambios de las entradas, por ejemplo para grabarlos.
+     *
+     * Se llama en la primera lectura de cada cambio, con la misma marca de tiempo que guarda la entrada.
+     *
+     * @param function Función que recibe los cambios, NULL para no informarlos.
+     */
+    void DigitalSetRecorder(digital_recorder_t function);
+
     /**
      * @brief Crea una entrada digital.
      *
@@ -68,6 +103,15 @@ extern "C"
      */
     digital_input_t DigitalInputCreate(uint8_t gpio, uint8_t bit, bool inverted);
 
+    /**
+     * @brief Destruye una entrada digital.
+     *
+     * Libera el descriptor para que pueda ser utilizado por otra entrada.
+     *
+     * @param input  puntero al descriptor de la entrada.
+     */
+    void DigitalInputDestroy(digital_input_t input);
+
     /**
      * @brief Consulta el estado de la entrada digital.
      *
@@ -77,6 +121,29 @@ extern "C"
      */
     bool DigitalInputGetState(digital_input_t input);
 
+    /**
+     * @brief Consulta el momento del último cambio de la entrada digital.
+     *
+     * Cada lectura de la entrada, por cualquiera de las funciones de consulta, compara el estado con la lectura
+     * anterior y guarda el tick en que se vio el cambio por primera vez.
+     *
+     * @param input  puntero al descriptor de la entrada.
+     * @return uint32_t Tick en el que se leyó por primera vez el estado actual de la entrada.
+     */
+    uint32_t DigitalInputGetTimestamp(digital_input_t input);
+
+    /**
+     * @brief Consulta si hay un evento de cambio en la entrada digital.
+     *
+     * Equivale a DigitalInputHasChanged, pero además informa el nuevo estado y su marca de tiempo.
+     *
+     * @param input  puntero al descriptor de la entrada.
+     * @param event  puntero donde se guarda el evento, solo se modifica si hubo un cambio.
+     * @return true  La entrada cambió desde la última llamada.
+     * @return false La entrada no cambió desde la última llamada.
+     */
+    bool DigitalInputGetEvent(digital_input_t input, digital_event_t * event);
+
     /**
      * @brief Consulta cambios en el estado de una entrada digital.
      *
@@ -118,6 +185,15 @@ extern "C"
      */
     digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool inverted);
 
+    /**
+     * @brief Destruye una salida digital.
+     *
+     * Desactiva la salida y libera el descriptor para que pueda ser utilizado por otra salida.
+     *
+     * @param output Puntero al descriptor de la salida.
+     */
+    void DigitalOutputDestroy(digital_output_t output);
+
     /**
      * @brief Activa una salida.
      *
@@ -139,6 +215,70 @@ extern "C"
      */
     void DigitalOutputToggle(digital_output_t output);
 
+    /*********Grupos de salidas**********/
+
+    /**
+     * @brief Crea un grupo de salidas digitales.
+     *
+     * Las salidas del grupo se manejan con una máscara donde el bit n corresponde a la salida n del vector. Cada
+     * operación sobre el grupo hace una única escritura por cada puerto GPIO involucrado, por lo que las salidas de
+     * un mismo puerto conmutan al mismo tiempo: en SET, CLR o NOT si todas van al mismo nivel, o en MPIN si en un
+     * puerto se mezclan salidas con lógica directa e inversa. Los puertos distintos se escriben uno después del otro.
+     *
+     * El registro MASK que acompaña a MPIN lo usa solo este módulo y se reescribe únicamente cuando cambian los
+     * terminales. La escritura de MASK y la de MPIN se hacen con las interrupciones deshabilitadas, de modo que una
+     * interrupción que opere sobre un grupo del mismo puerto no puede cambiar la máscara entre las dos.
+     *
+     * @param members Vector con los punteros a las salidas que forman el grupo.
+     * @param count   Cantidad de salidas del vector.
+     * @return digital_group_t Puntero al descriptor del grupo creado o NULL si no se pudo crear.
+     */
+    digital_group_t DigitalGroupCreate(const digital_output_t * members, uint8_t count);
+
+    /**
+     * @brief Destruye un grupo de salidas digitales.
+     *
+     * Las salidas que forman el grupo no se modifican.
+     *
+     * @param group Puntero al descriptor del grupo.
+     */
+    void DigitalGroupDestroy(digital_group_t group);
+
+    /**
+     * @brief Activa las salidas del grupo indicadas en la máscara.
+     *
+     * @param group Puntero al descriptor del grupo.
+     * @param mask  Máscara con las salidas a activar.
+     */
+    void DigitalGroupActivate(digital_group_t group, uint32_t mask);
+
+    /**
+     * @brief Desactiva las salidas del grupo indicadas en la máscara.
+     *
+     * @param group Puntero al descriptor del grupo.
+     * @param mask  Máscara con las salidas a desactivar.
+     */
+    void DigitalGroupDeactivate(digital_group_t group, uint32_t mask);
+
+    /**
+     * @brief Invierte el estado de las salidas del grupo indicadas en la máscara.
+     *
+     * @param group Puntero al descriptor del grupo.
+     * @param mask  Máscara con las salidas a invertir.
+     */
+    void DigitalGroupToggle(digital_group_t group, uint32_t mask);
+
+    /*********Estadísticas**********/
+
+    /**
+     * @brief Consulta el uso de los descriptores de entradas, salidas y grupos.
+     *
+     * @param inputs_stats  Puntero donde se guardan las estadísticas de las entradas, puede ser NULL.
+     * @param outputs_stats Puntero donde se guardan las estadísticas de las salidas, puede ser NULL.
+     * @param groups_stats  Puntero donde se guardan las estadísticas de los grupos, puede ser NULL.
+     */
+    void DigitalGetStats(pool_stats_t * inputs_stats, pool_stats_t * outputs_stats, pool_stats_t * groups_stats);
+
     /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,122 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+/** \brief Estadísticas de uso del procesador por tarea
+ **
+ ** Provee la base de tiempo de alta resolución que usa FreeRTOS para medir el tiempo de ejecución de cada tarea y
+ ** cuenta los cambios de contexto. La base de tiempo cuenta microsegundos: en la placa con el TIMER3 y en una
+ ** compilación para la computadora con el reloj monotónico del sistema. Desborda cada 71 minutos.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad máxima de tareas que se informan, incluyendo la tarea inactiva y la de temporizadores.
+#ifndef CPU_STATS_MAX_TASKS
+#define CPU_STATS_MAX_TASKS 8
+#endif
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Uso del procesador de una tarea durante el intervalo informado.
+    typedef struct cpu_task_stats_s
+    {
+        const char * name; //!< Nombre de la tarea.
+        uint16_t load;     //!< Uso del procesador en décimas de porcentaje.
+        uint32_t switches; //!< Cantidad de veces que la tarea recibió el procesador.
+        uint32_t runtime;  //!< Tiempo de ejecución en cuentas de la base de tiempo.
+    } cpu_task_stats_t;
+
+    //! Uso del procesador de todas las tareas durante el intervalo informado.
+    typedef struct cpu_stats_s
+    {
+        uint32_t interval;                          //!< Duración del intervalo en cuentas de la base de tiempo.
+        uint32_t switches;                          //!< Cantidad total de cambios de contexto.
+        uint16_t idle;                              //!< Tiempo en la tarea inactiva en décimas de porcentaje.
+        uint8_t tasks;                              //!< Cantidad de tareas informadas.
+        cpu_task_stats_t task[CPU_STATS_MAX_TASKS]; //!< Uso del procesador de cada tarea.
+    } cpu_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Inicializa la base de tiempo de las estadísticas.
+     *
+     * La llama FreeRTOS al iniciar el planificador mediante portCONFIGURE_TIMER_FOR_RUN_TIME_STATS.
+     */
+    void CpuStatsTimerInit(void);
+
+    /**
+     * @brief Lee la base de tiempo de las estadísticas.
+     *
+     * La llama FreeRTOS en cada cambio de contexto mediante portGET_RUN_TIME_COUNTER_VALUE.
+     *
+     * @return uint32_t Valor actual de la base de tiempo en microsegundos. Desborda en los 32 bits, por lo que las
+     *                  diferencias siempre son válidas.
+     */
+    uint32_t CpuStatsTimerRead(void);
+
+    /**
+     * @brief Cuenta un cambio de contexto hacia una tarea.
+     *
+     * La llama FreeRTOS mediante traceTASK_SWITCHED_IN, por lo que corre con el planificador bloqueado.
+     *
+     * @param task Descriptor de la tarea que recibe el procesador.
+     */
+    void CpuStatsSwitchedIn(void * task);
+
+    /**
+     * @brief Consulta el uso del procesador desde la consulta anterior.
+     *
+     * La primera consulta informa el uso desde el inicio del planificador. Para que los porcentajes sean válidos el
+     * intervalo entre consultas debe ser menor que el período de desborde de la base de tiempo, 71 minutos.
+     *
+     * @param stats Puntero a la estructura donde se guardan las estadísticas.
+     */
+    void CpuStatsGet(cpu_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* ESTADISTICAS_H */
@@ -0,0 +1,128 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef GRABACION_H
+#define GRABACION_H
+
+/** \brief Grabación de los cambios de las entradas digitales
+ **
+ ** Guarda cada cambio de nivel que lee digital.c con el tick en que se vio, para reproducir después la misma secuencia
+ ** de teclas en la simulación en tiempo virtual. Cada cambio ocupa cuatro bytes: los ticks desde el cambio anterior,
+ ** el terminal y el nivel. Los tiempos se cuentan desde el tick cero, de modo que la reproducción empieza en el
+ ** arranque del equipo. La grabación se detiene cuando se llena el buffer, porque sin el principio no se puede
+ ** reproducir el resto.
+ **
+ ** El contenido se extrae con el depurador, por ejemplo `dump binary value grabacion.bin grabacion` en gdb, y se
+ ** reproduce con el comando reproducir de host/virtual/src/guion.c.
+ **
+ ** \addtogroup grabacion GRABACION
+ ** \brief Grabación y reproducción de las entradas
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Con RECORDING en 1 el firmware graba los cambios de las entradas digitales.
+#ifndef RECORDING
+#define RECORDING 0
+#endif
+
+//! Cantidad de cambios que guarda el buffer.
+#ifndef RECORDING_ENTRIES
+#define RECORDING_ENTRIES 256
+#endif
+
+//! Identificador que encabeza el buffer para que el reproductor lo reconozca ("GRB1").
+#define RECORDING_MAGIC 0x31425247
+
+//! Terminal de los registros que solo avanzan el tiempo, cuando entre dos cambios pasan más de 65535 ticks.
+#define RECORDING_PAUSE 0xFF
+
+//! Empaqueta el puerto y el terminal de un registro.
+#define RECORDING_PIN(gpio, bit) ((uint8_t)(((gpio) << 5) | ((bit) & 0x1F)))
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Cambio registrado.
+    typedef struct recording_entry_s
+    {
+        uint16_t delay; //!< Ticks desde el cambio anterior, o desde el tick cero en el primero.
+        uint8_t pin;    //!< Puerto en los 3 bits más significativos y terminal en los 5 restantes.
+        uint8_t level;  //!< Nivel leído en el terminal, sin la inversión de la entrada.
+    } recording_entry_t;
+
+    //! Buffer completo tal como lo lee el reproductor.
+    typedef struct recording_buffer_s
+    {
+        uint32_t magic;                               //!< Identificador del formato, RECORDING_MAGIC.
+        uint16_t capacity;                            //!< Cantidad de registros del buffer.
+        uint16_t entry_size;                          //!< Tamaño de cada registro en bytes.
+        uint32_t written;                             //!< Cantidad de registros guardados.
+        uint32_t dropped;                             //!< Cambios descartados con el buffer lleno.
+        recording_entry_t entries[RECORDING_ENTRIES]; //!< Registros en el orden en que se leyeron.
+    } recording_buffer_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Registra un cambio de nivel de una entrada digital.
+     *
+     * Tiene la forma de digital_recorder_t para conectarla con DigitalSetRecorder. Se llama siempre desde el contexto
+     * que lee las teclas, por lo que no protege el buffer.
+     *
+     * @param gpio      Puerto GPIO de la entrada.
+     * @param bit       Terminal del puerto GPIO.
+     * @param level     Nivel leído en el terminal.
+     * @param timestamp Tick en el que se leyó el cambio.
+     */
+    void RecordingSample(uint8_t gpio, uint8_t bit, bool level, uint32_t timestamp);
+
+    /**
+     * @brief Consulta la posición y el tamaño del buffer completo, con su encabezado, para extraerlo del equipo.
+     *
+     * @param size Puntero donde se guarda el tamaño en bytes.
+     * @return const void* Dirección del buffer.
+     */
+    const void * RecordingGetBuffer(size_t * size);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* GRABACION_H */
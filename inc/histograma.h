@@ -0,0 +1,129 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+/** \brief Histogramas de intervalos fijos para mediciones de tiempo
+ **
+ ** Cada histograma se reserva en tiempo de compilación con la macro HISTOGRAM_DEFINE y guarda, además de los
+ ** intervalos, el mínimo, el máximo y la suma exactos de las muestras.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Define un histograma estático.
+ *
+ * El identificador `nombre` queda declarado como un puntero de tipo histogram_t listo para usar. Las muestras
+ * mayores que `cantidad * ancho` se acumulan en el último intervalo.
+ *
+ * @param nombre    Nombre del histograma.
+ * @param cantidad  Cantidad de intervalos.
+ * @param ancho     Ancho de cada intervalo, en las mismas unidades que las muestras.
+ */
+#define HISTOGRAM_DEFINE(nombre, cantidad, ancho)                                                                      \
+    static uint32_t nombre##_buckets[cantidad];                                                                        \
+    static struct histogram_s nombre[1] = {{                                                                           \
+        .buckets = nombre##_buckets,                                                                                   \
+        .count = (cantidad),                                                                                           \
+        .width = (ancho),                                                                                              \
+        .min = UINT32_MAX,                                                                                             \
+    }}
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Descriptor de un histograma. Se crea únicamente con la macro HISTOGRAM_DEFINE.
+    struct histogram_s
+    {
+        uint32_t * buckets; //!< Cantidad de muestras de cada intervalo.
+        uint16_t count;     //!< Cantidad de intervalos.
+        uint32_t width;     //!< Ancho de cada intervalo.
+        uint32_t samples;   //!< Cantidad total de muestras.
+        uint32_t min;       //!< Menor muestra registrada.
+        uint32_t max;       //!< Mayor muestra registrada.
+        uint64_t sum;       //!< Suma de todas las muestras.
+    };
+
+    //! Puntero al descriptor de un histograma.
+    typedef struct histogram_s * histogram_t;
+
+    //! Resumen estadístico de un histograma.
+    typedef struct histogram_stats_s
+    {
+        uint32_t samples; //!< Cantidad de muestras.
+        uint32_t min;     //!< Menor muestra, cero si no hay muestras.
+        uint32_t mean;    //!< Promedio de las muestras.
+        uint32_t p99;     //!< Mayor valor del intervalo que contiene al percentil 99.
+        uint32_t max;     //!< Mayor muestra.
+    } histogram_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Registra una muestra en el histograma.
+     *
+     * @param histogram Puntero al histograma.
+     * @param value     Valor de la muestra.
+     */
+    void HistogramRecord(histogram_t histogram, uint32_t value);
+
+    /**
+     * @brief Descarta todas las muestras del histograma.
+     *
+     * @param histogram Puntero al histograma.
+     */
+    void HistogramReset(histogram_t histogram);
+
+    /**
+     * @brief Consulta el resumen estadístico del histograma.
+     *
+     * @param histogram Puntero al histograma.
+     * @param stats     Puntero a la estructura donde se guarda el resumen.
+     */
+    void HistogramGetStats(histogram_t histogram, histogram_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* HISTOGRAMA_H */
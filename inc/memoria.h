@@ -0,0 +1,92 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+/** \brief Resumen del uso de memoria RAM
+ **
+ ** Informa en tiempo de ejecución la memoria estática reservada al enlazar, la pila que nunca usó cada tarea y el
+ ** heap libre de FreeRTOS. La pila libre de cada tarea es la marca de agua que FreeRTOS obtiene del patrón con que
+ ** llena la pila al crearla, por lo que es una cota segura para reducir su tamaño.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad máxima de tareas que se informan, incluyendo la tarea inactiva y la de temporizadores.
+#ifndef MEMORY_MAX_TASKS
+#define MEMORY_MAX_TASKS 8
+#endif
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Pila de una tarea.
+    typedef struct memory_task_s
+    {
+        const char * name;   //!< Nombre de la tarea.
+        uint32_t stack_free; //!< Menor cantidad de bytes de pila libres desde que se creó la tarea.
+    } memory_task_t;
+
+    //! Resumen del uso de memoria RAM.
+    typedef struct memory_stats_s
+    {
+        uint32_t data;                        //!< Bytes de variables inicializadas (.data), cero en la computadora.
+        uint32_t bss;                         //!< Bytes de variables sin inicializar (.bss), cero en la computadora.
+        uint32_t heap_size;                   //!< Tamaño del heap de FreeRTOS, cero sin asignación dinámica.
+        uint32_t heap_free;                   //!< Bytes libres del heap de FreeRTOS.
+        uint8_t tasks;                        //!< Cantidad de tareas informadas.
+        memory_task_t task[MEMORY_MAX_TASKS]; //!< Pila de cada tarea.
+    } memory_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Consulta el uso de memoria RAM.
+     *
+     * @param stats Puntero a la estructura donde se guarda el resumen.
+     */
+    void MemoryGetStats(memory_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* MEMORIA_H */
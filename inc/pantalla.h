@@ -31,6 +31,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions ================================================================ */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* === Cabecera C++ ============================================================================ */
 
@@ -58,6 +59,11 @@ extern "C"
 //! Definición de bits del segmento P
 #define SEGMENTO_P (1 << 7)
 
+//! Cantidad de filas del teclado matricial que se leen en cada dígito.
+#ifndef DISPLAY_KEY_ROWS
+#define DISPLAY_KEY_ROWS 4
+#endif
+
     /* === Public data type declarations =========================================================== */
 
     //! Puntero a un descriptor para gestionar la pantalla.
@@ -72,12 +78,19 @@ extern "C"
     //! Función de callback para prender un digito de la pantalla.
     typedef void (*display_digit_on_t)(uint8_t digit);
 
+    //! Función de callback para leer las filas del teclado matricial, un bit por fila activa.
+    typedef uint8_t (*display_keys_read_t)(void);
+
+    //! Función de callback para informar que un cuadro marcado terminó de mostrarse.
+    typedef void (*display_frame_shown_t)(uint32_t timestamp);
+
     //! Estructura con las funciones de bajo nivel para el manejo de la pantalla
     typedef struct display_driver_s
     {
         display_screen_off_t ScreenTurnOff;   //!< Función para apagar los segmentos y los digitos.
         display_segments_on_t SegmentsTurnOn; //!< Función para prender determinados segmentos.
         display_digit_on_t DigitTurnOn;       //!< Función para prender un dígito.
+        display_keys_read_t KeysRead;         //!< Función para leer las filas del teclado, NULL si no se usa.
     } const * const display_driver_t;         //!< Puntero al controlador de la pantalla.
 
     /* === Public variable declarations ============================================================ */
@@ -109,6 +122,17 @@ extern "C"
      */
     void DisplayRefresh(display_t display);
 
+    /**
+     * @brief Función para encender o apagar la pantalla.
+     *
+     * Con la pantalla apagada DisplayRefresh no escribe en el hardware y el contenido se conserva. Si el controlador
+     * tiene teclado las columnas se siguen barriendo con los segmentos apagados, así una tecla puede encenderla.
+     *
+     * @param display   Puntero al descriptor de la pantalla.
+     * @param on        Verdadero para encender la pantalla, falso para apagarla.
+     */
+    void DisplaySetPower(display_t display, bool on);
+
     /**
      * @brief Función para hacer parpadear los dígitos de la pantalla
      *
@@ -127,6 +151,52 @@ extern "C"
      */
     void DisplayToggleDot(display_t display, uint8_t position);
 
+    /**
+     * @brief Función para consultar el teclado matricial barrido junto con la pantalla.
+     *
+     * Las líneas de selección de dígito funcionan como columnas del teclado y las filas se leen al final de cada
+     * ranura de multiplexado, antes de apagar el dígito, por lo que el barrido no agrega tiempo al refresco. La tecla
+     * de la fila f en la columna del dígito d corresponde al bit d * DISPLAY_KEY_ROWS + f del mapa. El primer refresco
+     * no lee las filas porque todavía no hay una columna activa, y el primer barrido completo termina después de un
+     * refresco por dígito.
+     *
+     * @param display   Puntero al descriptor de la pantalla.
+     * @param keys      Puntero donde se guarda el mapa de teclas presionadas del último barrido completo.
+     * @return true     Se completó un barrido nuevo desde la consulta anterior.
+     * @return false    No hay un barrido nuevo o el controlador no tiene teclado.
+     */
+    bool DisplayGetKeys(display_t display, uint32_t * keys);
+
+    /**
+     * @brief Función para dejar todas las columnas del teclado activas juntas, sin barrer la pantalla.
+     *
+     * Apaga los segmentos y enciende todos los dígitos, así cualquier tecla levanta su fila aunque no se llame a
+     * DisplayRefresh. El refresco siguiente apaga las columnas, no lee las filas y sigue el barrido desde el dígito
+     * siguiente. Si el controlador no tiene teclado no hace nada.
+     *
+     * @param display   Puntero al descriptor de la pantalla.
+     */
+    void DisplayWatchKeys(display_t display);
+
+    /**
+     * @brief Función para fijar el aviso de cuadro mostrado.
+     *
+     * @param display   Puntero al descriptor de la pantalla.
+     * @param callback  Función que se llama cuando un cuadro marcado terminó de mostrarse, NULL para desactivarla.
+     */
+    void DisplaySetFrameCallback(display_t display, display_frame_shown_t callback);
+
+    /**
+     * @brief Función para marcar el contenido actual de la pantalla como respuesta a un evento.
+     *
+     * Cuando todos los dígitos se encendieron al menos una vez con el contenido marcado, se llama a la función fijada
+     * con DisplaySetFrameCallback entregando la marca de tiempo. Una marca nueva reemplaza a la anterior pendiente.
+     *
+     * @param display   Puntero al descriptor de la pantalla.
+     * @param timestamp Marca de tiempo del evento que originó el contenido.
+     */
+    void DisplayStampFrame(display_t display, uint32_t timestamp);
+
     /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
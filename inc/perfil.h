@@ -0,0 +1,162 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef PERFIL_H
+#define PERFIL_H
+
+/** \brief Sondas de medición de tiempo de ejecución
+ **
+ ** Las macros PROBE_BEGIN y PROBE_END miden la duración de un bloque de código y la registran en el histograma de la
+ ** sonda. En la placa se usa el contador de ciclos DWT CYCCNT y en la computadora el reloj monotónico en
+ ** nanosegundos, salvo en la simulación en tiempo virtual (VIRTUAL_TIME en 1), donde la base de tiempo la da el núcleo
+ ** simulado a razón de un milisegundo por tick. Si PROFILING no vale 1 las macros no generan código.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include "histograma.h"
+
+#ifndef PROFILING
+#define PROFILING 0
+#endif
+
+#ifndef VIRTUAL_TIME
+#define VIRTUAL_TIME 0
+#endif
+
+#if defined(__arm__)
+#include "chip.h"
+#endif
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad y ancho de los intervalos del histograma de cada sonda, en ciclos o nanosegundos.
+#ifndef PROBE_BUCKETS
+#define PROBE_BUCKETS 64
+#endif
+
+#ifndef PROBE_BUCKET_WIDTH
+#define PROBE_BUCKET_WIDTH 16
+#endif
+
+//! Frecuencia de la base de tiempo de las sondas, en cuentas por segundo.
+#if defined(__arm__)
+#define PROBE_TIMESTAMP_HZ SystemCoreClock
+#else
+#define PROBE_TIMESTAMP_HZ 1000000000UL
+#endif
+
+#if (PROFILING == 1)
+//! Comienza la medición de la sonda indicada, debe cerrarse con PROBE_END en el mismo bloque.
+#define PROBE_BEGIN(probe) const uint32_t probe##_start = ProbeTimestamp()
+//! Termina la medición de la sonda indicada y la registra.
+#define PROBE_END(probe) ProbeRecord(probe, ProbeTimestamp() - probe##_start)
+#else
+#define PROBE_BEGIN(probe)
+#define PROBE_END(probe)
+#endif
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Sondas disponibles, una por cada camino crítico medido.
+    typedef enum
+    {
+        PROBE_DISPLAY_REFRESH,   //!< Refresco de un dígito de la pantalla.
+        PROBE_CLOCK_REFRESH,     //!< Avance de un tick del reloj.
+        PROBE_SECONDS_INCREMENT, //!< Incremento de un segundo en BCD.
+        PROBE_KEY_HANDLING,      //!< Atención de una tecla en la tarea principal.
+        PROBES_COUNT,
+    } probe_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+#if defined(__arm__)
+    /**
+     * @brief Lee la base de tiempo de las sondas, en línea para que la medición cueste pocos ciclos.
+     *
+     * @return uint32_t Ciclos del procesador.
+     */
+    static inline uint32_t ProbeTimestamp(void)
+    {
+        return DWT->CYCCNT;
+    }
+#else
+    /**
+     * @brief Lee la base de tiempo de las sondas. En la computadora se implementa fuera de la cabecera para no incluir
+     * time.h, cuyo clock_t choca con el de reloj.h.
+     *
+     * @return uint32_t Nanosegundos del reloj monotónico.
+     */
+    uint32_t ProbeTimestamp(void);
+#endif
+
+    /**
+     * @brief Habilita la base de tiempo de las sondas y descarta las mediciones anteriores. La base de tiempo se
+     * habilita aunque las sondas estén deshabilitadas, porque también la usan otros módulos de medición.
+     */
+    void ProbesInit(void);
+
+    /**
+     * @brief Registra una medición de una sonda.
+     *
+     * @param probe     Sonda medida.
+     * @param elapsed   Duración medida en ciclos o nanosegundos.
+     */
+    void ProbeRecord(probe_t probe, uint32_t elapsed);
+
+    /**
+     * @brief Consulta el nombre de una sonda.
+     *
+     * @param probe Sonda consultada.
+     * @return const char* Nombre de la sonda.
+     */
+    const char * ProbeName(probe_t probe);
+
+    /**
+     * @brief Consulta el mínimo, promedio, percentil 99 y máximo de una sonda.
+     *
+     * @param probe Sonda consultada.
+     * @param stats Puntero a la estructura donde se guarda el resumen.
+     */
+    void ProbeGetStats(probe_t probe, histogram_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* PERFIL_H */
@@ -0,0 +1,136 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef PERIODO_H
+#define PERIODO_H
+
+/** \brief Monitor de período y fluctuación de tareas periódicas
+ **
+ ** Compara el momento en que se despierta una tarea periódica con el momento en que debería haberlo hecho. Cuenta las
+ ** activaciones retrasadas y las que comenzaron después de su plazo, que es el inicio del período siguiente, y guarda
+ ** el retraso de cada activación en un histograma expresado en milésimas del período. El monitor no depende del
+ ** sistema operativo: el tiempo lo provee quien lo llama, en cualquier unidad, siempre que sea la misma del período.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include "histograma.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Define un monitor de período estático.
+ *
+ * El identificador `nombre` queda declarado como un puntero de tipo period_monitor_t listo para usar.
+ *
+ * @param nombre    Nombre del monitor.
+ * @param cantidad  Cantidad de intervalos del histograma de retrasos.
+ * @param ancho     Ancho de cada intervalo, en milésimas del período.
+ */
+#define PERIOD_MONITOR_DEFINE(nombre, cantidad, ancho)                                                                 \
+    HISTOGRAM_DEFINE(nombre##_retrasos, cantidad, ancho);                                                              \
+    static struct period_monitor_s nombre[1] = {{                                                                      \
+        .jitter = nombre##_retrasos,                                                                                   \
+    }}
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Descriptor de un monitor de período. Se crea únicamente con la macro PERIOD_MONITOR_DEFINE.
+    struct period_monitor_s
+    {
+        histogram_t jitter;    //!< Retraso de cada activación en milésimas del período.
+        uint64_t scale;        //!< Factor para convertir un retraso en milésimas del período, escalado por 2^32.
+        uint32_t period;       //!< Período esperado.
+        uint32_t tolerance;    //!< Retraso a partir del cual una activación se cuenta como retrasada.
+        uint32_t expected;     //!< Momento esperado de la próxima activación.
+        uint32_t activations;  //!< Cantidad de activaciones.
+        uint32_t late;         //!< Activaciones con un retraso mayor o igual que la tolerancia.
+        uint32_t missed;       //!< Activaciones que comenzaron después del inicio del período siguiente.
+        uint32_t max_lateness; //!< Mayor retraso registrado.
+    };
+
+    //! Referencia a un monitor de período.
+    typedef struct period_monitor_s * period_monitor_t;
+
+    //! Resumen de un monitor de período.
+    typedef struct period_stats_s
+    {
+        uint32_t activations;     //!< Cantidad de activaciones.
+        uint32_t late;            //!< Activaciones con un retraso mayor o igual que la tolerancia.
+        uint32_t missed;          //!< Activaciones que comenzaron después del inicio del período siguiente.
+        uint32_t max_lateness;    //!< Mayor retraso, en las unidades del período.
+        histogram_stats_t jitter; //!< Retrasos en milésimas del período.
+    } period_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Inicia el monitor y descarta las mediciones anteriores.
+     *
+     * @param monitor   Monitor de período.
+     * @param period    Período esperado de la tarea.
+     * @param tolerance Retraso a partir del cual una activación se cuenta como retrasada.
+     * @param now       Momento de la primera activación, que fija la fase de las siguientes.
+     */
+    void PeriodMonitorStart(period_monitor_t monitor, uint32_t period, uint32_t tolerance, uint32_t now);
+
+    /**
+     * @brief Registra una activación de la tarea, debe llamarse al despertar en cada período.
+     *
+     * Igual que vTaskDelayUntil, el momento esperado avanza un período por activación, de modo que una tarea atrasada
+     * que recupera el tiempo ejecutando activaciones seguidas sigue contando como atrasada hasta alcanzar su fase.
+     *
+     * @param monitor   Monitor de período.
+     * @param now       Momento actual.
+     * @return uint32_t Cantidad de períodos completos de retraso, cero si la activación llegó antes de su plazo.
+     */
+    uint32_t PeriodMonitorWake(period_monitor_t monitor, uint32_t now);
+
+    /**
+     * @brief Consulta el resumen de un monitor de período.
+     *
+     * @param monitor   Monitor de período.
+     * @param stats     Puntero a la estructura donde se guarda el resumen.
+     */
+    void PeriodMonitorGetStats(period_monitor_t monitor, period_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* PERIODO_H */
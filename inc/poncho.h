@@ -183,6 +183,17 @@ extern "C" {
 #define KEY_CANCEL_GPIO 5
 #define KEY_CANCEL_BIT  8
 
+// Con KEY_MATRIX en 1 las teclas F1 a F4 se reemplazan por un teclado matricial que se barre junto con la pantalla
+#ifndef KEY_MATRIX
+#define KEY_MATRIX 0
+#endif
+
+// Definiciones del teclado matricial: las filas reutilizan las teclas F1 a F4 con resistencias de pull-down y las
+// columnas son las líneas de selección de dígitos de la pantalla
+#define KEY_ROWS_GPIO  5
+#define KEY_ROWS_SHIFT KEY_F1_BIT
+#define KEY_ROWS_MASK  (0x0F << KEY_ROWS_SHIFT)
+
 // Definiciones de los recursos asociados al zumbador
 #define BUZZER_PORT 2
 #define BUZZER_PIN 2
@@ -190,6 +201,36 @@ extern "C" {
 #define BUZZER_GPIO 5
 #define BUZZER_BIT 2
 
+// Definiciones de la UART de depuración, conectada al puerto USB de la placa
+#define SERIAL_UART    LPC_USART2
+#define SERIAL_TX_PORT 7
+#define SERIAL_TX_PIN  1
+#define SERIAL_RX_PORT 7
+#define SERIAL_RX_PIN  2
+#define SERIAL_FUNC    SCU_MODE_FUNC6
+#define SERIAL_DMA_TX  GPDMA_CONN_UART2_Tx
+#define SERIAL_DMA_RX  GPDMA_CONN_UART2_Rx
+#define SERIAL_IRQ     USART2_IRQn
+
+// Atención de la interrupción de la UART de depuración, con el nombre del vector del LPC43xx
+#define SERIAL_IRQHandler UART2_IRQHandler
+
+// Terminales que la placa maneja como entradas y salidas digitales de la HAL, cada uno por el prefijo de sus
+// definiciones. Con el teclado matricial las teclas F1 a F4 son filas del barrido y no tienen descriptor
+#if (KEY_MATRIX == 1)
+#define PONCHO_DIGITAL_INPUT_PINS(PIN) PIN(KEY_ACCEPT) PIN(KEY_CANCEL)
+#else
+#define PONCHO_DIGITAL_INPUT_PINS(PIN) PIN(KEY_F1) PIN(KEY_F2) PIN(KEY_F3) PIN(KEY_F4) PIN(KEY_ACCEPT) PIN(KEY_CANCEL)
+#endif
+#define PONCHO_DIGITAL_OUTPUT_PINS(PIN) PIN(BUZZER)
+
+// Suma uno por terminal de las listas, que no compila si le falta el puerto GPIO o el bit
+#define PONCHO_PIN_COUNT(pin) + (((pin##_GPIO) >= 0) && ((pin##_BIT) >= 0))
+
+// Cantidad de entradas y salidas digitales del poncho, dimensiona los descriptores de la HAL
+#define PONCHO_DIGITAL_INPUTS  (0 PONCHO_DIGITAL_INPUT_PINS(PONCHO_PIN_COUNT))
+#define PONCHO_DIGITAL_OUTPUTS (0 PONCHO_DIGITAL_OUTPUT_PINS(PONCHO_PIN_COUNT))
+
 /* === Public data type declarations =========================================================== */
  
 /* === Public variable declarations ============================================================ */
@@ -0,0 +1,143 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef POOL_H
+#define POOL_H
+
+/** \brief Pool estático de descriptores
+ **
+ ** Reserva en tiempo de compilación un arreglo de descriptores y administra su uso con un mapa de bits, de modo que
+ ** asignar y liberar un descriptor tiene un costo constante.
+ **
+ ** Las funciones no son reentrantes y no usan secciones críticas: los descriptores se crean y se destruyen al
+ ** inicializar la placa, antes de arrancar el planificador. Un pool que se use desde varias tareas tiene que
+ ** protegerse por fuera.
+ **
+ ** \addtogroup hal HAL
+ ** \brief Capa de abstracción de hardware
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad de palabras de 32 bits necesarias para el mapa de bits de un pool.
+#define POOL_BITMAP_WORDS(cantidad) (((cantidad) + 31) / 32)
+
+/**
+ * @brief Define un pool estático con su almacenamiento.
+ *
+ * El identificador `nombre` queda declarado como un puntero de tipo pool_t listo para usar.
+ *
+ * @param nombre    Nombre del pool.
+ * @param tipo      Tipo de los elementos almacenados.
+ * @param cantidad  Cantidad de elementos del pool.
+ */
+#define POOL_DEFINE(nombre, tipo, cantidad)                                                                            \
+    static tipo nombre##_items[cantidad];                                                                              \
+    static uint32_t nombre##_bitmap[POOL_BITMAP_WORDS(cantidad)];                                                      \
+    static struct pool_s nombre[1] = {{                                                                                \
+        .items = nombre##_items,                                                                                       \
+        .bitmap = nombre##_bitmap,                                                                                     \
+        .item_size = sizeof(tipo),                                                                                     \
+        .capacity = (cantidad),                                                                                        \
+    }}
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Descriptor de un pool estático. Se crea únicamente con la macro POOL_DEFINE.
+    struct pool_s
+    {
+        void * items;       //!< Arreglo con los elementos del pool.
+        uint32_t * bitmap;  //!< Mapa de bits con los elementos en uso.
+        uint16_t item_size; //!< Tamaño en bytes de cada elemento.
+        uint16_t capacity;  //!< Cantidad de elementos del pool.
+        uint16_t used;      //!< Cantidad de elementos en uso.
+        uint16_t peak;      //!< Máxima cantidad de elementos en uso registrada.
+        uint16_t failures;  //!< Cantidad de pedidos rechazados por falta de elementos.
+    };
+
+    //! Puntero al descriptor de un pool estático.
+    typedef struct pool_s * pool_t;
+
+    //! Estadísticas de uso de un pool.
+    typedef struct pool_stats_s
+    {
+        uint16_t capacity; //!< Cantidad de elementos del pool.
+        uint16_t used;     //!< Cantidad de elementos en uso.
+        uint16_t peak;     //!< Máxima cantidad de elementos en uso registrada.
+        uint16_t failures; //!< Cantidad de pedidos rechazados por falta de elementos.
+        size_t bytes;      //!< Memoria estática ocupada por el pool, incluyendo el mapa de bits.
+    } pool_stats_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Asigna un elemento libre del pool.
+     *
+     * Busca el primer bit libre del mapa contando los ceros finales de cada palabra, por lo que el costo no depende
+     * de la cantidad de elementos en uso. El elemento se entrega con su memoria en cero.
+     *
+     * @param pool  Puntero al pool.
+     * @return void* Puntero al elemento asignado o NULL si el pool está lleno.
+     */
+    void * PoolAllocate(pool_t pool);
+
+    /**
+     * @brief Devuelve un elemento al pool.
+     *
+     * @param pool      Puntero al pool.
+     * @param item      Puntero al elemento a liberar.
+     * @return true     El elemento se liberó.
+     * @return false    El puntero no pertenece al pool o el elemento no estaba en uso.
+     */
+    bool PoolRelease(pool_t pool, void * item);
+
+    /**
+     * @brief Consulta las estadísticas de uso del pool.
+     *
+     * @param pool  Puntero al pool.
+     * @param stats Puntero a la estructura donde se guardan las estadísticas.
+     */
+    void PoolGetStats(pool_t pool, pool_stats_t * stats);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* POOL_H */
@@ -23,6 +23,11 @@ SPDX-License-Identifier: MIT
 #define RELOJ_H
 
 /** \brief Módulo de funcionamiento del reloj
+ **
+ ** La hora la cuenta una fuente intercambiable. Sin fuente el reloj cuenta los tics de ClockRefresh, como siempre;
+ ** con una fuente, como el RTC de la placa o el reloj monótono de la computadora, la hora avanza por su cuenta y
+ ** ClockGetTime la lee directamente. En los dos casos ClockRefresh se sigue llamando en cada tic: detecta el cambio de
+ ** segundo para revisar la alarma y cuenta los tics dentro del segundo para el parpadeo de medio segundo.
  **
  ** \addtogroup reloj RELOJ
  ** \brief Funcionamiento del  reloj
@@ -49,6 +54,19 @@ extern "C"
     //! Tipo de dato puntero a función tipo callback para activar alarma.
     typedef void (*alarma_event_t)(bool estado);
 
+    //! Función para leer los segundos desde la medianoche, devuelve false si la fuente no tiene una hora fijada.
+    typedef bool (*clock_source_read_t)(uint32_t * seconds);
+
+    //! Función para fijar los segundos desde la medianoche.
+    typedef void (*clock_source_write_t)(uint32_t seconds);
+
+    //! Estructura con las funciones de una fuente de la hora que avanza sin llamadas a ClockRefresh.
+    typedef struct clock_source_s
+    {
+        clock_source_read_t Read;   //!< Función para leer la hora, la llama ClockRefresh en cada tic.
+        clock_source_write_t Write; //!< Función para fijar la hora.
+    } const * clock_source_t;       //!< Puntero a la fuente de la hora.
+
     /* === Public variable declarations ============================================================ */
 
     /* === Public function declarations ============================================================ */
@@ -64,10 +82,21 @@ extern "C"
      */
     clock_t ClockCreate(int tics_por_segundo, alarma_event_t ActivarAlarma);
 
+    /**
+     * @brief Método para cambiar la fuente de la hora.
+     *
+     * La hora y su validez pasan a ser las de la fuente, por ejemplo la que el RTC conservó con la batería.
+     *
+     * @param reloj     Puntero al reloj.
+     * @param fuente    Puntero a la fuente, NULL para contar los tics de ClockRefresh.
+     */
+    void ClockSetSource(clock_t reloj, clock_source_t fuente);
+
     /**
      * @brief Método para actualizar la hora del reloj.
      *
-     * Incrementa la hora en un segundo al llamarla una cantidad de veces igual al valor de la variable tics.
+     * Sin fuente incrementa la hora en un segundo al llamarla una cantidad de veces igual al valor de la variable
+     * tics. Con una fuente lee la hora y, si cambió el segundo, revisa la alarma en cada segundo transcurrido.
      *
      * @param reloj     Puntero al reloj.
      * @return true     Paso medio segundo.
@@ -75,6 +104,18 @@ extern "C"
      */
     bool ClockRefresh(clock_t reloj);
 
+    /**
+     * @brief Método para consultar si el último ClockRefresh cambió de segundo.
+     *
+     * A diferencia del medio segundo que devuelve ClockRefresh, también lo indica cuando las llamadas están separadas
+     * por más de un segundo, como cuando la fuente avanza sola.
+     *
+     * @param reloj     Puntero al reloj.
+     * @return true     El último ClockRefresh cambió de segundo.
+     * @return false    El último ClockRefresh no cambió de segundo.
+     */
+    bool ClockSecondChanged(clock_t reloj);
+
     /**
      * @brief Método para fijar la hora del reloj.
      *
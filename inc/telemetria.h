@@ -0,0 +1,136 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+/** \brief Tramas binarias de telemetría
+ **
+ ** Cada trama lleva un tipo, un número de secuencia, los datos en little endian y un CRC-16/CCITT, y se codifica con
+ ** COBS para que el único byte cero sea el delimitador final. Así el receptor se sincroniza en el primer cero que
+ ** recibe y descarta las tramas dañadas por el CRC. El formato lo decodifica la herramienta tools/telemetria.py.
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "histograma.h"
+#include "periodo.h"
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Con TELEMETRY en 1 el equipo envía periódicamente el estado y la traza por la UART de depuración. Con CONSOLE en 1
+//! comparte la UART con la consola, por lo que empieza deshabilitada y la habilita el comando telemetria si.
+#ifndef TELEMETRY
+#define TELEMETRY 1
+#endif
+
+//! Período de envío en milisegundos.
+#ifndef TELEMETRY_PERIOD
+#define TELEMETRY_PERIOD 1000
+#endif
+
+//! Cantidad máxima de eventos de traza por trama.
+#ifndef TELEMETRY_TRACE_ENTRIES
+#define TELEMETRY_TRACE_ENTRIES 16
+#endif
+
+//! Mayor cantidad de datos de una trama, sin encabezado ni CRC.
+#define TELEMETRY_MAX_PAYLOAD (5 + 8 * TELEMETRY_TRACE_ENTRIES)
+
+//! Tamaño de buffer que asegura lugar para una trama codificada: encabezado, CRC, sobrecarga de COBS y delimitador.
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_PAYLOAD + 4 + (TELEMETRY_MAX_PAYLOAD + 4) / 254 + 2)
+
+//! Valor de carga del procesador cuando la medición no está disponible.
+#define TELEMETRY_NO_LOAD 0xFFFF
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Tipos de trama. Los valores forman parte del formato y no deben reordenarse.
+    typedef enum
+    {
+        TELEMETRY_STATUS = 1, //!< Estado del reloj y contadores de desempeño.
+        TELEMETRY_TRACE,      //!< Eventos nuevos de la traza.
+    } telemetry_frame_t;
+
+    //! Estado del equipo que se envía en una trama TELEMETRY_STATUS.
+    typedef struct telemetry_status_s
+    {
+        uint32_t uptime;           //!< Milisegundos desde el arranque, módulo 2^32.
+        uint8_t time[6];           //!< Hora actual, un dígito BCD por byte.
+        uint8_t alarm[6];          //!< Hora de la alarma, un dígito BCD por byte.
+        uint8_t mode;              //!< Modo de la interfaz de usuario.
+        bool time_valid : 1;       //!< La hora fue ajustada.
+        bool alarm_enabled : 1;    //!< La alarma está habilitada.
+        bool alarm_ringing : 1;    //!< La alarma está sonando.
+        uint32_t main_wakeups;     //!< Veces que se despertó la tarea principal.
+        uint32_t scan_wakeups;     //!< Veces que se ejecutó el barrido.
+        uint32_t lost_events;      //!< Eventos descartados por tener la cola llena.
+        uint16_t idle;             //!< Tiempo inactivo en décimas de porcentaje o TELEMETRY_NO_LOAD.
+        histogram_stats_t latency; //!< Latencia entre una tecla y el cuadro que la muestra, en ticks.
+        period_stats_t scan;       //!< Período del barrido.
+        uint32_t trace_written;    //!< Cantidad de eventos registrados en la traza.
+    } telemetry_status_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Codifica una trama con el estado del equipo.
+     *
+     * @param status    Estado a enviar.
+     * @param output    Buffer donde se escribe la trama codificada, incluyendo el delimitador.
+     * @param size      Tamaño del buffer.
+     * @return uint16_t Cantidad de bytes escritos, cero si la trama no entra en el buffer.
+     */
+    uint16_t TelemetryEncodeStatus(const telemetry_status_t * status, uint8_t * output, uint16_t size);
+
+    /**
+     * @brief Codifica una trama con los eventos de la traza registrados desde la trama anterior.
+     *
+     * @param cursor    Cursor de lectura de la traza, ver TraceRead.
+     * @param output    Buffer donde se escribe la trama codificada, incluyendo el delimitador.
+     * @param size      Tamaño del buffer.
+     * @return uint16_t Cantidad de bytes escritos, cero si no hay eventos nuevos o la trama no entra en el buffer.
+     */
+    uint16_t TelemetryEncodeTrace(uint32_t * cursor, uint8_t * output, uint16_t size);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* TELEMETRIA_H */
@@ -0,0 +1,108 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef TIEMPO_H
+#define TIEMPO_H
+
+/** \brief Tiempo desde el arranque
+ **
+ ** Cuenta los milisegundos desde el arranque en 64 bits, por lo que no desborda. El contador lo avanza la
+ ** interrupción del tick, con los ticks que el modo de bajo consumo suprimió incluidos, y no cambia cuando se ajusta la
+ ** hora: los plazos de la interfaz y las marcas de tiempo se calculan con él, y la hora del día se obtiene sumándole
+ ** un desplazamiento con la fuente que devuelve UptimeClockSource.
+ **
+ ** La lectura no toma bloqueos: lee la parte alta, la parte baja y otra vez la parte alta, y repite si la interrupción
+ ** del tick la cambió en el medio, lo que ocurre una vez cada 49 días. Por eso se puede leer desde tareas y desde
+ ** interrupciones que no desalojen a la del tick. UptimeStamp devuelve los 32 bits bajos con una sola lectura, para
+ ** las marcas de tiempo que se restan en aritmética modular.
+ **
+ ** \addtogroup tiempo TIEMPO
+ ** \brief Tiempo monótono desde el arranque
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include "reloj.h"
+#include <stdint.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* === Public macros definitions =============================================================== */
+
+    /* === Public data type declarations =========================================================== */
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Avanza el tiempo desde el arranque, solo desde la interrupción del tick.
+     *
+     * @param milliseconds Milisegundos transcurridos desde la llamada anterior.
+     */
+    void UptimeAdvance(uint32_t milliseconds);
+
+    /**
+     * @brief Consulta los milisegundos desde el arranque.
+     *
+     * @return uint64_t Milisegundos desde el arranque.
+     */
+    uint64_t UptimeMilliseconds(void);
+
+    /**
+     * @brief Consulta los 32 bits bajos de los milisegundos desde el arranque, como base de tiempo de las marcas.
+     *
+     * @return uint32_t Milisegundos desde el arranque, módulo 2^32.
+     */
+    uint32_t UptimeStamp(void);
+
+    /**
+     * @brief Completa una marca de UptimeStamp de los últimos 49 días con la parte alta del tiempo actual.
+     *
+     * @param stamp     Marca de tiempo que no es posterior al momento actual.
+     * @return uint64_t Milisegundos desde el arranque en el momento de la marca.
+     */
+    uint64_t UptimeExpand(uint32_t stamp);
+
+    /**
+     * @brief Devuelve la fuente de la hora que suma un desplazamiento al tiempo desde el arranque.
+     *
+     * No tiene hora fijada hasta la primera escritura. Fijar la hora solo cambia el desplazamiento, por lo que los
+     * segundos siguen cambiando en los mismos milisegundos desde el arranque.
+     *
+     * @return clock_source_t Puntero a la fuente, la misma en cada llamada.
+     */
+    clock_source_t UptimeClockSource(void);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* TIEMPO_H */
@@ -0,0 +1,149 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef TRAFICO_H
+#define TRAFICO_H
+
+/** \brief Contabilidad del tráfico de los puertos GPIO
+ **
+ ** Con GPIO_ACCOUNTING en 1 las funciones Chip_GPIO_* que usan digital.c y bspreloj.c se reemplazan por macros que
+ ** cuentan cada lectura y cada escritura por puerto y por lugar de llamada, antes de llamar a la función de LPCOpen.
+ ** Una escritura es redundante si no cambia el nivel de ningún terminal: el modelo lo decide leyendo antes el registro
+ ** SET, que en el LPC43xx y en el modelo de la computadora devuelve el nivel escrito en las salidas. Los cambios de
+ ** dirección se comparan con el registro DIR, los de la máscara con MASK y las escrituras en MPIN con SET y MASK.
+ **
+ ** Cada lugar de llamada es una variable estática que se agrega a una lista la primera vez que se usa, por lo que solo
+ ** aparecen los que se ejecutaron. Los contadores se incrementan con operaciones atómicas porque el barrido puede
+ ** correr en una interrupción.
+ **
+ ** Con GPIO_ACCOUNTING en 0 la cabecera solo incluye chip.h y no agrega código.
+ **
+ ** \addtogroup metricas METRICAS
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "chip.h"
+
+#ifndef GPIO_ACCOUNTING
+#define GPIO_ACCOUNTING 0
+#endif
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad de puertos GPIO que se contabilizan, los del LPC43xx.
+#define TRAFFIC_PORTS 8
+
+#if (GPIO_ACCOUNTING == 1)
+//! Declara el lugar de llamada actual la primera vez que se ejecuta y devuelve su dirección.
+#define TRAFFIC_SITE()                                                                                                 \
+    ({                                                                                                                 \
+        static traffic_site_t traffic_site = {.function = __func__, .line = __LINE__};                                 \
+        &traffic_site;                                                                                                 \
+    })
+
+#define Chip_GPIO_SetPinDIR(gpio, port, pin, output)    TrafficSetPinDIR(TRAFFIC_SITE(), gpio, port, pin, output)
+#define Chip_GPIO_SetPortDIRInput(gpio, port, mask)     TrafficSetPortDIRInput(TRAFFIC_SITE(), gpio, port, mask)
+#define Chip_GPIO_SetPinState(gpio, port, pin, value)   TrafficSetPinState(TRAFFIC_SITE(), gpio, port, pin, value)
+#define Chip_GPIO_SetPinToggle(gpio, port, pin)         TrafficSetPinToggle(TRAFFIC_SITE(), gpio, port, pin)
+#define Chip_GPIO_SetValue(gpio, port, value)           TrafficSetValue(TRAFFIC_SITE(), gpio, port, value)
+#define Chip_GPIO_ClearValue(gpio, port, value)         TrafficClearValue(TRAFFIC_SITE(), gpio, port, value)
+#define Chip_GPIO_SetPortToggle(gpio, port, pins)       TrafficSetPortToggle(TRAFFIC_SITE(), gpio, port, pins)
+#define Chip_GPIO_SetPortMask(gpio, port, mask)         TrafficSetPortMask(TRAFFIC_SITE(), gpio, port, mask)
+#define Chip_GPIO_SetMaskedPortValue(gpio, port, value) TrafficSetMaskedPortValue(TRAFFIC_SITE(), gpio, port, value)
+#define Chip_GPIO_ReadPortBit(gpio, port, pin)          TrafficReadPortBit(TRAFFIC_SITE(), gpio, port, pin)
+#define Chip_GPIO_GetPortValue(gpio, port)              TrafficGetPortValue(TRAFFIC_SITE(), gpio, port)
+#endif
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Accesos contados en un puerto o en un lugar de llamada.
+    typedef struct traffic_counts_s
+    {
+        uint32_t reads;     //!< Lecturas.
+        uint32_t writes;    //!< Escrituras, incluidas las redundantes.
+        uint32_t redundant; //!< Escrituras que no cambiaron ningún terminal.
+    } traffic_counts_t;
+
+    //! Lugar de llamada a una función de GPIO.
+    typedef struct traffic_site_s
+    {
+        const char * function;        //!< Función que hace la llamada.
+        uint16_t line;                //!< Línea de la llamada.
+        bool listed;                  //!< El lugar ya está en la lista.
+        traffic_counts_t counts;      //!< Accesos desde este lugar.
+        struct traffic_site_s * next; //!< Siguiente lugar de la lista.
+    } traffic_site_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Consulta los accesos a un puerto.
+     *
+     * @param port      Número de puerto, menor que TRAFFIC_PORTS.
+     * @param counts    Puntero donde se copian los contadores.
+     */
+    void TrafficGetPort(uint8_t port, traffic_counts_t * counts);
+
+    /**
+     * @brief Devuelve el primer lugar de llamada de la lista, los siguientes se recorren con el campo next.
+     *
+     * @return const traffic_site_t* Lugar de llamada usado más recientemente por primera vez, NULL si no hay ninguno.
+     */
+    const traffic_site_t * TrafficGetSites(void);
+
+    /**
+     * @brief Pone en cero los contadores de los puertos y de los lugares de llamada, que siguen en la lista.
+     */
+    void TrafficClear(void);
+
+    void TrafficSetPinDIR(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool output);
+    void TrafficSetPortDIRInput(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pinMask);
+    void TrafficSetPinState(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool setting);
+    void TrafficSetPinToggle(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin);
+    void TrafficSetValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue);
+    void TrafficClearValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue);
+    void TrafficSetPortToggle(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pins);
+    void TrafficSetPortMask(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t mask);
+    void TrafficSetMaskedPortValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t value);
+    bool TrafficReadPortBit(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint32_t port, uint8_t pin);
+    uint32_t TrafficGetPortValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* TRAFICO_H */
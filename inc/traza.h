@@ -0,0 +1,149 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+/** \brief Registro binario de eventos en un buffer circular
+ **
+ ** Cada evento ocupa dos palabras: la marca de tiempo y el tipo con hasta 24 bits de datos. La posición se reserva
+ ** con un incremento atómico del índice de escritura, por lo que se puede registrar desde tareas e interrupciones sin
+ ** bloqueos. Cuando el buffer se llena se pisan los eventos más antiguos.
+ **
+ ** El contenido se extrae con el depurador, por ejemplo `dump binary value traza.bin traza` en gdb, y se decodifica
+ ** con la herramienta tools/traza.py.
+ **
+ ** \addtogroup traza TRAZA
+ ** \brief Registro de eventos para diagnóstico
+ ** @{ */
+
+/* === Headers files inclusions ================================================================ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+//! Cantidad de eventos que guarda el buffer, debe ser una potencia de dos.
+#ifndef TRACE_ENTRIES
+#define TRACE_ENTRIES 128
+#endif
+
+//! Identificador que encabeza el buffer para que la herramienta de decodificación lo reconozca ("TRZ1").
+#define TRACE_MAGIC 0x315A5254
+
+//! Empaqueta tres bytes de datos de un evento, el primero en los bits menos significativos.
+#define TRACE_DATA(a, b, c) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16))
+
+    /* === Public data type declarations =========================================================== */
+
+    //! Tipos de evento. Los valores forman parte del formato binario y no deben reordenarse.
+    typedef enum
+    {
+        TRACE_MODE_CHANGE = 1, //!< Cambio de modo: modo anterior y modo nuevo.
+        TRACE_KEY_PRESSED,     //!< Tecla presionada: número de tecla.
+        TRACE_KEY_RELEASED,    //!< Tecla liberada: número de tecla.
+        TRACE_CLOCK_SET,       //!< Hora ajustada: horas, minutos y segundos en BCD.
+        TRACE_ALARM_SET,       //!< Alarma ajustada: horas, minutos y segundos en BCD.
+        TRACE_ALARM_FIRE,      //!< Alarma disparada: 0 normal, 1 pospuesta.
+        TRACE_ALARM_SNOOZE,    //!< Alarma pospuesta: minutos.
+        TRACE_ALARM_CANCEL,    //!< Alarma cancelada.
+        TRACE_DEADLINE_MISS,   //!< Plazo vencido: identificador de la tarea y períodos de retraso (16 bits).
+    } trace_event_t;
+
+    //! Función que devuelve la marca de tiempo de los eventos. Se llama desde tareas e interrupciones.
+    typedef uint32_t (*trace_timebase_t)(void);
+
+    //! Evento registrado.
+    typedef struct trace_entry_s
+    {
+        uint32_t timestamp; //!< Marca de tiempo del evento.
+        uint32_t event;     //!< Tipo de evento en los 8 bits menos significativos y datos en los 24 restantes.
+    } trace_entry_t;
+
+    /* === Public variable declarations ============================================================ */
+
+    /* === Public function declarations ============================================================ */
+
+    /**
+     * @brief Define la función que provee la marca de tiempo de los eventos.
+     *
+     * @param function Función que devuelve el tiempo actual, NULL registra los eventos con marca cero.
+     */
+    void TraceSetTimebase(trace_timebase_t function);
+
+    /**
+     * @brief Registra un evento en el buffer circular.
+     *
+     * @param event Tipo de evento.
+     * @param data  Datos del evento, solo se guardan los 24 bits menos significativos (ver TRACE_DATA).
+     */
+    void TraceRecord(trace_event_t event, uint32_t data);
+
+    /**
+     * @brief Copia los eventos registrados desde la última lectura.
+     *
+     * Si el buffer se llenó desde la lectura anterior los eventos pisados se saltean y el cursor avanza hasta el más
+     * antiguo que se conserva. Un evento que se está escribiendo en ese momento se deja para la próxima lectura.
+     *
+     * @param cursor    Cantidad de eventos leídos hasta ahora, se actualiza con los copiados. Comienza en cero.
+     * @param entries   Vector donde se copian los eventos.
+     * @param count     Capacidad del vector.
+     * @return uint16_t Cantidad de eventos copiados.
+     */
+    uint16_t TraceRead(uint32_t * cursor, trace_entry_t * entries, uint16_t count);
+
+    /**
+     * @brief Consulta la cantidad total de eventos registrados, incluyendo los que ya se pisaron.
+     *
+     * @return uint32_t Cantidad de eventos registrados desde el inicio o desde TraceClear.
+     */
+    uint32_t TraceCount(void);
+
+    /**
+     * @brief Descarta todos los eventos registrados.
+     */
+    void TraceClear(void);
+
+    /**
+     * @brief Consulta la posición y el tamaño del buffer completo, con su encabezado, para enviarlo fuera del equipo.
+     *
+     * @param size Puntero donde se guarda el tamaño en bytes.
+     * @return const void* Dirección del buffer.
+     */
+    const void * TraceGetBuffer(size_t * size);
+
+    /* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of module definition for doxygen */
+
+#endif /* TRAZA_H */
@@ -0,0 +1,309 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Ajustes persistentes
+ **
+ ** Formato de un registro, en little endian:
+ **
+ **     0       versión del formato, cero en una posición sin escribir
+ **     1       largo de los datos en bytes
+ **     2-3     CRC-16/CCITT del registro con este campo en cero
+ **     4-7     número de secuencia, el primero es 1
+ **     8-10    hora de la alarma, tres bytes BCD
+ **     11      banderas: alarma ajustada, alarma habilitada y telemetría habilitada
+ **     12-15   sin uso, en cero
+ **
+ ** \addtogroup ajustes AJUSTES
+ ** \brief Ajustes persistentes en EEPROM
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "ajustes.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Posición de los campos dentro de un registro.
+#define CAMPO_VERSION   0
+#define CAMPO_LARGO     1
+#define CAMPO_CRC       2
+#define CAMPO_SECUENCIA 4
+#define CAMPO_DATOS     8
+
+//! Largo de los datos de la versión 1: alarma y banderas.
+#define LARGO_VERSION_1 4
+
+//! Banderas de la versión 1.
+#define BANDERA_ALARMA_VALIDA     (1 << 0)
+#define BANDERA_ALARMA_HABILITADA (1 << 1)
+#define BANDERA_TELEMETRIA        (1 << 2)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Calcula el CRC-16/CCITT (polinomio 0x1021, valor inicial 0xFFFF) con una tabla de 16 entradas.
+ */
+static uint16_t Crc16(const uint8_t * datos, uint16_t largo);
+
+/**
+ * @brief Arma el registro de unos ajustes con el número de secuencia indicado.
+ */
+static void Codificar(const settings_t * settings, uint32_t secuencia, uint8_t * registro);
+
+/**
+ * @brief Verifica un registro y, si es válido, extrae la secuencia.
+ *
+ * @return true El registro tiene una versión conocida, un largo posible y el CRC correcto.
+ */
+static bool Validar(const uint8_t * registro, uint32_t * secuencia);
+
+/**
+ * @brief Extrae los ajustes de un registro válido, los campos que no trae conservan su valor.
+ */
+static void Decodificar(const uint8_t * registro, settings_t * settings);
+
+/**
+ * @brief Calcula la página y el desplazamiento de una posición del diario.
+ */
+static void Ubicar(uint16_t posicion, uint16_t * pagina, uint16_t * desplazamiento);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static settings_driver_t memoria = NULL;
+static uint16_t posiciones = 0;
+
+// Último registro escrito o restaurado
+static uint16_t posicion = 0;
+static uint32_t secuencia = 0;
+static settings_t guardados;
+
+static settings_t pendientes;
+static bool pendiente = false;
+static uint32_t escrituras = 0;
+
+/* === Private function implementation ========================================================= */
+
+static uint16_t Crc16(const uint8_t * datos, uint16_t largo)
+{
+    static const uint16_t TABLA[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t index = 0; index < largo; index++)
+    {
+        crc = (crc << 4) ^ TABLA[(crc >> 12) ^ (datos[index] >> 4)];
+        crc = (crc << 4) ^ TABLA[(crc >> 12) ^ (datos[index] & 0x0F)];
+    }
+
+    return crc;
+}
+
+static void Codificar(const settings_t * settings, uint32_t secuencia, uint8_t * registro)
+{
+    uint16_t crc;
+
+    memset(registro, 0, SETTINGS_RECORD_SIZE);
+    registro[CAMPO_VERSION] = SETTINGS_VERSION;
+    registro[CAMPO_LARGO] = LARGO_VERSION_1;
+    for (int index = 0; index < 4; index++)
+    {
+        registro[CAMPO_SECUENCIA + index] = secuencia >> (8 * index);
+    }
+    for (int index = 0; index < 3; index++)
+    {
+        registro[CAMPO_DATOS + index] = (settings->alarm[2 * index] << 4) | (settings->alarm[2 * index + 1] & 0x0F);
+    }
+    registro[CAMPO_DATOS + 3] = (settings->alarm_valid ? BANDERA_ALARMA_VALIDA : 0) |
+                                (settings->alarm_enabled ? BANDERA_ALARMA_HABILITADA : 0) |
+                                (settings->telemetry ? BANDERA_TELEMETRIA : 0);
+
+    crc = Crc16(registro, SETTINGS_RECORD_SIZE);
+    registro[CAMPO_CRC] = crc;
+    registro[CAMPO_CRC + 1] = crc >> 8;
+
+    return;
+}
+
+static bool Validar(const uint8_t * registro, uint32_t * secuencia)
+{
+    uint8_t copia[SETTINGS_RECORD_SIZE];
+    uint16_t crc = registro[CAMPO_CRC] | (registro[CAMPO_CRC + 1] << 8);
+
+    // La mayoría de las posiciones vacías se descartan sin calcular el CRC
+    if ((registro[CAMPO_VERSION] == 0) || (registro[CAMPO_VERSION] > SETTINGS_VERSION) ||
+        (registro[CAMPO_LARGO] > SETTINGS_RECORD_SIZE - CAMPO_DATOS))
+    {
+        return false;
+    }
+
+    memcpy(copia, registro, sizeof(copia));
+    copia[CAMPO_CRC] = 0;
+    copia[CAMPO_CRC + 1] = 0;
+    if (Crc16(copia, sizeof(copia)) != crc)
+    {
+        return false;
+    }
+
+    *secuencia = 0;
+    for (int index = 0; index < 4; index++)
+    {
+        *secuencia |= (uint32_t)registro[CAMPO_SECUENCIA + index] << (8 * index);
+    }
+
+    return *secuencia != 0;
+}
+
+static void Decodificar(const uint8_t * registro, settings_t * settings)
+{
+    const uint8_t * datos = &registro[CAMPO_DATOS];
+
+    if (registro[CAMPO_LARGO] >= LARGO_VERSION_1)
+    {
+        for (int index = 0; index < 3; index++)
+        {
+            settings->alarm[2 * index] = datos[index] >> 4;
+            settings->alarm[2 * index + 1] = datos[index] & 0x0F;
+        }
+        settings->alarm_valid = datos[3] & BANDERA_ALARMA_VALIDA;
+        settings->alarm_enabled = datos[3] & BANDERA_ALARMA_HABILITADA;
+        settings->telemetry = datos[3] & BANDERA_TELEMETRIA;
+    }
+
+    return;
+}
+
+static void Ubicar(uint16_t posicion, uint16_t * pagina, uint16_t * desplazamiento)
+{
+    // Posiciones consecutivas caen en páginas distintas
+    *pagina = posicion % memoria->pages;
+    *desplazamiento = (posicion / memoria->pages) * SETTINGS_RECORD_SIZE;
+
+    return;
+}
+
+/* === Public function implementation ========================================================== */
+
+void SettingsInit(settings_driver_t driver)
+{
+    memoria = driver;
+    posiciones = driver->pages * (driver->page_size / SETTINGS_RECORD_SIZE);
+    posicion = posiciones - 1; // Sin registros, el primero se escribe en la posición cero
+    secuencia = 0;
+    pendiente = false;
+    escrituras = 0;
+    memset(&guardados, 0, sizeof(guardados));
+
+    return;
+}
+
+bool SettingsRestore(settings_t * settings)
+{
+    static uint32_t pagina[SETTINGS_PAGE_SIZE_MAX / sizeof(uint32_t)];
+    const uint8_t * registro;
+    uint32_t leida;
+    bool encontrado = false;
+
+    for (uint16_t numero = 0; numero < memoria->pages; numero++)
+    {
+        memoria->Read(numero, pagina);
+        for (uint16_t desplazamiento = 0; desplazamiento < memoria->page_size; desplazamiento += SETTINGS_RECORD_SIZE)
+        {
+            registro = (const uint8_t *)pagina + desplazamiento;
+            // La resta en aritmética modular ordena las secuencias aunque el contador desborde
+            if (Validar(registro, &leida) && (!encontrado || ((int32_t)(leida - secuencia) > 0)))
+            {
+                encontrado = true;
+                secuencia = leida;
+                posicion = (desplazamiento / SETTINGS_RECORD_SIZE) * memoria->pages + numero;
+                Decodificar(registro, &guardados);
+            }
+        }
+    }
+
+    if (encontrado)
+    {
+        *settings = guardados;
+    }
+
+    return encontrado;
+}
+
+void SettingsSave(const settings_t * settings)
+{
+    if (memcmp(settings, pendiente ? &pendientes : &guardados, sizeof(settings_t)))
+    {
+        pendientes = *settings;
+        pendiente = memcmp(&pendientes, &guardados, sizeof(settings_t));
+    }
+
+    return;
+}
+
+bool SettingsFlush(void)
+{
+    uint32_t registro[SETTINGS_RECORD_SIZE / sizeof(uint32_t)];
+    uint16_t siguiente = (posicion + 1) % posiciones;
+    uint16_t pagina, desplazamiento;
+
+    if (!pendiente)
+    {
+        return true;
+    }
+
+    Codificar(&pendientes, secuencia + 1, (uint8_t *)registro);
+    Ubicar(siguiente, &pagina, &desplazamiento);
+    if (!memoria->Write(pagina, desplazamiento, registro, SETTINGS_RECORD_SIZE / sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    posicion = siguiente;
+    secuencia++;
+    guardados = pendientes;
+    pendiente = false;
+    escrituras++;
+
+    return true;
+}
+
+void SettingsGetStats(settings_stats_t * stats)
+{
+    stats->slots = posiciones;
+    stats->slot = posicion;
+    stats->sequence = secuencia;
+    stats->writes = escrituras;
+    stats->pending = pendiente;
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -31,8 +31,10 @@ SPDX-License-Identifier: MIT
 
 #include "bspreloj.h"
 #include "chip.h"
+#include "trafico.h"
 #include "poncho.h"
 #include "pantalla.h"
+#include <string.h>
 
 /* === Macros definitions ====================================================================== */
 
@@ -40,22 +42,83 @@ SPDX-License-Identifier: MIT
 #define DIGITOS 4
 #endif
 
+//! Primera página de la EEPROM que ocupa el diario de ajustes, que llega hasta la última página disponible.
+#ifndef SETTINGS_FIRST_PAGE
+#define SETTINGS_FIRST_PAGE 0
+#endif
+
+//! Páginas del diario de ajustes, la última página de la EEPROM está reservada.
+#define SETTINGS_PAGES (EEPROM_PAGE_NUM - 1 - SETTINGS_FIRST_PAGE)
+
+//! Registro de respaldo donde se marca que el RTC tiene una hora fijada, se conserva con la batería como el RTC.
+#define RTC_BACKUP_REGISTER 0
+
+//! Marca de hora fijada, "RTC1" en ASCII.
+#define RTC_VALID_MARK 0x52544331
+
+//! Campos del registro CTIME0, que tiene los segundos, los minutos y las horas juntos.
+#define RTC_CTIME0_SECONDS(ctime) ((ctime) & 0x3F)
+#define RTC_CTIME0_MINUTES(ctime) (((ctime) >> 8) & 0x3F)
+#define RTC_CTIME0_HOURS(ctime)   (((ctime) >> 16) & 0x1F)
+
+//! Terminal de una tecla con entrada propia, para la lista de canales de interrupción.
+#define KEY_CHANNEL(pin) {pin##_GPIO, pin##_BIT},
+
 /* === Private data type declarations ========================================================== */
 
+//! Terminal GPIO asignado a un canal de interrupción de terminal.
+typedef struct key_channel_s
+{
+    uint8_t gpio;
+    uint8_t bit;
+} key_channel_t;
+
 /* === Private variable declarations =========================================================== */
 
 static struct board_s board = {0};
 
+static scan_timer_event_t ScanTimerEvent = NULL;
+
+// Un canal de interrupción por tecla con entrada propia, en el orden de PONCHO_DIGITAL_INPUT_PINS
+static const key_channel_t KeyChannels[PONCHO_DIGITAL_INPUTS] = {PONCHO_DIGITAL_INPUT_PINS(KEY_CHANNEL)};
+#if (KEY_MATRIX == 1)
+// Las filas del teclado matricial usan los canales que siguen a los de las teclas con entrada propia
+static const key_channel_t KeyRows[] = {
+    KEY_CHANNEL(KEY_F1) KEY_CHANNEL(KEY_F2) KEY_CHANNEL(KEY_F3) KEY_CHANNEL(KEY_F4)};
+#endif
+static keys_event_t KeysChanged = NULL;
+
+static uint8_t SerialTxChannel = 0;
+static volatile bool SerialTxBusy = false;
+static serial_event_t SerialTransmitted = NULL;
+
+static uint8_t SerialRxChannel = 0;
+static const uint8_t * SerialRxBuffer = NULL;
+static DMA_TransferDescriptor_t SerialRxDescriptor;
+static serial_event_t SerialReceived = NULL;
+
+static bool EepromProgramming = false;
+
 /* === Private function declarations =========================================================== */
 
 void ScreenTurnOff(void);
 void SegmentsTurnOn(uint8_t segments);
 void DigitTurnOn(uint8_t digit);
+uint8_t KeysRead(void);
+void EepromRead(uint16_t page, uint32_t * words);
+bool EepromWrite(uint16_t page, uint16_t offset, const uint32_t * words, uint16_t count);
 
 void DigistInit(void);
 void SegmentsInit(void);
 void BuzzerInit(void);
 void KeysInit(void);
+void KeysInterrupt(uint8_t channel);
+void EepromInit(void);
+#if (CLOCK_RTC == 1)
+void RtcInit(void);
+bool RtcRead(uint32_t * seconds);
+void RtcWrite(uint32_t seconds);
+#endif
 
 /* === Public variable definitions ============================================================= */
 
@@ -88,6 +151,11 @@ void DigitTurnOn(uint8_t digit)
     return;
 }
 
+uint8_t KeysRead(void)
+{
+    return (Chip_GPIO_GetPortValue(LPC_GPIO_PORT, KEY_ROWS_GPIO) & KEY_ROWS_MASK) >> KEY_ROWS_SHIFT;
+}
+
 void DigistInit(void)
 {
     Chip_SCU_PinMuxSet(DIGIT_1_PORT, DIGIT_1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_INACT | DIGIT_1_FUNC);
@@ -156,6 +224,14 @@ void BuzzerInit(void)
 
 void KeysInit(void)
 {
+#if (KEY_MATRIX == 1)
+    // Las teclas F1 a F4 pasan a ser las filas del teclado matricial que se barre junto con la pantalla
+    Chip_SCU_PinMuxSet(KEY_F1_PORT, KEY_F1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLDOWN | KEY_F1_FUNC);
+    Chip_SCU_PinMuxSet(KEY_F2_PORT, KEY_F2_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLDOWN | KEY_F2_FUNC);
+    Chip_SCU_PinMuxSet(KEY_F3_PORT, KEY_F3_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLDOWN | KEY_F3_FUNC);
+    Chip_SCU_PinMuxSet(KEY_F4_PORT, KEY_F4_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLDOWN | KEY_F4_FUNC);
+    Chip_GPIO_SetPortDIRInput(LPC_GPIO_PORT, KEY_ROWS_GPIO, KEY_ROWS_MASK);
+#else
     Chip_SCU_PinMuxSet(KEY_F1_PORT, KEY_F1_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F1_FUNC);
     board.ajustar_tiempo = DigitalInputCreate(KEY_F1_GPIO, KEY_F1_BIT, false);
 
@@ -167,6 +243,7 @@ void KeysInit(void)
 
     Chip_SCU_PinMuxSet(KEY_F4_PORT, KEY_F4_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_F4_FUNC);
     board.incrementar = DigitalInputCreate(KEY_F4_GPIO, KEY_F4_BIT, false);
+#endif
 
     Chip_SCU_PinMuxSet(KEY_ACCEPT_PORT, KEY_ACCEPT_PIN, SCU_MODE_INBUFF_EN | SCU_MODE_PULLUP | KEY_ACCEPT_FUNC);
     board.aceptar = DigitalInputCreate(KEY_ACCEPT_GPIO, KEY_ACCEPT_BIT, false);
@@ -177,6 +254,112 @@ void KeysInit(void)
     return;
 }
 
+void KeysInterrupt(uint8_t channel)
+{
+    Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(channel));
+
+    if (KeysChanged)
+    {
+        KeysChanged();
+    }
+}
+
+void EepromInit(void)
+{
+    static const struct settings_driver_s driver = {
+        .pages = SETTINGS_PAGES,
+        .page_size = EEPROM_PAGE_SIZE,
+        .Read = EepromRead,
+        .Write = EepromWrite,
+    };
+
+    // Sin programación automática, la página se programa con el comando después de escribirla entera
+    Chip_EEPROM_Init(LPC_EEPROM);
+    Chip_EEPROM_SetAutoProg(LPC_EEPROM, EEPROM_AUTOPROG_OFF);
+    board.settings = &driver;
+
+    return;
+}
+
+void EepromRead(uint16_t page, uint32_t * words)
+{
+    const volatile uint32_t * origen = (const volatile uint32_t *)EEPROM_ADDRESS(SETTINGS_FIRST_PAGE + page, 0);
+
+    for (int index = 0; index < EEPROM_PAGE_SIZE / sizeof(uint32_t); index++)
+    {
+        words[index] = origen[index];
+    }
+
+    return;
+}
+
+bool EepromWrite(uint16_t page, uint16_t offset, const uint32_t * words, uint16_t count)
+{
+    volatile uint32_t * destino = (volatile uint32_t *)EEPROM_ADDRESS(SETTINGS_FIRST_PAGE + page, 0);
+    uint32_t contenido[EEPROM_PAGE_SIZE / sizeof(uint32_t)];
+
+    // La programación de una página dura unos 3 ms, no se espera a que termine
+    if (EepromProgramming && !(Chip_EEPROM_GetIntStatus(LPC_EEPROM) & EEPROM_INT_ENDOFPROG))
+    {
+        return false;
+    }
+
+    // El comando borra la página entera, por lo que se vuelven a escribir los demás registros que tiene
+    EepromRead(page, contenido);
+    memcpy(&contenido[offset / sizeof(uint32_t)], words, count * sizeof(uint32_t));
+    for (int index = 0; index < EEPROM_PAGE_SIZE / sizeof(uint32_t); index++)
+    {
+        destino[index] = contenido[index];
+    }
+
+    Chip_EEPROM_ClearIntStatus(LPC_EEPROM, EEPROM_INT_ENDOFPROG);
+    Chip_EEPROM_SetCmd(LPC_EEPROM, EEPROM_CMD_ERASE_PRG_PAGE);
+    EepromProgramming = true;
+
+    return true;
+}
+
+#if (CLOCK_RTC == 1)
+void RtcInit(void)
+{
+    static const struct clock_source_s source = {
+        .Read = RtcRead,
+        .Write = RtcWrite,
+    };
+
+    // Con la marca el RTC siguió contando con la batería: inicializarlo otra vez demora dos segundos sin necesidad
+    if (Chip_REGFILE_Read(LPC_REGFILE, RTC_BACKUP_REGISTER) != RTC_VALID_MARK)
+    {
+        Chip_RTC_Init(LPC_RTC);
+        Chip_RTC_Enable(LPC_RTC, ENABLE);
+    }
+    board.clock_source = &source;
+
+    return;
+}
+
+bool RtcRead(uint32_t * seconds)
+{
+    // Una sola lectura de CTIME0 no puede mezclar campos de antes y después de un cambio de segundo
+    uint32_t ctime = LPC_RTC->CTIME[0];
+
+    *seconds = (RTC_CTIME0_HOURS(ctime) * 60 + RTC_CTIME0_MINUTES(ctime)) * 60 + RTC_CTIME0_SECONDS(ctime);
+
+    return Chip_REGFILE_Read(LPC_REGFILE, RTC_BACKUP_REGISTER) == RTC_VALID_MARK;
+}
+
+void RtcWrite(uint32_t seconds)
+{
+    // Como al contar los tics, fijar la hora no cambia la fase del segundo, que el divisor sigue contando
+    Chip_RTC_SetTime(LPC_RTC, RTC_TIMETYPE_HOUR, seconds / 3600);
+    Chip_RTC_SetTime(LPC_RTC, RTC_TIMETYPE_MINUTE, (seconds / 60) % 60);
+    Chip_RTC_SetTime(LPC_RTC, RTC_TIMETYPE_SECOND, seconds % 60);
+    Chip_REGFILE_Write(LPC_REGFILE, RTC_BACKUP_REGISTER, RTC_VALID_MARK);
+
+    return;
+}
+#endif
+
 /* === Public function implementation ========================================================== */
 
 board_t BoardCreate(void)
@@ -185,12 +368,19 @@ board_t BoardCreate(void)
         .ScreenTurnOff = ScreenTurnOff,
         .SegmentsTurnOn = SegmentsTurnOn,
         .DigitTurnOn = DigitTurnOn,
+#if (KEY_MATRIX == 1)
+        .KeysRead = KeysRead,
+#endif
     };
 
     DigistInit();
     SegmentsInit();
     BuzzerInit();
     KeysInit();
+    EepromInit();
+#if (CLOCK_RTC == 1)
+    RtcInit();
+#endif
 
     board.display = DisplayCreate(DIGITOS, &driver);
 
@@ -199,7 +389,7 @@ board_t BoardCreate(void)
 
 void SysTick_Init(int ticks)
 {
-    __asm volatile("cpsid i");
+    __disable_irq();
 
     /* Activa Systick */
     SystemCoreClockUpdate();
@@ -208,7 +398,220 @@ void SysTick_Init(int ticks)
     /* Actualiza la prioridad puesta por el SysTick_Config */
     // NVIC_SetPriority(SysTick_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
 
-    __asm volatile("cpsie i");
+    __enable_irq();
+}
+
+void ScanTimer_Init(int periodo, scan_timer_event_t callback)
+{
+    ScanTimerEvent = callback;
+
+    Chip_RIT_Init(LPC_RITIMER);
+    Chip_RIT_SetTimerInterval(LPC_RITIMER, periodo);
+    NVIC_SetPriority(RITIMER_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ(RITIMER_IRQn);
+}
+
+void ScanTimer_SetPeriod(int periodo)
+{
+    // Con una comparación menor que la cuenta actual el temporizador no interrumpiría hasta dar la vuelta completa
+    Chip_RIT_SetTimerInterval(LPC_RITIMER, periodo);
+    LPC_RITIMER->COUNTER = 0;
+}
+
+uint32_t ScanTimer_Elapsed(void)
+{
+    return Chip_RIT_GetCounter(LPC_RITIMER) / (Chip_Clock_GetRate(CLK_MX_RITIMER) / 1000);
+}
+
+void RIT_IRQHandler(void)
+{
+    Chip_RIT_ClearInt(LPC_RITIMER);
+
+    if (ScanTimerEvent)
+    {
+        ScanTimerEvent();
+    }
+}
+
+void Keys_Init(keys_event_t changed)
+{
+    KeysChanged = changed;
+
+    Chip_PININT_Init(LPC_GPIO_PIN_INT);
+    for (uint8_t canal = 0; canal < PONCHO_DIGITAL_INPUTS; canal++)
+    {
+        Chip_SCU_GPIOIntPinSel(canal, KeyChannels[canal].gpio, KeyChannels[canal].bit);
+        Chip_PININT_SetPinModeEdge(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_EnableIntLow(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(canal));
+        NVIC_SetPriority(PIN_INT0_IRQn + canal, (1 << __NVIC_PRIO_BITS) - 1);
+        NVIC_EnableIRQ(PIN_INT0_IRQn + canal);
+    }
+
+#if (KEY_MATRIX == 1)
+    // Las filas quedan asignadas con la interrupción habilitada en el NVIC, los flancos los habilita Keys_WatchRows
+    for (uint8_t fila = 0; fila < sizeof(KeyRows) / sizeof(KeyRows[0]); fila++)
+    {
+        uint8_t canal = PONCHO_DIGITAL_INPUTS + fila;
+
+        Chip_SCU_GPIOIntPinSel(canal, KeyRows[fila].gpio, KeyRows[fila].bit);
+        Chip_PININT_SetPinModeEdge(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_DisableIntHigh(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_DisableIntLow(LPC_GPIO_PIN_INT, PININTCH(canal));
+        Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(canal));
+        NVIC_SetPriority(PIN_INT0_IRQn + canal, (1 << __NVIC_PRIO_BITS) - 1);
+        NVIC_EnableIRQ(PIN_INT0_IRQn + canal);
+    }
+#endif
+}
+
+void Keys_WatchRows(bool watch)
+{
+#if (KEY_MATRIX == 1)
+    for (uint8_t fila = 0; fila < sizeof(KeyRows) / sizeof(KeyRows[0]); fila++)
+    {
+        uint8_t canal = PONCHO_DIGITAL_INPUTS + fila;
+
+        // Los flancos de las columnas que barrió la pantalla ya no indican una tecla nueva
+        Chip_PININT_ClearIntStatus(LPC_GPIO_PIN_INT, PININTCH(canal));
+        if (watch)
+        {
+            Chip_PININT_EnableIntHigh(LPC_GPIO_PIN_INT, PININTCH(canal));
+        }
+        else
+        {
+            Chip_PININT_DisableIntHigh(LPC_GPIO_PIN_INT, PININTCH(canal));
+        }
+    }
+#else
+    (void)watch;
+#endif
+}
+
+// Atención de los canales de interrupción de las teclas, con los nombres de los vectores del LPC43xx
+void GPIO0_IRQHandler(void)
+{
+    KeysInterrupt(0);
+}
+
+void GPIO1_IRQHandler(void)
+{
+    KeysInterrupt(1);
+}
+
+void GPIO2_IRQHandler(void)
+{
+    KeysInterrupt(2);
+}
+
+void GPIO3_IRQHandler(void)
+{
+    KeysInterrupt(3);
+}
+
+void GPIO4_IRQHandler(void)
+{
+    KeysInterrupt(4);
+}
+
+void GPIO5_IRQHandler(void)
+{
+    KeysInterrupt(5);
+}
+
+void Serial_Init(uint32_t baudrate, serial_event_t transmitted)
+{
+    SerialTransmitted = transmitted;
+
+    Chip_SCU_PinMuxSet(SERIAL_TX_PORT, SERIAL_TX_PIN, SCU_MODE_INACT | SERIAL_FUNC);
+    Chip_SCU_PinMuxSet(SERIAL_RX_PORT, SERIAL_RX_PIN, SCU_MODE_INACT | SCU_MODE_INBUFF_EN | SERIAL_FUNC);
+
+    Chip_UART_Init(SERIAL_UART);
+    Chip_UART_SetBaud(SERIAL_UART, baudrate);
+    Chip_UART_ConfigData(SERIAL_UART, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT | UART_LCR_PARITY_DIS);
+    Chip_UART_SetupFIFOS(SERIAL_UART, UART_FCR_FIFO_EN | UART_FCR_TRG_LEV0 | UART_FCR_DMAMODE_SEL);
+    Chip_UART_TXEnable(SERIAL_UART);
+
+    Chip_GPDMA_Init(LPC_GPDMA);
+    SerialTxChannel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, SERIAL_DMA_TX);
+    NVIC_SetPriority(DMA_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ(DMA_IRQn);
+}
+
+bool Serial_Send(const uint8_t * data, uint16_t size)
+{
+    uint32_t primask = __get_PRIMASK();
+    bool ocupada;
+
+    // Una interrupción que envía entre la consulta y la marca programaría el mismo canal dos veces
+    __disable_irq();
+    ocupada = SerialTxBusy;
+    SerialTxBusy = true;
+    __set_PRIMASK(primask);
+    if (ocupada)
+    {
+        return false;
+    }
+
+    Chip_GPDMA_Transfer(LPC_GPDMA, SerialTxChannel, (uintptr_t)data, SERIAL_DMA_TX,
+                        GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, size);
+
+    return true;
+}
+
+bool Serial_Busy(void)
+{
+    return SerialTxBusy;
+}
+
+void Serial_StartReceive(uint8_t * buffer, uint16_t size, serial_event_t received)
+{
+    // El descriptor se enlaza consigo mismo para que el DMA vuelva al comienzo del buffer al llenarlo, y como tiene
+    // sucesor no pide la interrupción de fin de transferencia
+    SerialReceived = received;
+    SerialRxBuffer = buffer;
+    SerialRxChannel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, SERIAL_DMA_RX);
+    Chip_GPDMA_InitDescriptor(LPC_GPDMA, &SerialRxDescriptor, SERIAL_DMA_RX, (uintptr_t)buffer, size,
+                              GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &SerialRxDescriptor);
+    Chip_GPDMA_SGTransfer(LPC_GPDMA, SerialRxChannel, &SerialRxDescriptor, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+
+    // En modo DMA la UART sigue pidiendo la interrupción de datos recibidos, que avisa la llegada de cada byte
+    Chip_UART_IntEnable(SERIAL_UART, UART_IER_RBRINT);
+    NVIC_SetPriority(SERIAL_IRQ, (1 << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ(SERIAL_IRQ);
+}
+
+uint16_t Serial_Received(void)
+{
+    return LPC_GPDMA->CH[SerialRxChannel].DESTADDR - (uintptr_t)SerialRxBuffer;
+}
+
+void DMA_IRQHandler(void)
+{
+    if (Chip_GPDMA_Interrupt(LPC_GPDMA, SerialTxChannel) == SUCCESS)
+    {
+        SerialTxBusy = false;
+        if (SerialTransmitted)
+        {
+            SerialTransmitted();
+        }
+    }
+}
+
+void SERIAL_IRQHandler(void)
+{
+    // Leer IIR borra la interrupción; el DMA vacía la FIFO en unos pocos ciclos de bus, se espera a que el byte esté
+    // en el buffer para que Serial_Received lo cuente
+    Chip_UART_ReadIntIDReg(SERIAL_UART);
+    while (Chip_UART_ReadLineStatus(SERIAL_UART) & UART_LSR_RDR)
+    {
+    }
+
+    if (SerialReceived)
+    {
+        SerialReceived();
+    }
 }
 
 /* === End of documentation ==================================================================== */
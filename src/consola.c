@@ -0,0 +1,440 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Consola de comandos de texto
+ **
+ ** \addtogroup consola CONSOLA
+ ** \brief Consola de comandos por la UART de depuración
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "consola.h"
+#include <stddef.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Reduce una posición libre al índice dentro del buffer de recepción.
+#define MASCARA (CONSOLE_RX_SIZE - 1)
+
+//! Lugar que se reserva al final de la respuesta para "...\r\n", el indicador y el cero final.
+#define RESERVA 8
+
+#if (CONSOLE_RX_SIZE & MASCARA) || (CONSOLE_RX_SIZE >= 4096) || (CONSOLE_MAX_LINE >= CONSOLE_RX_SIZE)
+#error "CONSOLE_RX_SIZE debe ser una potencia de dos menor que 4096 y mayor que CONSOLE_MAX_LINE"
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+//! Etapas de atención de una línea. Cada una la cambia una sola de las tareas que usan la consola.
+typedef enum
+{
+    CONSOLA_ESPERANDO, //!< Sin líneas completas, ConsoleReceive busca la próxima.
+    CONSOLA_LINEA,     //!< Hay una línea completa, ConsoleProcess la ejecuta.
+    CONSOLA_RESPUESTA, //!< La respuesta está preparada, ConsoleTransmit la entrega.
+    CONSOLA_ENVIANDO,  //!< La respuesta se está enviando, ConsoleTransmitted libera el buffer.
+} etapa_t;
+
+//! Descriptor de la consola
+struct console_s
+{
+    uint8_t recepcion[CONSOLE_RX_SIZE];  //!< Buffer circular que escribe el DMA.
+    uint8_t respuesta[CONSOLE_TX_SIZE];  //!< Respuesta al último comando.
+    const console_command_t * comandos;  //!< Tabla de comandos de la aplicación.
+    uint8_t cantidad;                    //!< Cantidad de comandos de la tabla.
+    uint16_t escrito;                    //!< Posición de escritura del DMA, sin reducir al tamaño del buffer.
+    uint16_t revisado;                   //!< Posición hasta la que se buscó el fin de línea.
+    uint16_t inicio;                     //!< Comienzo de la línea en curso.
+    uint16_t fin;                        //!< Fin de la línea completa, sin el carácter de fin de línea.
+    uint16_t largo;                      //!< Cantidad de bytes de la respuesta.
+    bool descartando : 1;                //!< Se ignoran los caracteres hasta el próximo fin de línea.
+    bool truncada : 1;                   //!< La respuesta no entró completa en el buffer.
+    etapa_t etapa;                       //!< Etapa de atención, se accede con operaciones atómicas.
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Devuelve el carácter recibido en una posición sin reducir.
+ */
+static inline uint8_t Caracter(console_t console, uint16_t posicion);
+
+/**
+ * @brief Agrega un carácter a la respuesta, si queda lugar.
+ */
+static void Agregar(console_t console, char caracter);
+
+/**
+ * @brief Comienza una respuesta vacía.
+ */
+static void Comenzar(console_t console);
+
+/**
+ * @brief Agrega el indicador y el cero final, y deja la respuesta lista para enviar.
+ */
+static void Terminar(console_t console);
+
+/**
+ * @brief Lista los comandos de la aplicación con su uso.
+ */
+static void Ayuda(console_t console);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+static inline uint8_t Caracter(console_t console, uint16_t posicion)
+{
+    return console->recepcion[posicion & MASCARA];
+}
+
+static void Agregar(console_t console, char caracter)
+{
+    if (console->largo < CONSOLE_TX_SIZE - RESERVA)
+    {
+        console->respuesta[console->largo++] = caracter;
+    }
+    else
+    {
+        console->truncada = true;
+    }
+
+    return;
+}
+
+static void Comenzar(console_t console)
+{
+    console->largo = 0;
+    console->truncada = false;
+
+    return;
+}
+
+static void Terminar(console_t console)
+{
+    static const char FINAL[] = "...\r\n> ";
+    const char * texto = console->truncada ? FINAL : &FINAL[5];
+
+    // La reserva asegura lugar para el final aunque la respuesta se haya truncado
+    while (*texto)
+    {
+        console->respuesta[console->largo++] = *texto++;
+    }
+    console->respuesta[console->largo++] = 0;
+
+    __atomic_store_n(&console->etapa, CONSOLA_RESPUESTA, __ATOMIC_RELEASE);
+
+    return;
+}
+
+static void Ayuda(console_t console)
+{
+    for (int indice = 0; indice < console->cantidad; indice++)
+    {
+        ConsoleWrite(console, console->comandos[indice].help);
+        ConsoleWrite(console, "\n");
+    }
+    ConsoleWrite(console, "ayuda\n");
+
+    return;
+}
+
+/* === Public function implementation ========================================================== */
+
+console_t ConsoleCreate(const console_command_t * commands, uint8_t count)
+{
+    static struct console_s self[1];
+
+    memset(self, 0, sizeof(self));
+    self->comandos = commands;
+    self->cantidad = count;
+    self->etapa = CONSOLA_ESPERANDO;
+
+    return self;
+}
+
+uint8_t * ConsoleGetReceiveBuffer(console_t console, uint16_t * size)
+{
+    *size = sizeof(console->recepcion);
+
+    return console->recepcion;
+}
+
+bool ConsoleReceive(console_t console, uint16_t position)
+{
+    etapa_t etapa = __atomic_load_n(&console->etapa, __ATOMIC_ACQUIRE);
+    uint8_t caracter;
+
+    // El DMA informa un índice dentro del buffer, la posición propia avanza lo recibido desde la llamada anterior
+    console->escrito += (uint16_t)(position - console->escrito) & MASCARA;
+    if (etapa != CONSOLA_ESPERANDO) // Se revisa otra vez después de enviar la respuesta en curso
+    {
+        return false;
+    }
+
+    while (console->revisado != console->escrito)
+    {
+        caracter = Caracter(console, console->revisado++);
+        if ((caracter != '\r') && (caracter != '\n'))
+        {
+            if (!console->descartando && ((uint16_t)(console->revisado - console->inicio) > CONSOLE_MAX_LINE))
+            {
+                console->descartando = true;
+                Comenzar(console);
+                ConsoleWrite(console, "error: linea demasiado larga\n");
+                Terminar(console);
+                return false;
+            }
+            continue;
+        }
+
+        if (console->descartando || ((uint16_t)(console->revisado - 1) == console->inicio))
+        {
+            // Fin de una línea descartada o línea vacía, como el '\n' que sigue a un '\r'
+            console->descartando = false;
+            console->inicio = console->revisado;
+            continue;
+        }
+
+        console->fin = console->revisado - 1;
+        __atomic_store_n(&console->etapa, CONSOLA_LINEA, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    return false;
+}
+
+void ConsoleProcess(console_t console)
+{
+    console_argument_t argumentos[CONSOLE_MAX_ARGUMENTS + 1];
+    uint8_t cantidad = 0;
+    bool separado = true;
+    uint8_t caracter;
+    int indice;
+
+    if (__atomic_load_n(&console->etapa, __ATOMIC_ACQUIRE) != CONSOLA_LINEA)
+    {
+        return;
+    }
+
+    // Separa los argumentos como posiciones dentro del buffer de recepción, sin copiar la línea
+    for (uint16_t posicion = console->inicio; posicion != console->fin; posicion++)
+    {
+        caracter = Caracter(console, posicion);
+        if ((caracter == ' ') || (caracter == '\t'))
+        {
+            separado = true;
+        }
+        else if (separado)
+        {
+            separado = false;
+            if (cantidad <= CONSOLE_MAX_ARGUMENTS)
+            {
+                argumentos[cantidad].start = posicion;
+                argumentos[cantidad].length = 1;
+            }
+            cantidad++;
+        }
+        else if (cantidad <= CONSOLE_MAX_ARGUMENTS + 1)
+        {
+            argumentos[cantidad - 1].length++;
+        }
+    }
+
+    Comenzar(console);
+    if (cantidad == 0)
+    {
+        // Línea con solo espacios, responde el indicador
+    }
+    else if (cantidad > CONSOLE_MAX_ARGUMENTS + 1)
+    {
+        ConsoleWrite(console, "error: demasiados argumentos\n");
+    }
+    else if (ConsoleArgumentIs(console, &argumentos[0], "ayuda"))
+    {
+        Ayuda(console);
+    }
+    else
+    {
+        for (indice = 0; indice < console->cantidad; indice++)
+        {
+            if (ConsoleArgumentIs(console, &argumentos[0], console->comandos[indice].name))
+            {
+                console->comandos[indice].handler(console, cantidad - 1, &argumentos[1]);
+                break;
+            }
+        }
+        if (indice == console->cantidad)
+        {
+            ConsoleWrite(console, "error: comando desconocido, escriba ayuda\n");
+        }
+    }
+
+    // La línea ya no se usa, el DMA puede volver a escribir sobre ella
+    console->inicio = console->fin + 1;
+    console->revisado = console->inicio;
+    Terminar(console);
+
+    return;
+}
+
+uint16_t ConsoleTransmit(console_t console, const uint8_t ** data)
+{
+    if (__atomic_load_n(&console->etapa, __ATOMIC_ACQUIRE) != CONSOLA_RESPUESTA)
+    {
+        return 0;
+    }
+
+    *data = console->respuesta;
+    __atomic_store_n(&console->etapa, CONSOLA_ENVIANDO, __ATOMIC_RELAXED);
+
+    return console->largo;
+}
+
+void ConsoleTransmitted(console_t console)
+{
+    if (__atomic_load_n(&console->etapa, __ATOMIC_RELAXED) == CONSOLA_ENVIANDO)
+    {
+        __atomic_store_n(&console->etapa, CONSOLA_ESPERANDO, __ATOMIC_RELEASE);
+    }
+
+    return;
+}
+
+bool ConsoleIdle(console_t console)
+{
+    return __atomic_load_n(&console->etapa, __ATOMIC_ACQUIRE) == CONSOLA_ESPERANDO;
+}
+
+bool ConsoleArgumentIs(console_t console, const console_argument_t * argument, const char * text)
+{
+    for (int indice = 0; indice < argument->length; indice++)
+    {
+        if (text[indice] != Caracter(console, argument->start + indice)) // También termina en el cero del texto
+        {
+            return false;
+        }
+    }
+
+    return text[argument->length] == 0;
+}
+
+bool ConsoleArgumentNumber(console_t console, const console_argument_t * argument, uint32_t * value)
+{
+    uint32_t numero = 0;
+    uint8_t caracter;
+
+    for (int indice = 0; indice < argument->length; indice++)
+    {
+        caracter = Caracter(console, argument->start + indice);
+        if ((caracter < '0') || (caracter > '9') || (numero > (UINT32_MAX - 9) / 10))
+        {
+            return false;
+        }
+        numero = numero * 10 + (caracter - '0');
+    }
+    *value = numero;
+
+    return true;
+}
+
+uint8_t ConsoleArgumentDigits(console_t console, const console_argument_t * argument, uint8_t * digits, uint8_t size)
+{
+    uint8_t cantidad = 0;
+    uint8_t caracter;
+
+    for (int indice = 0; indice < argument->length; indice++)
+    {
+        caracter = Caracter(console, argument->start + indice);
+        if (caracter == ':')
+        {
+            continue;
+        }
+        if ((caracter < '0') || (caracter > '9') || (cantidad == size))
+        {
+            return 0;
+        }
+        digits[cantidad++] = caracter - '0';
+    }
+
+    return cantidad;
+}
+
+void ConsoleWrite(console_t console, const char * text)
+{
+    while (*text)
+    {
+        if (*text == '\n')
+        {
+            Agregar(console, '\r');
+        }
+        Agregar(console, *text++);
+    }
+
+    return;
+}
+
+void ConsoleWriteNumber(console_t console, uint32_t value, uint8_t decimals)
+{
+    char digitos[10];
+    int cantidad = 0;
+
+    // Los dígitos se obtienen del menos significativo, completando con ceros hasta la unidad
+    do
+    {
+        digitos[cantidad++] = '0' + value % 10;
+        value /= 10;
+    } while ((value != 0) || (cantidad <= decimals));
+
+    while (cantidad > 0)
+    {
+        if (cantidad-- == decimals)
+        {
+            Agregar(console, '.');
+        }
+        Agregar(console, digitos[cantidad]);
+    }
+
+    return;
+}
+
+void ConsoleWriteDigits(console_t console, const uint8_t * digits, uint8_t size)
+{
+    for (int indice = 0; indice < size; indice++)
+    {
+        if ((indice > 0) && (indice % 2 == 0))
+        {
+            Agregar(console, ':');
+        }
+        Agregar(console, '0' + digits[indice]);
+    }
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -30,6 +30,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "controlbcd.h"
+#include "perfil.h"
 
 /* === Macros definitions ====================================================================== */
 
@@ -132,6 +133,7 @@ void DecrementarHora(uint8_t * entrada)
 
 void SecondsIncrement(uint8_t * entrada)
 {
+    PROBE_BEGIN(PROBE_SECONDS_INCREMENT);
     SEGUNDOS_UNI++;
 
     if (SEGUNDOS_UNI > 9)
@@ -169,6 +171,7 @@ void SecondsIncrement(uint8_t * entrada)
         HORAS_DEC = 0;
         HORAS_UNI = 0;
     }
+    PROBE_END(PROBE_SECONDS_INCREMENT);
 }
 
 bool HoraValida(const uint8_t * entrada)
@@ -182,6 +185,27 @@ bool HoraValida(const uint8_t * entrada)
     }
     return valida;
 }
+
+uint32_t HoraASegundos(const uint8_t * entrada)
+{
+    uint32_t horas = HORAS_DEC * 10 + HORAS_UNI;
+    uint32_t minutos = MINUTOS_DEC * 10 + MINUTOS_UNI;
+
+    return (horas * 60 + minutos) * 60 + SEGUNDOS_DEC * 10 + SEGUNDOS_UNI;
+}
+
+void SegundosAHora(uint32_t segundos, uint8_t * entrada)
+{
+    uint32_t minutos = segundos / 60;
+    uint32_t horas = minutos / 60;
+
+    HORAS_DEC = horas / 10;
+    HORAS_UNI = horas % 10;
+    MINUTOS_DEC = (minutos % 60) / 10;
+    MINUTOS_UNI = (minutos % 60) % 10;
+    SEGUNDOS_DEC = (segundos % 60) / 10;
+    SEGUNDOS_UNI = (segundos % 60) % 10;
+}
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen */
@@ -30,17 +30,39 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 #include <stdbool.h>
 #include "chip.h"
+#include "trafico.h"
 #include "digital.h"
+#include "poncho.h"
+#include "pool.h"
 
 /* === Macros definitions ====================================================================== */
 
+// La cantidad de descriptores se toma de los recursos definidos para la placa. El poncho tiene una sola salida
+// discreta, por lo que los grupos solo se pueden formar compilando con más salidas, como hace make bench
 #ifndef OUTPUT_INSTANCES
-#define OUTPUT_INSTANCES 1
+#define OUTPUT_INSTANCES PONCHO_DIGITAL_OUTPUTS
 #endif
 
 #ifndef INPUT_INSTANCES
-#define INPUT_INSTANCES 6
+#define INPUT_INSTANCES PONCHO_DIGITAL_INPUTS
 #endif
+
+#ifndef GROUP_INSTANCES
+#define GROUP_INSTANCES 2
+#endif
+
+// Cantidad máxima de salidas y de puertos GPIO distintos que puede abarcar un grupo
+#ifndef GROUP_MAX_OUTPUTS
+#define GROUP_MAX_OUTPUTS 8
+#endif
+
+#ifndef GROUP_MAX_PORTS
+#define GROUP_MAX_PORTS 4
+#endif
+
+// Cantidad de puertos GPIO del LPC43xx
+#define GPIO_PORT_COUNT 8
+
 /* === Private data type declarations ========================================================== */
 
 // Estructura para almacenar el descriptor de cada entrada digital.
@@ -50,75 +72,120 @@ struct digital_input_s
     uint8_t bit;         // Terminal del puerto GPIO de la entrada digital.
     bool inverted : 1;   // Bandera que indica si funciona con logica inversa.
     bool last_state : 1; // Bandera con el último estado reportado de la entrada.
-    bool allocated : 1;  // Bandera para indicar que el descriptor está en uso.
+    bool sampled : 1;    // Bandera con el último estado leído de la entrada.
+    uint32_t timestamp;  // Tick en el que se leyó por primera vez el estado actual de la entrada.
 };
 
 // Estructura para almacenar el descriptor de cada salida digital.
 struct digital_output_s
 {
-    uint8_t gpio;       // Puerto GPIO de la salida digital.
-    uint8_t bit;        // Terminal del puerto GPIO de la salida digital.
-    bool inverted : 1;  // Bandera que indica si funciona con logica inversa.
-    bool allocated : 1; // Bandera para indicar que el descriptor está en uso.
+    uint8_t gpio;      // Puerto GPIO de la salida digital.
+    uint8_t bit;       // Terminal del puerto GPIO de la salida digital.
+    bool inverted : 1; // Bandera que indica si funciona con logica inversa.
+};
+
+// Estructura para almacenar el descriptor de cada grupo de salidas digitales.
+struct digital_group_s
+{
+    uint8_t count;                        // Cantidad de salidas del grupo.
+    uint8_t ports;                        // Cantidad de puertos GPIO distintos del grupo.
+    uint8_t gpio[GROUP_MAX_PORTS];        // Puerto GPIO de cada entrada de la tabla de puertos.
+    uint32_t inverted[GROUP_MAX_PORTS];   // Terminales con logica inversa de cada puerto.
+    uint8_t port[GROUP_MAX_OUTPUTS];      // Índice en la tabla de puertos de cada salida del grupo.
+    uint32_t pin_mask[GROUP_MAX_OUTPUTS]; // Máscara del terminal de cada salida del grupo.
 };
 
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
-digital_output_t DigitalOutputAllocate(void);
-
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
 
+// Los descriptores se crean solo al inicializar la placa, por lo que los pools no necesitan secciones críticas
+POOL_DEFINE(inputs, struct digital_input_s, INPUT_INSTANCES);
+POOL_DEFINE(outputs, struct digital_output_s, OUTPUT_INSTANCES);
+POOL_DEFINE(groups, struct digital_group_s, GROUP_INSTANCES);
+
+// Último valor escrito en el registro MASK de cada puerto, este módulo es el único que lo usa
+static uint32_t port_masks[GPIO_PORT_COUNT] = {0};
+
+static digital_timebase_t timebase = NULL;
+static digital_recorder_t recorder = NULL;
+
 /* === Private function implementation ========================================================= */
 
-digital_input_t DigitalInputAllocate(void)
+// Acumula por puerto los terminales de las salidas del grupo seleccionadas en la máscara.
+static void DigitalGroupCollect(digital_group_t group, uint32_t mask, uint32_t pins[GROUP_MAX_PORTS])
 {
-    digital_input_t input = NULL;
-
-    static struct digital_input_s instances[INPUT_INSTANCES] = {0};
+    for (int index = 0; index < group->ports; index++)
+    {
+        pins[index] = 0;
+    }
 
-    for (int i = 0; i < INPUT_INSTANCES; i++)
+    for (int index = 0; index < group->count; index++)
     {
-        if (!instances[i].allocated) // El descriptor no esta en uso
+        if (mask & (1UL << index))
         {
-            instances[i].allocated = true;
-            input = &instances[i];
-            break;
+            pins[group->port[index]] |= group->pin_mask[index];
         }
     }
 
-    return input;
+    return;
 }
 
-digital_output_t DigitalOutputAllocate(void)
+// Lleva los terminales de un puerto al nivel indicado en una única escritura, aunque unos suban y otros bajen.
+static void DigitalGroupWrite(uint8_t gpio, uint32_t pins, uint32_t high)
 {
-    digital_output_t output = NULL;
-
-    static struct digital_output_s instances[OUTPUT_INSTANCES] = {0};
-
-    for (int i = 0; i < OUTPUT_INSTANCES; i++)
+    if (high == pins)
     {
-        if (!instances[i].allocated) // El descriptor no esta en uso
+        Chip_GPIO_SetValue(LPC_GPIO_PORT, gpio, pins);
+    }
+    else if (high == 0)
+    {
+        Chip_GPIO_ClearValue(LPC_GPIO_PORT, gpio, pins);
+    }
+    else
+    {
+        // En MPIN solo se escriben los terminales con el bit en cero en MASK, que se cambia solo si hace falta. Una
+        // interrupción entre las dos escrituras podría cambiar la máscara, por lo que el par se hace sin interrupciones
+        uint32_t primask = __get_PRIMASK();
+
+        __disable_irq();
+        if (port_masks[gpio] != ~pins)
         {
-            instances[i].allocated = true;
-            output = &instances[i];
-            break;
+            port_masks[gpio] = ~pins;
+            Chip_GPIO_SetPortMask(LPC_GPIO_PORT, gpio, ~pins);
         }
+        Chip_GPIO_SetMaskedPortValue(LPC_GPIO_PORT, gpio, high);
+        __set_PRIMASK(primask);
     }
 
-    return output;
+    return;
 }
 
 /* === Public function implementation ========================================================== */
 
 /*********Entradas**********/
 
+void DigitalSetTimebase(digital_timebase_t function)
+{
+    timebase = function;
+
+    return;
+}
+
+void DigitalSetRecorder(digital_recorder_t function)
+{
+    recorder = function;
+
+    return;
+}
+
 digital_input_t DigitalInputCreate(uint8_t gpio, uint8_t bit, bool inverted)
 {
-    digital_input_t input = DigitalInputAllocate();
+    digital_input_t input = PoolAllocate(inputs);
 
     if (input) // Si input=NULL no crea entrada y retorna NULL
     {
@@ -131,6 +198,16 @@ digital_input_t DigitalInputCreate(uint8_t gpio, uint8_t bit, bool inverted)
     return input;
 }
 
+void DigitalInputDestroy(digital_input_t input)
+{
+    if (input)
+    {
+        PoolRelease(inputs, input);
+    }
+
+    return;
+}
+
 bool DigitalInputGetState(digital_input_t input)
 {
     bool resultado = 0;
@@ -138,6 +215,41 @@ bool DigitalInputGetState(digital_input_t input)
     if (input)
     {
         resultado = input->inverted ^ Chip_GPIO_ReadPortBit(LPC_GPIO_PORT, input->gpio, input->bit);
+
+        if (resultado != input->sampled) // Primera lectura de un flanco, guarda el momento en que se detectó
+        {
+            input->sampled = resultado;
+            input->timestamp = timebase ? timebase() : 0;
+            if (recorder)
+            {
+                recorder(input->gpio, input->bit, resultado ^ input->inverted, input->timestamp);
+            }
+        }
+    }
+
+    return resultado;
+}
+
+uint32_t DigitalInputGetTimestamp(digital_input_t input)
+{
+    uint32_t resultado = 0;
+
+    if (input)
+    {
+        resultado = input->timestamp;
+    }
+
+    return resultado;
+}
+
+bool DigitalInputGetEvent(digital_input_t input, digital_event_t * event)
+{
+    bool resultado = DigitalInputHasChanged(input);
+
+    if (resultado)
+    {
+        event->active = input->last_state;
+        event->timestamp = input->timestamp;
     }
 
     return resultado;
@@ -189,7 +301,7 @@ bool DigitalInputHasDeactivated(digital_input_t input)
 
 digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool inverted)
 {
-    digital_output_t output = DigitalOutputAllocate();
+    digital_output_t output = PoolAllocate(outputs);
 
     if (output) // Si output=NULL no crea salida y retorna NULL
     {
@@ -203,6 +315,17 @@ digital_output_t DigitalOutputCreate(uint8_t gpio, uint8_t bit, bool inverted)
     return output;
 }
 
+void DigitalOutputDestroy(digital_output_t output)
+{
+    if (output)
+    {
+        DigitalOutputDeactivate(output); // La salida liberada queda en estado inactivo
+        PoolRelease(outputs, output);
+    }
+
+    return;
+}
+
 void DigitalOutputActivate(digital_output_t output)
 {
     if (output)
@@ -233,6 +356,154 @@ void DigitalOutputToggle(digital_output_t output)
     return;
 }
 
+/*********Grupos de salidas**********/
+
+digital_group_t DigitalGroupCreate(const digital_output_t * members, uint8_t count)
+{
+    digital_group_t group = NULL;
+
+    if (members && (count > 0) && (count <= GROUP_MAX_OUTPUTS))
+    {
+        group = PoolAllocate(groups);
+    }
+
+    if (group) // Si group=NULL no crea el grupo y retorna NULL
+    {
+        for (int index = 0; index < count; index++)
+        {
+            digital_output_t output = members[index];
+            int port = 0;
+
+            if (!output)
+            {
+                break;
+            }
+
+            while ((port < group->ports) && (group->gpio[port] != output->gpio))
+            {
+                port++;
+            }
+
+            if (port == GROUP_MAX_PORTS)
+            {
+                break;
+            }
+            else if (port == group->ports) // Primera salida del grupo en este puerto
+            {
+                group->gpio[port] = output->gpio;
+                group->ports++;
+            }
+
+            group->port[index] = port;
+            group->pin_mask[index] = 1UL << output->bit;
+            if (output->inverted)
+            {
+                group->inverted[port] |= group->pin_mask[index];
+            }
+            group->count++;
+        }
+
+        if (group->count != count) // Alguna salida es inválida o hay demasiados puertos
+        {
+            PoolRelease(groups, group);
+            group = NULL;
+        }
+    }
+
+    return group;
+}
+
+void DigitalGroupDestroy(digital_group_t group)
+{
+    if (group)
+    {
+        PoolRelease(groups, group);
+    }
+
+    return;
+}
+
+void DigitalGroupActivate(digital_group_t group, uint32_t mask)
+{
+    uint32_t pins[GROUP_MAX_PORTS];
+
+    if (group)
+    {
+        DigitalGroupCollect(group, mask, pins);
+        for (int index = 0; index < group->ports; index++)
+        {
+            // Las salidas con logica inversa se activan con el terminal en nivel bajo
+            if (pins[index])
+            {
+                DigitalGroupWrite(group->gpio[index], pins[index], pins[index] & ~group->inverted[index]);
+            }
+        }
+    }
+
+    return;
+}
+
+void DigitalGroupDeactivate(digital_group_t group, uint32_t mask)
+{
+    uint32_t pins[GROUP_MAX_PORTS];
+
+    if (group)
+    {
+        DigitalGroupCollect(group, mask, pins);
+        for (int index = 0; index < group->ports; index++)
+        {
+            // Las salidas con logica inversa se desactivan con el terminal en nivel alto
+            if (pins[index])
+            {
+                DigitalGroupWrite(group->gpio[index], pins[index], pins[index] & group->inverted[index]);
+            }
+        }
+    }
+
+    return;
+}
+
+void DigitalGroupToggle(digital_group_t group, uint32_t mask)
+{
+    uint32_t pins[GROUP_MAX_PORTS];
+
+    if (group)
+    {
+        DigitalGroupCollect(group, mask, pins);
+        for (int index = 0; index < group->ports; index++)
+        {
+            if (pins[index])
+            {
+                Chip_GPIO_SetPortToggle(LPC_GPIO_PORT, group->gpio[index], pins[index]);
+            }
+        }
+    }
+
+    return;
+}
+
+/*********Estadísticas**********/
+
+void DigitalGetStats(pool_stats_t * inputs_stats, pool_stats_t * outputs_stats, pool_stats_t * groups_stats)
+{
+    if (inputs_stats)
+    {
+        PoolGetStats(inputs, inputs_stats);
+    }
+
+    if (outputs_stats)
+    {
+        PoolGetStats(outputs, outputs_stats);
+    }
+
+    if (groups_stats)
+    {
+        PoolGetStats(groups, groups_stats);
+    }
+
+    return;
+}
+
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen */
@@ -0,0 +1,185 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Estadísticas de uso del procesador por tarea
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "estadisticas.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if defined(__arm__)
+#include "chip.h"
+#else
+#include <time.h>
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+#if defined(__arm__)
+// Temporizador libre que sirve de base de tiempo, con el prescaler ajustado para contar microsegundos
+#define CPU_STATS_TIMER       LPC_TIMER3
+#define CPU_STATS_TIMER_CLOCK CLK_MX_TIMER3
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+// Contadores de una tarea, el descriptor de FreeRTOS se usa como clave
+typedef struct
+{
+    void * handle;
+    uint32_t switches;
+    uint32_t switches_reported;
+    uint32_t runtime_reported;
+} contador_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static contador_t * BuscarContador(void * handle);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static contador_t contadores[CPU_STATS_MAX_TASKS];
+static uint32_t total_reported = 0;
+
+/* === Private function implementation ========================================================= */
+
+static contador_t * BuscarContador(void * handle)
+{
+    contador_t * libre = NULL;
+
+    for (int index = 0; index < CPU_STATS_MAX_TASKS; index++)
+    {
+        if (contadores[index].handle == handle)
+        {
+            return &contadores[index];
+        }
+        if (!libre && !contadores[index].handle)
+        {
+            libre = &contadores[index];
+        }
+    }
+
+    if (libre) // Primera vez que se ve la tarea
+    {
+        libre->handle = handle;
+    }
+
+    return libre;
+}
+
+/* === Public function implementation ========================================================== */
+
+#if defined(__arm__)
+void CpuStatsTimerInit(void)
+{
+    Chip_TIMER_Init(CPU_STATS_TIMER);
+    Chip_TIMER_PrescaleSet(CPU_STATS_TIMER, Chip_Clock_GetRate(CPU_STATS_TIMER_CLOCK) / 1000000 - 1);
+    Chip_TIMER_Reset(CPU_STATS_TIMER);
+    Chip_TIMER_Enable(CPU_STATS_TIMER);
+}
+
+uint32_t CpuStatsTimerRead(void)
+{
+    // Sin coincidencias configuradas el contador recorre los 32 bits, como esperan las restas de FreeRTOS
+    return Chip_TIMER_ReadCount(CPU_STATS_TIMER);
+}
+#else
+void CpuStatsTimerInit(void)
+{
+}
+
+uint32_t CpuStatsTimerRead(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint32_t)(ahora.tv_sec * 1000000ULL + ahora.tv_nsec / 1000); // Microsegundos
+}
+#endif
+
+void CpuStatsSwitchedIn(void * task)
+{
+    contador_t * contador = BuscarContador(task);
+
+    if (contador)
+    {
+        contador->switches++;
+    }
+}
+
+void CpuStatsGet(cpu_stats_t * stats)
+{
+    static TaskStatus_t estados[CPU_STATS_MAX_TASKS];
+    uint32_t total;
+    UBaseType_t cantidad;
+    TaskHandle_t inactiva = xTaskGetIdleTaskHandle();
+
+    memset(stats, 0, sizeof(*stats));
+
+    vTaskSuspendAll();
+    cantidad = uxTaskGetSystemState(estados, CPU_STATS_MAX_TASKS, &total);
+
+    // Las restas en aritmética modular siguen siendo válidas si la base de tiempo desbordó una vez
+    stats->interval = total - total_reported;
+    total_reported = total;
+
+    for (UBaseType_t index = 0; index < cantidad; index++)
+    {
+        contador_t * contador = BuscarContador(estados[index].xHandle);
+        cpu_task_stats_t * tarea = &stats->task[stats->tasks];
+
+        tarea->name = estados[index].pcTaskName;
+        if (contador)
+        {
+            tarea->runtime = estados[index].ulRunTimeCounter - contador->runtime_reported;
+            tarea->switches = contador->switches - contador->switches_reported;
+            contador->runtime_reported = estados[index].ulRunTimeCounter;
+            contador->switches_reported = contador->switches;
+        }
+        if (stats->interval)
+        {
+            tarea->load = (uint64_t)tarea->runtime * 1000 / stats->interval;
+        }
+        if (estados[index].xHandle == inactiva)
+        {
+            stats->idle = tarea->load;
+        }
+
+        stats->switches += tarea->switches;
+        stats->tasks++;
+    }
+    xTaskResumeAll();
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,117 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Grabación de los cambios de las entradas digitales
+ **
+ ** \addtogroup grabacion GRABACION
+ ** \brief Grabación y reproducción de las entradas
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "grabacion.h"
+
+/* === Macros definitions ====================================================================== */
+
+//! Mayor demora que cabe en un registro.
+#define DEMORA_MAXIMA UINT16_MAX
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Agrega un registro, o cuenta el cambio como descartado si el buffer está lleno.
+ *
+ * @return true El registro se guardó.
+ */
+static bool Agregar(uint16_t delay, uint8_t pin, uint8_t level);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static recording_buffer_t grabacion = {
+    .magic = RECORDING_MAGIC,
+    .capacity = RECORDING_ENTRIES,
+    .entry_size = sizeof(recording_entry_t),
+};
+
+//! Tick del último registro guardado.
+static uint32_t ultimo = 0;
+
+/* === Private function implementation ========================================================= */
+
+static bool Agregar(uint16_t delay, uint8_t pin, uint8_t level)
+{
+    recording_entry_t * entry;
+
+    if (grabacion.written == RECORDING_ENTRIES)
+    {
+        grabacion.dropped++;
+        return false;
+    }
+
+    entry = &grabacion.entries[grabacion.written++];
+    entry->delay = delay;
+    entry->pin = pin;
+    entry->level = level;
+
+    return true;
+}
+
+/* === Public function implementation ========================================================== */
+
+void RecordingSample(uint8_t gpio, uint8_t bit, bool level, uint32_t timestamp)
+{
+    uint32_t demora = timestamp - ultimo;
+
+    // Las esperas largas, como la noche entera sin tocar las teclas, se parten en pausas de la mayor demora posible
+    while ((demora > DEMORA_MAXIMA) && Agregar(DEMORA_MAXIMA, RECORDING_PAUSE, 0))
+    {
+        demora -= DEMORA_MAXIMA;
+        ultimo += DEMORA_MAXIMA;
+    }
+
+    if (demora > DEMORA_MAXIMA) // El buffer se llenó con las pausas
+    {
+        grabacion.dropped++;
+    }
+    else if (Agregar(demora, RECORDING_PIN(gpio, bit), level))
+    {
+        ultimo = timestamp;
+    }
+
+    return;
+}
+
+const void * RecordingGetBuffer(size_t * size)
+{
+    *size = sizeof(grabacion);
+
+    return &grabacion;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,125 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Histogramas de intervalos fijos para mediciones de tiempo
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "histograma.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void HistogramRecord(histogram_t histogram, uint32_t value)
+{
+    uint32_t index = value / histogram->width;
+
+    if (index >= histogram->count)
+    {
+        index = histogram->count - 1;
+    }
+
+    histogram->buckets[index]++;
+    histogram->samples++;
+    histogram->sum += value;
+
+    if (value < histogram->min)
+    {
+        histogram->min = value;
+    }
+
+    if (value > histogram->max)
+    {
+        histogram->max = value;
+    }
+
+    return;
+}
+
+void HistogramReset(histogram_t histogram)
+{
+    memset(histogram->buckets, 0, histogram->count * sizeof(histogram->buckets[0]));
+    histogram->samples = 0;
+    histogram->sum = 0;
+    histogram->min = UINT32_MAX;
+    histogram->max = 0;
+
+    return;
+}
+
+void HistogramGetStats(histogram_t histogram, histogram_stats_t * stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    if (histogram->samples)
+    {
+        // Cantidad de muestras que deben quedar por debajo del percentil 99, redondeada hacia arriba
+        uint32_t limite = histogram->samples - histogram->samples / 100;
+        uint32_t acumuladas = 0;
+        uint16_t index = 0;
+
+        while (index < histogram->count - 1)
+        {
+            acumuladas += histogram->buckets[index];
+            if (acumuladas >= limite)
+            {
+                break;
+            }
+            index++;
+        }
+
+        stats->samples = histogram->samples;
+        stats->min = histogram->min;
+        stats->mean = histogram->sum / histogram->samples;
+        stats->max = histogram->max;
+
+        // El último intervalo no tiene límite superior, y ningún percentil supera al máximo
+        stats->p99 = (index + 1) * histogram->width - 1;
+        if ((index == histogram->count - 1) || (stats->p99 > histogram->max))
+        {
+            stats->p99 = histogram->max;
+        }
+    }
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -43,19 +43,73 @@
 #include "bspreloj.h"
 #include "reloj.h"
 #include "controlbcd.h"
+#include "histograma.h"
+#include "perfil.h"
+#include "traza.h"
+#include "grabacion.h"
+#include "trafico.h"
+#include "periodo.h"
+#include "telemetria.h"
+#include "consola.h"
+#include "memoria.h"
+#include "ajustes.h"
+#include "tiempo.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#if (RUN_TIME_STATS == 1)
+#include "estadisticas.h"
+#endif
 
 /* === Macros definitions ====================================================================== */
 
 #define ParpadearDigitos(from, to, frec) DisplayFlashDigits(board->display, from, to, frec)
 #define AlternarPunto(punto)             DisplayToggleDot(board->display, punto)
+#define MarcarCuadro(evento)             DisplayStampFrame(board->display, (evento)->timestamp)
 
-// Tamaño de la pila de cada tarea
+// Tamaño de la pila de la tarea principal, la compilación para la computadora la agranda
+#ifndef PILA_TAREA_PRINCIPAL
 #define PILA_TAREA_PRINCIPAL 512
-#define PILA_TAREA_REFRESCO  256
+#endif
+
+// Identificador del barrido en los eventos de plazo vencido de la traza
+#define TRAZA_BARRIDO 1
+
+// Cantidad de eventos que puede acumular la cola de la tarea principal
+#define COLA_EVENTOS 8
+
+// Cantidad de dígitos BCD de una hora
+#define TAMANIO_HORA 6
+
+// Tiempos de la interfaz de usuario en milisegundos
+#define TIEMPO_PULSACION_LARGA 3000
+#define TIEMPO_INACTIVIDAD     30000
+
+// Velocidad de la UART de depuración, compartida por la telemetría y la consola
+#define VELOCIDAD_UART 115200
+
+// Duración de la prueba de pantalla y zumbador del comando prueba, en milisegundos
+#define TIEMPO_PRUEBA 2000
+
+// Menor cantidad de bytes libres en la pila de una tarea que el comando prueba considera correcta
+#define MARGEN_PILA 64
+
+// Período del temporizador de barrido detenido con la pantalla apagada: un segundo del reloj, en milisegundos
+#define PERIODO_PANTALLA_APAGADA 1000
+
+// Pasadas del barrido que leen las teclas con entrada propia después de cada flanco, más largas que los rebotes
+#define PASADAS_TECLAS 50
+
+// Bit del mapa del teclado matricial de una tecla de ajuste: su fila, en el orden de tecla_t, en la columna del primer
+// dígito de la pantalla
+#define TECLA_MATRIZ(tecla) (1 << (tecla))
+
+// Transición que no cambia de modo ni ejecuta ninguna acción
+#define SIN_TRANSICION {NULL, MODO_ACTUAL}
 
 /* === Private data type declarations ========================================================== */
 
@@ -67,17 +121,158 @@ typedef enum
     AJUSTANDO_HORAS_ACTUAL,
     AJUSTANDO_MINUTOS_ALARMA,
     AJUSTANDO_HORAS_ALARMA,
+    PANTALLA_APAGADA,
+    MODOS_CANTIDAD,
+    MODO_ACTUAL = MODOS_CANTIDAD, // Destino de una transición que no cambia de modo
+    MODO_RESTAURAR,               // Destino que depende de la validez de la hora actual
 } modo_t;
 
+// Teclas del poncho en el orden en que las lee el barrido
+typedef enum
+{
+    TECLA_AJUSTAR_TIEMPO,
+    TECLA_AJUSTAR_ALARMA,
+    TECLA_DECREMENTAR,
+    TECLA_INCREMENTAR,
+    TECLA_ACEPTAR,
+    TECLA_CANCELAR,
+    TECLAS_CANTIDAD,
+} tecla_t;
+
+// Eventos de la máquina de estados de la interfaz, los de teclas conservan el valor de tecla_t
+typedef enum
+{
+    UI_AJUSTAR_TIEMPO = TECLA_AJUSTAR_TIEMPO, // Pulsación larga
+    UI_AJUSTAR_ALARMA = TECLA_AJUSTAR_ALARMA, // Pulsación larga
+    UI_DECREMENTAR = TECLA_DECREMENTAR,
+    UI_INCREMENTAR = TECLA_INCREMENTAR,
+    UI_ACEPTAR = TECLA_ACEPTAR,
+    UI_CANCELAR = TECLA_CANCELAR,
+    UI_INACTIVIDAD,
+    UI_ALARMA, // La alarma comenzó a sonar
+    UI_EVENTOS,
+} ui_evento_t;
+
+// Tipos de eventos que recibe la tarea principal
+typedef enum
+{
+    EVENTO_TECLA_PRESIONADA, // valor: tecla presionada
+    EVENTO_TECLA_LIBERADA,   // valor: tecla liberada
+    EVENTO_RELOJ,            // valor: verdadero en la segunda mitad de cada segundo
+    EVENTO_ALARMA,           // valor: verdadero si la alarma comienza a sonar
+    EVENTO_CONSOLA,          // valor: sin uso, hay una línea de la consola para ejecutar
+    EVENTO_PLAZO,            // valor: plazo que venció, la tarea principal comprueba si sigue pendiente
+} evento_tipo_t;
+
+// Plazos de la tarea principal, cada uno con un temporizador de un disparo que solo actúa al vencer
+typedef enum
+{
+    PLAZO_PULSACION,   // Pulsación larga de una tecla de ajuste
+    PLAZO_INACTIVIDAD, // Tiempo sin actividad del usuario
+    PLAZO_PRUEBA,      // Fin de la prueba de pantalla y zumbador
+    PLAZOS_CANTIDAD,
+} plazo_t;
+
+// Evento enviado a la tarea principal
+typedef struct
+{
+    evento_tipo_t tipo;
+    uint8_t valor;
+    uint32_t timestamp; // Milisegundos desde el arranque en que se produjo el evento, de UptimeStamp
+} evento_t;
+
+// Acción de la máquina de estados de la interfaz
+typedef void (*accion_t)(void);
+
+// Configuración de cada modo de la interfaz
+typedef struct
+{
+    uint8_t parpadeo_desde;   // Primer dígito que parpadea
+    uint8_t parpadeo_hasta;   // Último dígito que parpadea
+    uint16_t parpadeo_factor; // Factor de división del parpadeo, cero si no parpadea
+    bool muestra_hora : 1;    // La pantalla muestra la hora actual
+    bool muestra_puntos : 1;  // La pantalla muestra todos los puntos
+    accion_t entrada;         // Acción al entrar al modo
+    accion_t salida;          // Acción al salir del modo
+} estado_t;
+
+// Transición de la máquina de estados de la interfaz
+typedef struct
+{
+    accion_t accion;  // Acción de la transición, NULL si no hay
+    modo_t siguiente; // Modo siguiente, MODO_ACTUAL si no cambia
+} transicion_t;
+
 /* === Private variable declarations =========================================================== */
 
 /* === Private function declarations =========================================================== */
 
 void ActivarAlarma(bool estado);
 void CambiarModo(modo_t valor);
+void Despachar(ui_evento_t evento);
+bool TieneTransicion(ui_evento_t evento);
+void RegistrarLatencia(uint32_t timestamp);
+void EnviarEvento(evento_tipo_t tipo, uint8_t valor, uint32_t timestamp);
+void MostrarHora(void);
+void MostrarEntrada(void);
+TickType_t TiempoRestante(uint64_t limite, uint64_t ahora);
+void ArmarPlazo(plazo_t plazo, uint64_t limite);
+void DesarmarPlazo(plazo_t plazo);
+
+static void PosponerOHabilitarAlarma(void);
+static void CancelarODeshabilitarAlarma(void);
+static void CargarHora(void);
+static void CargarAlarma(void);
+static void GuardarHora(void);
+static void GuardarAlarma(void);
+static void SumarMinuto(void);
+static void RestarMinuto(void);
+static void SumarHora(void);
+static void RestarHora(void);
+static void ApagarPantalla(void);
+static void EncenderPantalla(void);
+static void AvanzarReloj(uint32_t timestamp, uint32_t milisegundos);
+static bool Barrer(uint32_t timestamp);
+#if (LOW_POWER == 1)
+static void DetenerBarrido(void);
+static void ProgramarSegundo(void);
+static void ReanudarBarrido(void);
+#endif
+static void TerminarPrueba(void);
+#if (SETTINGS == 1)
+static void RestaurarAjustes(void);
+static void GuardarAjustes(void);
+#endif
 
 static void TareaPrincipal(void * pvParameters);
-static void TareaRefresco(void * pvParameters);
+static void VencerPlazo(TimerHandle_t temporizador);
+static void InterrupcionBarrido(void);
+static void CambiarTecla(void);
+#if (TELEMETRY == 1)
+static void EnviarTelemetria(TimerHandle_t temporizador);
+#endif
+#if (CONSOLE == 1)
+static void RecibirConsola(void);
+static void TerminarEnvio(void);
+static void EnviarRespuesta(void);
+static bool LeerHora(console_t consola, const console_argument_t * argumento, uint8_t * hora);
+static void ComandoHora(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void ComandoAlarma(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void ComandoEstado(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void EscribirDescriptores(console_t consola, const char * nombre, const pool_stats_t * uso);
+static void ComandoPrueba(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+#if (TELEMETRY == 1)
+static void ComandoTelemetria(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+#endif
+#if (GPIO_ACCOUNTING == 1)
+static void ComandoTrafico(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void EscribirTrafico(console_t consola, const traffic_counts_t * accesos);
+#endif
+#if (PROFILING == 1)
+static void ComandoSondas(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void EscribirDuracion(console_t consola, uint32_t duracion);
+#endif
+#endif
 
 /* === Public variable definitions ============================================================= */
 
@@ -85,12 +280,211 @@ static board_t board;
 static clock_t reloj;
 static modo_t modo;
 static bool AlarmaActivada = 0;
-static uint32_t count3s = 0;
-static uint32_t count30s = 0;
-// static uint8_t entrada[6] = {0, 0, 0, 0, 0, 0};
+static bool MedioSegundo = 0;
+static QueueHandle_t eventos;
+static digital_input_t teclas[TECLAS_CANTIDAD];
+static uint8_t entrada[TAMANIO_HORA] = {0, 0, 0, 0, 0, 0};
+
+// Prueba de pantalla y zumbador del comando prueba en curso, y momento en que termina
+static bool prueba_en_curso = false;
+static uint64_t prueba_limite = 0;
+
+// Temporizadores de los plazos de la tarea principal
+static TimerHandle_t plazos[PLAZOS_CANTIDAD];
+
+// Latencia entre el flanco de una tecla y el primer cuadro que muestra la respuesta, en ticks
+HISTOGRAM_DEFINE(latencia, 128, 2);
+
+// Cantidad de veces que se despertó la tarea principal, de pasadas del barrido y de eventos descartados por tener la
+// cola llena
+static uint32_t despertares_principal = 0;
+static uint32_t despertares_barrido = 0;
+static uint32_t eventos_perdidos = 0;
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+// Nombre de la tarea que desbordó su pila, lo completa el gancho de FreeRTOS antes de detener el sistema
+static const char * volatile tarea_desbordada = NULL;
+#endif
+
+// Pasadas del barrido que todavía leen las teclas con entrada propia, arranca abierta para ver las ya presionadas
+static volatile uint8_t lecturas_teclas = PASADAS_TECLAS;
+
+// Milisegundos que avanzó el reloj desde su último cambio de segundo
+static uint32_t fase_segundo = 0;
+
+#if (LOW_POWER == 1)
+// Con la pantalla apagada el barrido se detiene en cuanto no quedan teclas presionadas ni rebotando
+static volatile bool pantalla_apagada = false;
+static volatile bool barrido_detenido = false;
+
+// Milisegundos hasta la próxima interrupción con el barrido detenido, la del cambio de segundo siguiente
+static uint32_t periodo_detenido = PERIODO_PANTALLA_APAGADA;
+#else
+// Retraso de cada interrupción de barrido, en intervalos de 1% del período
+PERIOD_MONITOR_DEFINE(barrido, 128, 10);
+#endif
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+// Memoria de la tarea y de la cola cuando FreeRTOS no tiene heap
+static StackType_t pila_principal[PILA_TAREA_PRINCIPAL];
+static StaticTask_t control_principal;
+static uint8_t cola_memoria[COLA_EVENTOS * sizeof(evento_t)];
+static StaticQueue_t cola_control;
+static StaticTimer_t control_plazos[PLAZOS_CANTIDAD];
+#if (TELEMETRY == 1)
+static StaticTimer_t control_telemetria;
+#endif
+#endif
+
+#if (RUN_TIME_STATS == 1)
+// Último uso del procesador medido, lo actualiza la telemetría en cada envío y lo muestra la consola
+static cpu_stats_t carga;
+#endif
+
+#if (TELEMETRY == 1)
+// Tramas de estado y de traza que lee el DMA de la UART, y cantidad de envíos omitidos por tenerla ocupada
+static uint8_t telemetria[2 * TELEMETRY_MAX_FRAME];
+static uint32_t telemetria_omitida = 0;
+static TimerHandle_t temporizador_telemetria;
+// Con la consola empieza deshabilitada: comparten la UART y el texto se mezclaría con las tramas
+static bool telemetria_habilitada = (CONSOLE == 0);
+#if (CONSOLE == 1)
+static bool respuesta_en_curso = false; // Detiene la telemetría desde que llega una línea hasta que sale su respuesta
+#endif
+#endif
+
+#if (CONSOLE == 1)
+static console_t consola;
+#endif
 
 /* === Private variable definitions ============================================================ */
 
+// Configuración de cada modo, indexada por modo_t
+static const estado_t ESTADOS[MODOS_CANTIDAD] = {
+    [SIN_CONFIGURAR] = {0, 3, 200, true, false, NULL, NULL},
+    [MOSTRANDO_HORA] = {0, 0, 0, true, false, NULL, NULL},
+    [AJUSTANDO_MINUTOS_ACTUAL] = {2, 3, 200, false, false, MostrarEntrada, NULL},
+    [AJUSTANDO_HORAS_ACTUAL] = {0, 1, 200, false, false, MostrarEntrada, NULL},
+    [AJUSTANDO_MINUTOS_ALARMA] = {2, 3, 200, false, true, MostrarEntrada, NULL},
+    [AJUSTANDO_HORAS_ALARMA] = {0, 1, 100, false, true, MostrarEntrada, NULL},
+    [PANTALLA_APAGADA] = {0, 0, 0, false, false, ApagarPantalla, EncenderPantalla},
+};
+
+// Tabla de transiciones indexada por modo y evento, cada fila enumera todos los eventos
+static const transicion_t TRANSICIONES[MODOS_CANTIDAD][UI_EVENTOS] = {
+    [SIN_CONFIGURAR] =
+        {
+            [UI_AJUSTAR_TIEMPO] = {CargarHora, AJUSTANDO_MINUTOS_ACTUAL},
+            [UI_AJUSTAR_ALARMA] = {CargarAlarma, AJUSTANDO_MINUTOS_ALARMA},
+            [UI_DECREMENTAR] = SIN_TRANSICION,
+            [UI_INCREMENTAR] = SIN_TRANSICION,
+            [UI_ACEPTAR] = SIN_TRANSICION,
+            [UI_CANCELAR] = {NULL, MODO_RESTAURAR},
+            [UI_INACTIVIDAD] = SIN_TRANSICION,
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [MOSTRANDO_HORA] =
+        {
+            [UI_AJUSTAR_TIEMPO] = {CargarHora, AJUSTANDO_MINUTOS_ACTUAL},
+            [UI_AJUSTAR_ALARMA] = {CargarAlarma, AJUSTANDO_MINUTOS_ALARMA},
+            [UI_DECREMENTAR] = SIN_TRANSICION,
+            [UI_INCREMENTAR] = SIN_TRANSICION,
+            [UI_ACEPTAR] = {PosponerOHabilitarAlarma, MODO_ACTUAL},
+            [UI_CANCELAR] = {CancelarODeshabilitarAlarma, MODO_ACTUAL},
+#if (LOW_POWER == 1)
+            [UI_INACTIVIDAD] = {NULL, PANTALLA_APAGADA},
+#else
+            [UI_INACTIVIDAD] = SIN_TRANSICION,
+#endif
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [AJUSTANDO_MINUTOS_ACTUAL] =
+        {
+            [UI_AJUSTAR_TIEMPO] = SIN_TRANSICION,
+            [UI_AJUSTAR_ALARMA] = SIN_TRANSICION,
+            [UI_DECREMENTAR] = {RestarMinuto, MODO_ACTUAL},
+            [UI_INCREMENTAR] = {SumarMinuto, MODO_ACTUAL},
+            [UI_ACEPTAR] = {NULL, AJUSTANDO_HORAS_ACTUAL},
+            [UI_CANCELAR] = {NULL, MODO_RESTAURAR},
+            [UI_INACTIVIDAD] = {NULL, MODO_RESTAURAR},
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [AJUSTANDO_HORAS_ACTUAL] =
+        {
+            [UI_AJUSTAR_TIEMPO] = SIN_TRANSICION,
+            [UI_AJUSTAR_ALARMA] = SIN_TRANSICION,
+            [UI_DECREMENTAR] = {RestarHora, MODO_ACTUAL},
+            [UI_INCREMENTAR] = {SumarHora, MODO_ACTUAL},
+            [UI_ACEPTAR] = {GuardarHora, MOSTRANDO_HORA},
+            [UI_CANCELAR] = {NULL, MODO_RESTAURAR},
+            [UI_INACTIVIDAD] = {NULL, MODO_RESTAURAR},
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [AJUSTANDO_MINUTOS_ALARMA] =
+        {
+            [UI_AJUSTAR_TIEMPO] = SIN_TRANSICION,
+            [UI_AJUSTAR_ALARMA] = SIN_TRANSICION,
+            [UI_DECREMENTAR] = {RestarMinuto, MODO_ACTUAL},
+            [UI_INCREMENTAR] = {SumarMinuto, MODO_ACTUAL},
+            [UI_ACEPTAR] = {NULL, AJUSTANDO_HORAS_ALARMA},
+            [UI_CANCELAR] = {NULL, MODO_RESTAURAR},
+            [UI_INACTIVIDAD] = {NULL, MODO_RESTAURAR},
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [AJUSTANDO_HORAS_ALARMA] =
+        {
+            [UI_AJUSTAR_TIEMPO] = SIN_TRANSICION,
+            [UI_AJUSTAR_ALARMA] = SIN_TRANSICION,
+            [UI_DECREMENTAR] = {RestarHora, MODO_ACTUAL},
+            [UI_INCREMENTAR] = {SumarHora, MODO_ACTUAL},
+            [UI_ACEPTAR] = {GuardarAlarma, MOSTRANDO_HORA},
+            [UI_CANCELAR] = {NULL, MODO_RESTAURAR},
+            [UI_INACTIVIDAD] = {NULL, MODO_RESTAURAR},
+            [UI_ALARMA] = SIN_TRANSICION,
+        },
+    [PANTALLA_APAGADA] =
+        {
+            [UI_AJUSTAR_TIEMPO] = {NULL, MOSTRANDO_HORA},
+            [UI_AJUSTAR_ALARMA] = {NULL, MOSTRANDO_HORA},
+            [UI_DECREMENTAR] = {NULL, MOSTRANDO_HORA},
+            [UI_INCREMENTAR] = {NULL, MOSTRANDO_HORA},
+            [UI_ACEPTAR] = {NULL, MOSTRANDO_HORA},
+            [UI_CANCELAR] = {NULL, MOSTRANDO_HORA},
+            [UI_INACTIVIDAD] = SIN_TRANSICION,
+            [UI_ALARMA] = {NULL, MOSTRANDO_HORA},
+        },
+};
+
+#if (CONSOLE == 1)
+// Nombre de cada modo en las respuestas de la consola, indexado por modo_t
+static const char * const NOMBRES_MODOS[MODOS_CANTIDAD] = {
+    [SIN_CONFIGURAR] = "sin configurar",
+    [MOSTRANDO_HORA] = "mostrando hora",
+    [AJUSTANDO_MINUTOS_ACTUAL] = "ajustando minutos de la hora",
+    [AJUSTANDO_HORAS_ACTUAL] = "ajustando horas de la hora",
+    [AJUSTANDO_MINUTOS_ALARMA] = "ajustando minutos de la alarma",
+    [AJUSTANDO_HORAS_ALARMA] = "ajustando horas de la alarma",
+    [PANTALLA_APAGADA] = "pantalla apagada",
+};
+
+// Comandos de la consola, el texto de uso es el que muestra el comando ayuda
+static const console_command_t COMANDOS[] = {
+    {"hora", "hora [HH:MM[:SS]]", ComandoHora},
+    {"alarma", "alarma [HH:MM[:SS] | si | no | posponer [minutos] | cancelar]", ComandoAlarma},
+    {"estado", "estado", ComandoEstado},
+    {"prueba", "prueba", ComandoPrueba},
+#if (TELEMETRY == 1)
+    {"telemetria", "telemetria [si | no]", ComandoTelemetria},
+#endif
+#if (GPIO_ACCOUNTING == 1)
+    {"trafico", "trafico [lugares | borrar]", ComandoTrafico},
+#endif
+#if (PROFILING == 1)
+    {"sondas", "sondas", ComandoSondas},
+#endif
+};
+#endif
+
 /* === Private function implementation ========================================================= */
 
 void ActivarAlarma(bool estado)
@@ -105,265 +499,1217 @@ void ActivarAlarma(bool estado)
     {
         DigitalOutputDeactivate(board->buzzer);
     }
+
+    EnviarEvento(EVENTO_ALARMA, estado, UptimeStamp());
 }
 
 void CambiarModo(modo_t valor)
 {
+    if (valor == MODO_RESTAURAR)
+    {
+        valor = ClockGetTime(reloj, entrada, sizeof(entrada)) ? MOSTRANDO_HORA : SIN_CONFIGURAR;
+    }
+
+    TraceRecord(TRACE_MODE_CHANGE, TRACE_DATA(modo, valor, 0));
+
+    if (ESTADOS[modo].salida)
+    {
+        ESTADOS[modo].salida();
+    }
+
     modo = valor;
-    switch (modo)
-    {
-    case SIN_CONFIGURAR:
-        ParpadearDigitos(0, 3, 200);
-        break;
-    case MOSTRANDO_HORA:
-        ParpadearDigitos(0, 0, 0);
-        break;
-    case AJUSTANDO_MINUTOS_ACTUAL:
-        ParpadearDigitos(2, 3, 200);
-        break;
-    case AJUSTANDO_HORAS_ACTUAL:
-        ParpadearDigitos(0, 1, 200);
-        break;
-    case AJUSTANDO_MINUTOS_ALARMA:
-        ParpadearDigitos(2, 3, 200);
-        AlternarPunto(0);
+    ParpadearDigitos(ESTADOS[modo].parpadeo_desde, ESTADOS[modo].parpadeo_hasta, ESTADOS[modo].parpadeo_factor);
+
+    if (ESTADOS[modo].entrada)
+    {
+        ESTADOS[modo].entrada();
+    }
+}
+
+void Despachar(ui_evento_t evento)
+{
+    const transicion_t * transicion = &TRANSICIONES[modo][evento];
+
+    if (transicion->accion)
+    {
+        transicion->accion();
+    }
+
+    if (transicion->siguiente != MODO_ACTUAL)
+    {
+        CambiarModo(transicion->siguiente);
+    }
+}
+
+bool TieneTransicion(ui_evento_t evento)
+{
+    return TRANSICIONES[modo][evento].accion || (TRANSICIONES[modo][evento].siguiente != MODO_ACTUAL);
+}
+
+void RegistrarLatencia(uint32_t timestamp)
+{
+    HistogramRecord(latencia, UptimeStamp() - timestamp);
+}
+
+void EnviarEvento(evento_tipo_t tipo, uint8_t valor, uint32_t timestamp)
+{
+    evento_t evento = {
+        .tipo = tipo,
+        .valor = valor,
+        .timestamp = timestamp,
+    };
+
+    BaseType_t resultado;
+
+    if (__get_IPSR()) // El barrido y la consola avisan desde sus interrupciones
+    {
+        BaseType_t despertar = pdFALSE;
+
+        resultado = xQueueSendFromISR(eventos, &evento, &despertar);
+        portYIELD_FROM_ISR(despertar);
+    }
+    else
+    {
+        resultado = xQueueSend(eventos, &evento, 0); // Nunca bloquea a la tarea que produce el evento
+    }
+
+    if (resultado != pdTRUE)
+    {
+        eventos_perdidos++;
+    }
+}
+
+void MostrarHora(void)
+{
+    uint8_t hora[TAMANIO_HORA];
+
+    ClockGetTime(reloj, hora, sizeof(hora));
+    DisplayWriteBCD(board->display, hora, sizeof(hora));
+
+    if (MedioSegundo)
+    {
         AlternarPunto(1);
-        AlternarPunto(2);
+    }
+
+    if (AlarmGetState(reloj)) // Alarma habilitada
+    {
         AlternarPunto(3);
-        break;
-    case AJUSTANDO_HORAS_ALARMA:
-        ParpadearDigitos(0, 1, 100);
+    }
+
+    if (AlarmaActivada)
+    {
+        AlternarPunto(0);
+    }
+}
+
+void MostrarEntrada(void)
+{
+    DisplayWriteBCD(board->display, entrada, sizeof(entrada));
+
+    if (ESTADOS[modo].muestra_puntos)
+    {
         AlternarPunto(0);
         AlternarPunto(1);
         AlternarPunto(2);
         AlternarPunto(3);
-        break;
-    default:
-        break;
     }
 }
 
-static void TareaPrincipal(void * pvParameters)
+TickType_t TiempoRestante(uint64_t limite, uint64_t ahora)
 {
-    uint8_t entrada[6];
+    // El tiempo desde el arranque no desborda, los plazos se comparan directamente
+    return (limite > ahora) ? pdMS_TO_TICKS(limite - ahora) : 0;
+}
 
-    while (true)
+void ArmarPlazo(plazo_t plazo, uint64_t limite)
+{
+    TickType_t espera = TiempoRestante(limite, UptimeMilliseconds());
+    BaseType_t enviado;
+
+    // Cambiar el período arranca el temporizador o lo reinicia si ya estaba corriendo; un plazo vencido avisa en el
+    // próximo tick. Un comando perdido dejaría el plazo sin vencer, la cola se dimensiona para que no ocurra
+    enviado = xTimerChangePeriod(plazos[plazo], espera ? espera : 1, 0);
+    configASSERT(enviado == pdPASS);
+}
+
+void DesarmarPlazo(plazo_t plazo)
+{
+    BaseType_t enviado;
+
+    // Un comando perdido dejaría vencer un plazo ya desarmado, lo que la tarea principal descarta, pero igual se
+    // verifica como en ArmarPlazo
+    enviado = xTimerStop(plazos[plazo], 0);
+    configASSERT(enviado == pdPASS);
+}
+
+static void PosponerOHabilitarAlarma(void)
+{
+    if (AlarmaActivada)
+    {
+        AlarmPostpone(reloj, 5);
+    }
+    else
+    {
+        AlarmEnamble(reloj, true);
+    }
+}
+
+static void CancelarODeshabilitarAlarma(void)
+{
+    if (AlarmaActivada)
+    {
+        AlarmCancel(reloj);
+    }
+    else
+    {
+        AlarmEnamble(reloj, false);
+    }
+}
+
+static void CargarHora(void)
+{
+    ClockGetTime(reloj, entrada, sizeof(entrada));
+}
+
+static void CargarAlarma(void)
+{
+    AlarmGetTime(reloj, entrada, sizeof(entrada));
+}
+
+static void GuardarHora(void)
+{
+    ClockSetTime(reloj, entrada, sizeof(entrada));
+}
+
+static void GuardarAlarma(void)
+{
+    AlarmSetTime(reloj, entrada, sizeof(entrada));
+}
+
+static void SumarMinuto(void)
+{
+    IncrementarMinuto(entrada);
+    MostrarEntrada();
+}
+
+static void RestarMinuto(void)
+{
+    DecrementarMinuto(entrada);
+    MostrarEntrada();
+}
+
+static void SumarHora(void)
+{
+    IncrementarHora(entrada);
+    MostrarEntrada();
+}
+
+static void RestarHora(void)
+{
+    DecrementarHora(entrada);
+    MostrarEntrada();
+}
+
+static void ApagarPantalla(void)
+{
+    DisplaySetPower(board->display, false);
+#if (LOW_POWER == 1)
+    pantalla_apagada = true; // La interrupción de barrido lo detiene cuando terminen las teclas
+#endif
+}
+
+static void EncenderPantalla(void)
+{
+#if (LOW_POWER == 1)
+    taskENTER_CRITICAL();
+    pantalla_apagada = false;
+    ReanudarBarrido();
+    taskEXIT_CRITICAL();
+#endif
+    DisplaySetPower(board->display, true);
+}
+
+static void AvanzarReloj(uint32_t timestamp, uint32_t milisegundos)
+{
+    static bool previous_value = false;
+    bool current_value = ClockRefresh(reloj); // La fuente cuenta la hora, una llamada alcanza para cualquier demora
+
+    if (ClockSecondChanged(reloj))
+    {
+        fase_segundo = 0;
+    }
+    else
+    {
+        fase_segundo += milisegundos;
+    }
+
+    if (current_value != previous_value) // Avisa los flancos de medio segundo en lugar de reescribir la pantalla
+    {
+        previous_value = current_value;
+        EnviarEvento(EVENTO_RELOJ, current_value, timestamp);
+    }
+}
+
+static bool Barrer(uint32_t timestamp)
+{
+    static uint32_t matriz_anterior = 0;
+    digital_event_t cambio;
+    uint32_t matriz;
+
+    DisplayRefresh(board->display);
+    AvanzarReloj(timestamp, 1);
+
+    // Las teclas con entrada propia solo se leen después de un flanco, hasta que terminen los rebotes
+    if (lecturas_teclas)
     {
-        if (DigitalInputHasActivated(board->aceptar))
+        lecturas_teclas--;
+        for (int tecla = 0; tecla < TECLAS_CANTIDAD; tecla++)
         {
-            count30s = 0;
-            if (modo == MOSTRANDO_HORA)
+            if (DigitalInputGetEvent(teclas[tecla], &cambio))
             {
-                if (AlarmaActivada)
-                {
-                    AlarmPostpone(reloj, 5);
-                }
-                else
-                {
-                    AlarmEnamble(reloj, true);
-                }
-            }
-            else if (modo == AJUSTANDO_MINUTOS_ACTUAL)
-            {
-                CambiarModo(AJUSTANDO_HORAS_ACTUAL);
-            }
-            else if (modo == AJUSTANDO_HORAS_ACTUAL)
-            {
-                ClockSetTime(reloj, entrada, sizeof(entrada));
-                CambiarModo(MOSTRANDO_HORA);
-            }
-            else if (modo == AJUSTANDO_MINUTOS_ALARMA)
-            {
-                CambiarModo(AJUSTANDO_HORAS_ALARMA);
-                AlternarPunto(0);
-                AlternarPunto(1);
-                AlternarPunto(2);
-                AlternarPunto(3);
+                TraceRecord(cambio.active ? TRACE_KEY_PRESSED : TRACE_KEY_RELEASED, tecla);
+                EnviarEvento(cambio.active ? EVENTO_TECLA_PRESIONADA : EVENTO_TECLA_LIBERADA, tecla, cambio.timestamp);
             }
-            else if (modo == AJUSTANDO_HORAS_ALARMA)
+        }
+    }
+
+    // Con el teclado matricial las teclas de ajuste no tienen entrada propia, sus flancos salen de cada barrido
+    if (DisplayGetKeys(board->display, &matriz))
+    {
+        for (int tecla = TECLA_AJUSTAR_TIEMPO; tecla <= TECLA_INCREMENTAR; tecla++)
+        {
+            bool presionada = matriz & TECLA_MATRIZ(tecla);
+
+            if (presionada != ((matriz_anterior & TECLA_MATRIZ(tecla)) != 0))
             {
-                AlarmSetTime(reloj, entrada, sizeof(entrada));
-                CambiarModo(MOSTRANDO_HORA);
+                TraceRecord(presionada ? TRACE_KEY_PRESSED : TRACE_KEY_RELEASED, tecla);
+                EnviarEvento(presionada ? EVENTO_TECLA_PRESIONADA : EVENTO_TECLA_LIBERADA, tecla, timestamp);
             }
         }
+        matriz_anterior = matriz;
+    }
+
+    return lecturas_teclas || matriz_anterior;
+}
+
+#if (LOW_POWER == 1)
+static void DetenerBarrido(void)
+{
+    // Las filas avisan antes de activar las columnas, así también despierta una tecla presionada en el medio
+    Keys_WatchRows(true);
+    DisplayWatchKeys(board->display);
+    barrido_detenido = true;
+
+    ProgramarSegundo();
+}
+
+static void ProgramarSegundo(void)
+{
+    // La alarma se revisa en el cambio de segundo de la fuente del reloj. Si al despertar todavía no llegó, como con
+    // el RTC que cuenta con su propio cristal, se vuelve a mirar en el milisegundo siguiente
+    if (fase_segundo == PERIODO_PANTALLA_APAGADA)
+    {
+        periodo_detenido = 1;
+    }
+    else
+    {
+        periodo_detenido = PERIODO_PANTALLA_APAGADA - fase_segundo % PERIODO_PANTALLA_APAGADA;
+    }
+    ScanTimer_SetPeriod(periodo_detenido);
+}
 
-        if (DigitalInputHasActivated(board->cancelar))
+static void ReanudarBarrido(void)
+{
+    if (barrido_detenido)
+    {
+        barrido_detenido = false;
+        Keys_WatchRows(false);
+        AvanzarReloj(UptimeStamp(), ScanTimer_Elapsed()); // Los milisegundos desde la última interrupción
+        ScanTimer_SetPeriod(1);
+    }
+}
+#endif
+
+static void TerminarPrueba(void)
+{
+    prueba_en_curso = false;
+    if (!AlarmaActivada)
+    {
+        DigitalOutputDeactivate(board->buzzer);
+    }
+
+    // Restaura el parpadeo y el contenido de la pantalla del modo actual
+    ParpadearDigitos(ESTADOS[modo].parpadeo_desde, ESTADOS[modo].parpadeo_hasta, ESTADOS[modo].parpadeo_factor);
+    if (ESTADOS[modo].entrada)
+    {
+        ESTADOS[modo].entrada();
+    }
+}
+
+#if (SETTINGS == 1)
+static void RestaurarAjustes(void)
+{
+    settings_t ajustes;
+
+    if (!SettingsRestore(&ajustes))
+    {
+        return;
+    }
+
+    // La hora actual no se guarda: después de un corte no hay forma de saber cuánto tiempo pasó
+    if (ajustes.alarm_valid)
+    {
+        AlarmSetTime(reloj, ajustes.alarm, sizeof(ajustes.alarm));
+        AlarmEnamble(reloj, ajustes.alarm_enabled);
+    }
+#if (TELEMETRY == 1)
+    telemetria_habilitada = ajustes.telemetry;
+#endif
+}
+
+static void GuardarAjustes(void)
+{
+    settings_t ajustes = {0};
+
+    ajustes.alarm_valid = AlarmGetTime(reloj, ajustes.alarm, sizeof(ajustes.alarm));
+    ajustes.alarm_enabled = AlarmGetState(reloj);
+#if (TELEMETRY == 1)
+    ajustes.telemetry = telemetria_habilitada;
+#else
+    ajustes.telemetry = true;
+#endif
+
+    SettingsSave(&ajustes);
+    SettingsFlush(); // Si la EEPROM sigue programando, se reintenta en el próximo medio segundo
+}
+#endif
+
+static void TareaPrincipal(void * pvParameters)
+{
+    evento_t evento;
+    bool pulsacion_pendiente = false;
+    tecla_t pulsacion_tecla = TECLA_AJUSTAR_TIEMPO;
+    uint64_t pulsacion_limite = 0;
+    uint64_t ultima_actividad = UptimeMilliseconds();
+    uint64_t ahora;
+    modo_t modo_previo;
+
+    // El temporizador de inactividad corre siempre desde la última actividad, así un modo al que se entra sin una
+    // tecla, como el de la alarma, encuentra el plazo ya armado
+    ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
+
+    while (true)
+    {
+        modo_previo = modo;
+
+        // Los plazos llegan como eventos de sus temporizadores, la tarea no se despierta hasta que algo ocurre
+        if (xQueueReceive(eventos, &evento, portMAX_DELAY) == pdTRUE)
         {
-            count30s = 0;
-            if (modo == MOSTRANDO_HORA)
+            switch (evento.tipo)
             {
-                if (AlarmaActivada)
+            case EVENTO_TECLA_PRESIONADA:
+                ultima_actividad = UptimeMilliseconds();
+                ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
+                if ((evento.valor == TECLA_AJUSTAR_TIEMPO) || (evento.valor == TECLA_AJUSTAR_ALARMA))
                 {
-                    AlarmCancel(reloj);
+                    if (TieneTransicion(evento.valor)) // Las teclas de ajuste actúan luego de una pulsación larga
+                    {
+                        pulsacion_pendiente = true;
+                        pulsacion_tecla = evento.valor;
+                        pulsacion_limite = UptimeExpand(evento.timestamp) + TIEMPO_PULSACION_LARGA;
+                        ArmarPlazo(PLAZO_PULSACION, pulsacion_limite);
+                    }
                 }
-                else
+                else if (TieneTransicion(evento.valor))
                 {
-                    AlarmEnamble(reloj, false);
+                    PROBE_BEGIN(PROBE_KEY_HANDLING);
+                    Despachar(evento.valor);
+                    MarcarCuadro(&evento);
+                    PROBE_END(PROBE_KEY_HANDLING);
                 }
-            }
-            else if (ClockGetTime(reloj, entrada, sizeof(entrada)))
-            {
-                CambiarModo(MOSTRANDO_HORA);
-            }
-            else
-            {
-                CambiarModo(SIN_CONFIGURAR);
+                break;
+
+            case EVENTO_TECLA_LIBERADA:
+                ultima_actividad = UptimeMilliseconds();
+                ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
+                if (pulsacion_pendiente && (evento.valor == pulsacion_tecla))
+                {
+                    pulsacion_pendiente = false;
+                    DesarmarPlazo(PLAZO_PULSACION);
+                }
+                break;
+
+            case EVENTO_RELOJ:
+                MedioSegundo = evento.valor;
+#if (SETTINGS == 1)
+                GuardarAjustes(); // Cada medio segundo, junta en un registro los cambios de las teclas y la consola
+#endif
+                break;
+
+            case EVENTO_ALARMA:
+                if (evento.valor)
+                {
+                    // La alarma cuenta como actividad, así la pantalla que enciende no se apaga enseguida
+                    ultima_actividad = UptimeMilliseconds();
+                    ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
+                    Despachar(UI_ALARMA);
+                }
+                break;
+
+#if (CONSOLE == 1)
+            case EVENTO_CONSOLA:
+                ultima_actividad = UptimeMilliseconds(); // Un comando cuenta como actividad del usuario
+                ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
+                ConsoleProcess(consola);
+#if (SETTINGS == 1)
+                GuardarAjustes(); // Con el barrido detenido no llegan los medios segundos que guardan los cambios
+#endif
+                // Con la UART ocupada la respuesta sale desde la interrupción de fin de envío; la sección crítica
+                // evita que esa interrupción la envíe también entre la consulta y el envío
+                taskENTER_CRITICAL();
+                if (!Serial_Busy())
+                {
+                    EnviarRespuesta();
+                }
+                taskEXIT_CRITICAL();
+                break;
+#endif
+
+            case EVENTO_PLAZO:
+                // Se atiende abajo junto con los demás plazos; si se reinició después de vencer, todavía no se cumplió
+                break;
+
+            default:
+                break;
             }
         }
+        despertares_principal++;
 
-        if (DigitalInputGetState(board->ajustar_tiempo))
+        ahora = UptimeMilliseconds();
+        if (pulsacion_pendiente && (TiempoRestante(pulsacion_limite, ahora) == 0))
         {
-            count30s = 0;
-            if ((count3s > 3000) && (modo <= MOSTRANDO_HORA))
-            {
-                CambiarModo(AJUSTANDO_MINUTOS_ACTUAL);
-                ClockGetTime(reloj, entrada, sizeof(entrada));
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-                count3s = 0;
-            }
+            pulsacion_pendiente = false;
+            Despachar((ui_evento_t)pulsacion_tecla);
+            ultima_actividad = ahora;
+            ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
         }
 
-        if (DigitalInputGetState(board->ajustar_alarma))
+        // Cualquier salida de la pantalla apagada, también la del comando prueba, vuelve a contar la inactividad
+        if ((modo_previo == PANTALLA_APAGADA) && (modo != PANTALLA_APAGADA))
         {
-            count30s = 0;
-            if ((count3s > 3000) && (modo <= MOSTRANDO_HORA))
-            {
-                CambiarModo(AJUSTANDO_MINUTOS_ALARMA);
-                AlarmGetTime(reloj, entrada, sizeof(entrada));
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-                AlternarPunto(0);
-                AlternarPunto(1);
-                AlternarPunto(2);
-                AlternarPunto(3);
-                count3s = 0;
-            }
+            ultima_actividad = ahora;
+            ArmarPlazo(PLAZO_INACTIVIDAD, ultima_actividad + TIEMPO_INACTIVIDAD);
         }
 
-        if (DigitalInputHasActivated(board->decrementar))
+        if (TieneTransicion(UI_INACTIVIDAD) && (TiempoRestante(ultima_actividad + TIEMPO_INACTIVIDAD, ahora) == 0))
         {
-            count30s = 0;
-            if ((modo == AJUSTANDO_MINUTOS_ACTUAL) || (modo == AJUSTANDO_MINUTOS_ALARMA))
-            {
-                DecrementarMinuto(entrada);
-            }
-            else if ((modo == AJUSTANDO_HORAS_ACTUAL) || (modo == AJUSTANDO_HORAS_ALARMA))
-            {
-                DecrementarHora(entrada);
-            }
-
-            if ((modo == AJUSTANDO_MINUTOS_ACTUAL) || (modo == AJUSTANDO_HORAS_ACTUAL))
-            {
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-            }
-            else if ((modo == AJUSTANDO_MINUTOS_ALARMA) || (modo == AJUSTANDO_HORAS_ALARMA))
-            {
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-                AlternarPunto(0);
-                AlternarPunto(1);
-                AlternarPunto(2);
-                AlternarPunto(3);
-            }
+            Despachar(UI_INACTIVIDAD);
         }
 
-        if (DigitalInputHasActivated(board->incrementar))
+        if (prueba_en_curso && (TiempoRestante(prueba_limite, ahora) == 0))
         {
-            count30s = 0;
-            if ((modo == AJUSTANDO_MINUTOS_ACTUAL) || (modo == AJUSTANDO_MINUTOS_ALARMA))
-            {
-                IncrementarMinuto(entrada);
-            }
-            else if ((modo == AJUSTANDO_HORAS_ACTUAL) || (modo == AJUSTANDO_HORAS_ALARMA))
-            {
-                IncrementarHora(entrada);
-            }
+            TerminarPrueba();
+        }
 
-            if ((modo == AJUSTANDO_MINUTOS_ACTUAL) || (modo == AJUSTANDO_HORAS_ACTUAL))
-            {
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-            }
-            else if ((modo == AJUSTANDO_MINUTOS_ALARMA) || (modo == AJUSTANDO_HORAS_ALARMA))
-            {
-                DisplayWriteBCD(board->display, entrada, sizeof(entrada));
-                AlternarPunto(0);
-                AlternarPunto(1);
-                AlternarPunto(2);
-                AlternarPunto(3);
-            }
+        if (ESTADOS[modo].muestra_hora && !prueba_en_curso) // La hora solo se escribe cuando algo cambió
+        {
+            MostrarHora();
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
     }
 }
 
-static void TareaRefresco(void * pvParameters)
+static void InterrupcionBarrido(void)
 {
-    TickType_t last_value = xTaskGetTickCount();
-    bool current_value;
-    uint8_t hora[6];
+#if (LOW_POWER == 1)
+    if (barrido_detenido)
+    {
+        AvanzarReloj(UptimeStamp(), periodo_detenido);
+        ProgramarSegundo();
+    }
+    else if (!Barrer(UptimeStamp()) && pantalla_apagada)
+    {
+        DetenerBarrido();
+    }
+#else
+    uint32_t atraso;
 
-    while (true)
+    // La primera interrupción fija la fase del monitor, las siguientes se miden contra ella
+    if (despertares_barrido == 0)
+    {
+        PeriodMonitorStart(barrido, PROBE_TIMESTAMP_HZ / 1000, PROBE_TIMESTAMP_HZ / 10000, ProbeTimestamp());
+    }
+    atraso = PeriodMonitorWake(barrido, ProbeTimestamp());
+    if (atraso)
+    {
+        TraceRecord(TRACE_DEADLINE_MISS, TRACE_DATA(TRAZA_BARRIDO, atraso & 0xFF, (atraso >> 8) & 0xFF));
+    }
+
+    Barrer(UptimeStamp());
+#endif
+    despertares_barrido++;
+}
+
+static void CambiarTecla(void)
+{
+    lecturas_teclas = PASADAS_TECLAS; // Cada rebote vuelve a abrir la ventana completa
+#if (LOW_POWER == 1)
+    ReanudarBarrido();
+#endif
+}
+
+static void VencerPlazo(TimerHandle_t temporizador)
+{
+    EnviarEvento(EVENTO_PLAZO, (uintptr_t)pvTimerGetTimerID(temporizador), UptimeStamp());
+}
+
+#if (TELEMETRY == 1)
+static void EnviarTelemetria(TimerHandle_t temporizador)
+{
+    static uint32_t cursor_traza = 0;
+    uint32_t cursor_anterior = cursor_traza;
+    telemetry_status_t estado = {0};
+    uint16_t largo;
+
+    (void)temporizador;
+    if (Serial_Busy()) // El DMA todavía lee las tramas anteriores
     {
-        DisplayRefresh(board->display);
-        current_value = ClockRefresh(reloj);
-        count30s++;
+        telemetria_omitida++;
+        return;
+    }
+
+    estado.uptime = UptimeStamp();
+    estado.time_valid = ClockGetTime(reloj, estado.time, sizeof(estado.time));
+    AlarmGetTime(reloj, estado.alarm, sizeof(estado.alarm));
+    estado.alarm_enabled = AlarmGetState(reloj);
+    estado.alarm_ringing = AlarmaActivada;
+    estado.mode = modo;
+    estado.main_wakeups = despertares_principal;
+    estado.scan_wakeups = despertares_barrido;
+    estado.lost_events = eventos_perdidos;
+#if (RUN_TIME_STATS == 1)
+    CpuStatsGet(&carga);
+    estado.idle = carga.idle;
+#else
+    estado.idle = TELEMETRY_NO_LOAD;
+#endif
+    HistogramGetStats(latencia, &estado.latency);
+#if (LOW_POWER == 0)
+    PeriodMonitorGetStats(barrido, &estado.scan);
+#endif
+    estado.trace_written = TraceCount();
 
-        if (modo <= MOSTRANDO_HORA)
+    largo = TelemetryEncodeStatus(&estado, telemetria, sizeof(telemetria));
+    largo += TelemetryEncodeTrace(&cursor_traza, telemetria + largo, sizeof(telemetria) - largo);
+    if (!Serial_Send(telemetria, largo)) // La interrupción de la consola envió una respuesta mientras se armaban
+    {
+        cursor_traza = cursor_anterior; // Los eventos de la traza salen en la trama siguiente
+        telemetria_omitida++;
+    }
+}
+#endif
+
+#if (CONSOLE == 1)
+static void RecibirConsola(void)
+{
+    // Los comandos se ejecutan en la tarea principal, que es la única que modifica el estado de la interfaz
+    if (ConsoleReceive(consola, Serial_Received()))
+    {
+#if (TELEMETRY == 1)
+        BaseType_t despertar = pdFALSE;
+
+        respuesta_en_curso = true;
+        xTimerStopFromISR(temporizador_telemetria, &despertar);
+        portYIELD_FROM_ISR(despertar);
+#endif
+        EnviarEvento(EVENTO_CONSOLA, 0, UptimeStamp());
+    }
+    else if (!Serial_Busy()) // Una línea demasiado larga deja la respuesta de error sin pasar por la tarea
+    {
+        EnviarRespuesta();
+    }
+}
+
+static void TerminarEnvio(void)
+{
+    // Terminó una respuesta o una trama de telemetría, la UART libre puede enviar la respuesta que esperaba
+    ConsoleTransmitted(consola);
+    EnviarRespuesta();
+
+    // Las líneas que llegaron durante la respuesta ya están en el buffer y no van a pedir otra interrupción
+    RecibirConsola();
+
+#if (TELEMETRY == 1)
+    // Salió la respuesta a la última línea, la telemetría vuelve si el comando no la deshabilitó
+    if (respuesta_en_curso && ConsoleIdle(consola))
+    {
+        BaseType_t despertar = pdFALSE;
+
+        respuesta_en_curso = false;
+        if (telemetria_habilitada)
         {
-            ClockGetTime(reloj, hora, sizeof(hora));
-            DisplayWriteBCD(board->display, hora, sizeof(hora));
+            xTimerStartFromISR(temporizador_telemetria, &despertar);
+            portYIELD_FROM_ISR(despertar);
+        }
+    }
+#endif
+}
 
-            if (current_value)
-            {
-                AlternarPunto(1);
-            }
+static void EnviarRespuesta(void)
+{
+    const uint8_t * respuesta;
+    uint16_t largo = ConsoleTransmit(consola, &respuesta);
 
-            if (AlarmGetState(reloj)) // Alarma habilitada
-            {
-                AlternarPunto(3);
-            }
+    if (largo)
+    {
+        Serial_Send(respuesta, largo);
+    }
+}
 
-            if (AlarmaActivada)
-            {
-                AlternarPunto(0);
-            }
+static bool LeerHora(console_t consola, const console_argument_t * argumento, uint8_t * hora)
+{
+    uint8_t digitos = ConsoleArgumentDigits(consola, argumento, hora, TAMANIO_HORA);
 
-            if (DigitalInputGetState(board->ajustar_tiempo) || DigitalInputGetState(board->ajustar_alarma))
-            {
-                count3s++;
-            }
-            else
-            {
-                count3s = 0;
-            }
+    if (digitos == 4) // Sin segundos
+    {
+        hora[4] = 0;
+        hora[5] = 0;
+    }
+
+    return ((digitos == 4) || (digitos == TAMANIO_HORA)) && HoraValida(hora);
+}
+
+static void ComandoHora(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    uint8_t hora[TAMANIO_HORA];
+
+    if (cantidad > 1)
+    {
+        ConsoleWrite(consola, "error: uso hora [HH:MM[:SS]]\n");
+        return;
+    }
+    if (cantidad == 1)
+    {
+        // Se valida antes de guardarla porque el reloj pierde la hora actual si recibe una inválida
+        if (!LeerHora(consola, &argumentos[0], hora))
+        {
+            ConsoleWrite(consola, "error: hora invalida\n");
+            return;
         }
+        ClockSetTime(reloj, hora, sizeof(hora));
+        if (modo == SIN_CONFIGURAR)
+        {
+            CambiarModo(MOSTRANDO_HORA);
+        }
+    }
 
-        if ((count30s > 30000) && (modo > MOSTRANDO_HORA))
+    ConsoleWrite(consola, "hora ");
+    if (ClockGetTime(reloj, hora, sizeof(hora)))
+    {
+        ConsoleWriteDigits(consola, hora, sizeof(hora));
+        ConsoleWrite(consola, "\n");
+    }
+    else
+    {
+        ConsoleWrite(consola, "sin ajustar\n");
+    }
+}
+
+static void ComandoAlarma(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    uint8_t hora[TAMANIO_HORA];
+    uint32_t minutos = 5;
+
+    if (cantidad == 0)
+    {
+        // Solo consulta
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "si"))
+    {
+        AlarmEnamble(reloj, true);
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "no"))
+    {
+        AlarmEnamble(reloj, false);
+    }
+    else if ((cantidad <= 2) && ConsoleArgumentIs(consola, &argumentos[0], "posponer"))
+    {
+        if ((cantidad == 2) && (!ConsoleArgumentNumber(consola, &argumentos[1], &minutos) || (minutos == 0) ||
+                                (minutos > 59)))
         {
-            if (ClockGetTime(reloj, hora, sizeof(hora)))
+            ConsoleWrite(consola, "error: minutos invalidos\n");
+            return;
+        }
+        if (!AlarmaActivada)
+        {
+            ConsoleWrite(consola, "error: la alarma no esta sonando\n");
+            return;
+        }
+        AlarmPostpone(reloj, minutos);
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "cancelar"))
+    {
+        if (!AlarmaActivada)
+        {
+            ConsoleWrite(consola, "error: la alarma no esta sonando\n");
+            return;
+        }
+        AlarmCancel(reloj);
+    }
+    else if ((cantidad == 1) && LeerHora(consola, &argumentos[0], hora))
+    {
+        AlarmSetTime(reloj, hora, sizeof(hora));
+    }
+    else
+    {
+        ConsoleWrite(consola, "error: uso alarma [HH:MM[:SS] | si | no | posponer [minutos] | cancelar]\n");
+        return;
+    }
+
+    ConsoleWrite(consola, "alarma ");
+    if (AlarmGetTime(reloj, hora, sizeof(hora)))
+    {
+        ConsoleWriteDigits(consola, hora, sizeof(hora));
+    }
+    else
+    {
+        ConsoleWrite(consola, "sin ajustar");
+    }
+    ConsoleWrite(consola, AlarmGetState(reloj) ? " habilitada" : " deshabilitada");
+    ConsoleWrite(consola, AlarmaActivada ? ", sonando\n" : "\n");
+}
+
+static void ComandoEstado(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    static memory_stats_t memoria;
+    histogram_stats_t latencias;
+#if (LOW_POWER == 0)
+    period_stats_t periodo;
+#endif
+#if (SETTINGS == 1)
+    settings_stats_t ajustes;
+#endif
+    pool_stats_t entradas, salidas, grupos;
+
+    (void)argumentos;
+    if (cantidad != 0)
+    {
+        ConsoleWrite(consola, "error: uso estado\n");
+        return;
+    }
+
+    ConsoleWrite(consola, "modo ");
+    ConsoleWrite(consola, NOMBRES_MODOS[modo]);
+    ConsoleWrite(consola, "\ntiempo encendido ");
+    ConsoleWriteNumber(consola, UptimeMilliseconds() / 1000, 0);
+    ConsoleWrite(consola, " s\ndespertares principal ");
+    ConsoleWriteNumber(consola, despertares_principal, 0);
+    ConsoleWrite(consola, " barrido ");
+    ConsoleWriteNumber(consola, despertares_barrido, 0);
+    ConsoleWrite(consola, "\neventos perdidos ");
+    ConsoleWriteNumber(consola, eventos_perdidos, 0);
+
+    HistogramGetStats(latencia, &latencias);
+    ConsoleWrite(consola, "\nlatencia de teclas min/prom/p99/max ");
+    ConsoleWriteNumber(consola, latencias.min, 0);
+    ConsoleWrite(consola, "/");
+    ConsoleWriteNumber(consola, latencias.mean, 0);
+    ConsoleWrite(consola, "/");
+    ConsoleWriteNumber(consola, latencias.p99, 0);
+    ConsoleWrite(consola, "/");
+    ConsoleWriteNumber(consola, latencias.max, 0);
+    ConsoleWrite(consola, " ms en ");
+    ConsoleWriteNumber(consola, latencias.samples, 0);
+    ConsoleWrite(consola, " pulsaciones\n");
+
+#if (LOW_POWER == 0)
+    PeriodMonitorGetStats(barrido, &periodo);
+    ConsoleWrite(consola, "barrido retrasados ");
+    ConsoleWriteNumber(consola, periodo.late, 0);
+    ConsoleWrite(consola, " perdidos ");
+    ConsoleWriteNumber(consola, periodo.missed, 0);
+    ConsoleWrite(consola, " de ");
+    ConsoleWriteNumber(consola, periodo.activations, 0);
+    ConsoleWrite(consola, ", fluctuacion p99 ");
+    ConsoleWriteNumber(consola, periodo.jitter.p99, 1);
+    ConsoleWrite(consola, "% max ");
+    ConsoleWriteNumber(consola, periodo.jitter.max, 1);
+    ConsoleWrite(consola, "%\n");
+#endif
+
+#if (RUN_TIME_STATS == 1)
+#if (TELEMETRY == 0)
+    CpuStatsGet(&carga); // Sin telemetría la medición abarca desde el comando estado anterior
+#endif
+    ConsoleWrite(consola, "procesador inactivo ");
+    ConsoleWriteNumber(consola, carga.idle, 1);
+    ConsoleWrite(consola, "%\n");
+#endif
+
+    MemoryGetStats(&memoria);
+    for (int tarea = 0; tarea < memoria.tasks; tarea++)
+    {
+        ConsoleWrite(consola, "pila ");
+        ConsoleWrite(consola, memoria.task[tarea].name);
+        ConsoleWrite(consola, " ");
+        ConsoleWriteNumber(consola, memoria.task[tarea].stack_free, 0);
+        ConsoleWrite(consola, " bytes libres\n");
+    }
+    if (memoria.heap_size)
+    {
+        ConsoleWrite(consola, "heap ");
+        ConsoleWriteNumber(consola, memoria.heap_free, 0);
+        ConsoleWrite(consola, " de ");
+        ConsoleWriteNumber(consola, memoria.heap_size, 0);
+        ConsoleWrite(consola, " bytes libres\n");
+    }
+
+    DigitalGetStats(&entradas, &salidas, &grupos);
+    EscribirDescriptores(consola, "entradas", &entradas);
+    EscribirDescriptores(consola, "salidas", &salidas);
+    EscribirDescriptores(consola, "grupos", &grupos);
+
+#if (SETTINGS == 1)
+    SettingsGetStats(&ajustes);
+    ConsoleWrite(consola, "ajustes secuencia ");
+    ConsoleWriteNumber(consola, ajustes.sequence, 0);
+    ConsoleWrite(consola, " en ");
+    ConsoleWriteNumber(consola, ajustes.slot, 0);
+    ConsoleWrite(consola, " de ");
+    ConsoleWriteNumber(consola, ajustes.slots, 0);
+    ConsoleWrite(consola, ajustes.pending ? ", pendientes\n" : "\n");
+#endif
+
+    ConsoleWrite(consola, "eventos de traza ");
+    ConsoleWriteNumber(consola, TraceCount(), 0);
+#if (TELEMETRY == 1)
+    ConsoleWrite(consola, "\ntelemetria ");
+    ConsoleWrite(consola, telemetria_habilitada ? "habilitada" : "deshabilitada");
+    ConsoleWrite(consola, ", envios omitidos ");
+    ConsoleWriteNumber(consola, telemetria_omitida, 0);
+#endif
+    ConsoleWrite(consola, "\n");
+}
+
+static void EscribirDescriptores(console_t consola, const char * nombre, const pool_stats_t * uso)
+{
+    ConsoleWrite(consola, "descriptores ");
+    ConsoleWrite(consola, nombre);
+    ConsoleWrite(consola, " ");
+    ConsoleWriteNumber(consola, uso->used, 0);
+    ConsoleWrite(consola, " de ");
+    ConsoleWriteNumber(consola, uso->capacity, 0);
+    ConsoleWrite(consola, ", pico ");
+    ConsoleWriteNumber(consola, uso->peak, 0);
+    ConsoleWrite(consola, ", rechazados ");
+    ConsoleWriteNumber(consola, uso->failures, 0);
+    ConsoleWrite(consola, "\n");
+}
+
+static void ComandoPrueba(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    static memory_stats_t memoria;
+    uint8_t ochos[] = {8, 8, 8, 8};
+    bool correcta = true;
+#if (LOW_POWER == 0)
+    period_stats_t periodo;
+#endif
+
+    (void)cantidad;
+    (void)argumentos;
+
+    // Enciende todos los segmentos, los puntos y el zumbador; la tarea principal los restaura al vencer el tiempo
+    if (modo == PANTALLA_APAGADA)
+    {
+        CambiarModo(MOSTRANDO_HORA);
+    }
+    ParpadearDigitos(0, 0, 0);
+    DisplayWriteBCD(board->display, ochos, sizeof(ochos));
+    for (int punto = 0; punto < (int)sizeof(ochos); punto++)
+    {
+        AlternarPunto(punto);
+    }
+    DigitalOutputActivate(board->buzzer);
+    prueba_en_curso = true;
+    prueba_limite = UptimeMilliseconds() + TIEMPO_PRUEBA;
+    ArmarPlazo(PLAZO_PRUEBA, prueba_limite);
+    ConsoleWrite(consola, "pantalla y zumbador encendidos por ");
+    ConsoleWriteNumber(consola, TIEMPO_PRUEBA, 3);
+    ConsoleWrite(consola, " s\n");
+
+    MemoryGetStats(&memoria);
+    for (int tarea = 0; tarea < memoria.tasks; tarea++)
+    {
+        ConsoleWrite(consola, "pila ");
+        ConsoleWrite(consola, memoria.task[tarea].name);
+        ConsoleWrite(consola, memoria.task[tarea].stack_free >= MARGEN_PILA ? " ok\n" : " falla\n");
+        correcta = correcta && (memoria.task[tarea].stack_free >= MARGEN_PILA);
+    }
+
+    ConsoleWrite(consola, "cola de eventos ");
+    ConsoleWrite(consola, eventos_perdidos == 0 ? "ok\n" : "falla\n");
+    correcta = correcta && (eventos_perdidos == 0);
+
+#if (LOW_POWER == 0)
+    PeriodMonitorGetStats(barrido, &periodo);
+    ConsoleWrite(consola, "barrido ");
+    ConsoleWrite(consola, periodo.missed == 0 ? "ok\n" : "falla\n");
+    correcta = correcta && (periodo.missed == 0);
+#endif
+
+    ConsoleWrite(consola, correcta ? "prueba correcta\n" : "prueba con fallas\n");
+}
+
+#if (TELEMETRY == 1)
+static void ComandoTelemetria(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "si"))
+    {
+        telemetria_habilitada = true; // El temporizador arranca cuando termine de enviarse esta respuesta
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "no"))
+    {
+        telemetria_habilitada = false;
+        xTimerStop(temporizador_telemetria, 0);
+    }
+    else if (cantidad != 0)
+    {
+        ConsoleWrite(consola, "error: uso telemetria [si | no]\n");
+        return;
+    }
+
+    ConsoleWrite(consola, telemetria_habilitada ? "telemetria si\n" : "telemetria no\n");
+}
+#endif
+
+#if (GPIO_ACCOUNTING == 1)
+static void ComandoTrafico(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    traffic_counts_t accesos;
+
+    if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "borrar"))
+    {
+        TrafficClear();
+        ConsoleWrite(consola, "contadores en cero\n");
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "lugares"))
+    {
+        // Los lugares sin accesos desde el último borrado se omiten, una respuesta larga se trunca
+        for (const traffic_site_t * lugar = TrafficGetSites(); lugar; lugar = lugar->next)
+        {
+            if (lugar->counts.reads || lugar->counts.writes)
             {
-                CambiarModo(MOSTRANDO_HORA);
+                ConsoleWrite(consola, lugar->function);
+                ConsoleWrite(consola, ":");
+                ConsoleWriteNumber(consola, lugar->line, 0);
+                EscribirTrafico(consola, &lugar->counts);
             }
-            else
+        }
+    }
+    else if (cantidad == 0)
+    {
+        for (uint8_t puerto = 0; puerto < TRAFFIC_PORTS; puerto++)
+        {
+            TrafficGetPort(puerto, &accesos);
+            if (accesos.reads || accesos.writes)
             {
-                CambiarModo(SIN_CONFIGURAR);
+                ConsoleWrite(consola, "gpio");
+                ConsoleWriteNumber(consola, puerto, 0);
+                EscribirTrafico(consola, &accesos);
             }
-            count30s = 0;
         }
-        vTaskDelayUntil(&last_value, pdMS_TO_TICKS(1));
     }
+    else
+    {
+        ConsoleWrite(consola, "error: uso trafico [lugares | borrar]\n");
+    }
+}
+
+static void EscribirTrafico(console_t consola, const traffic_counts_t * accesos)
+{
+    ConsoleWrite(consola, " lecturas ");
+    ConsoleWriteNumber(consola, accesos->reads, 0);
+    ConsoleWrite(consola, " escrituras ");
+    ConsoleWriteNumber(consola, accesos->writes, 0);
+    ConsoleWrite(consola, " redundantes ");
+    ConsoleWriteNumber(consola, accesos->redundant, 0);
+    ConsoleWrite(consola, "\n");
+}
+#endif
+
+#if (PROFILING == 1)
+static void ComandoSondas(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    histogram_stats_t duraciones;
+
+    (void)argumentos;
+    if (cantidad != 0)
+    {
+        ConsoleWrite(consola, "error: uso sondas\n");
+        return;
+    }
+
+    // Los máximos son los costos que usa tools/respuesta.py para el análisis de tiempo de respuesta
+    for (probe_t sonda = 0; sonda < PROBES_COUNT; sonda++)
+    {
+        ProbeGetStats(sonda, &duraciones);
+        ConsoleWrite(consola, ProbeName(sonda));
+        ConsoleWrite(consola, " min/prom/p99/max ");
+        EscribirDuracion(consola, duraciones.min);
+        ConsoleWrite(consola, "/");
+        EscribirDuracion(consola, duraciones.mean);
+        ConsoleWrite(consola, "/");
+        EscribirDuracion(consola, duraciones.p99);
+        ConsoleWrite(consola, "/");
+        EscribirDuracion(consola, duraciones.max);
+        ConsoleWrite(consola, " us en ");
+        ConsoleWriteNumber(consola, duraciones.samples, 0);
+        ConsoleWrite(consola, "\n");
+    }
+}
+
+static void EscribirDuracion(console_t consola, uint32_t duracion)
+{
+    // Centésimas de microsegundo a partir de los pulsos de ProbeTimestamp
+    ConsoleWriteNumber(consola, (uint64_t)duracion * 100 / (PROBE_TIMESTAMP_HZ / 1000000), 2);
 }
+#endif
+#endif
 
 /* === Public function implementation ========================================================= */
 
+#if (configUSE_TICK_HOOK == 1)
+void vApplicationTickHook(void)
+{
+    UptimeAdvance(1000 / configTICK_RATE_HZ);
+}
+#endif
+
+#if (configUSE_IDLE_HOOK == 1)
+void vApplicationIdleHook(void)
+{
+    // Duerme hasta la próxima interrupción cuando el tick no se puede suprimir
+    __WFI();
+}
+#endif
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char * pcTaskName)
+{
+    // La pila ya está corrupta, se detiene el sistema dejando el nombre de la tarea a la vista del depurador
+    (void)xTask;
+    taskDISABLE_INTERRUPTS();
+    tarea_desbordada = pcTaskName;
+    while (true)
+    {
+    }
+}
+#endif
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+void vApplicationGetIdleTaskMemory(StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer,
+                                   uint32_t * pulIdleTaskStackSize)
+{
+    static StaticTask_t control;
+    static StackType_t pila[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &control;
+    *ppxIdleTaskStackBuffer = pila;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t ** ppxTimerTaskTCBBuffer, StackType_t ** ppxTimerTaskStackBuffer,
+                                    uint32_t * pulTimerTaskStackSize)
+{
+    static StaticTask_t control;
+    static StackType_t pila[configTIMER_TASK_STACK_DEPTH];
+
+    *ppxTimerTaskTCBBuffer = &control;
+    *ppxTimerTaskStackBuffer = pila;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
 int main(void)
 {
     board = BoardCreate();
+    ProbesInit();
     reloj = ClockCreate(1000, ActivarAlarma);
+    // Sin el RTC la hora del día es un desplazamiento sobre el tiempo desde el arranque
+    ClockSetSource(reloj, board->clock_source ? board->clock_source : UptimeClockSource());
+#if (SETTINGS == 1)
+    SettingsInit(board->settings);
+    RestaurarAjustes();
+#endif
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    eventos = xQueueCreateStatic(COLA_EVENTOS, sizeof(evento_t), cola_memoria, &cola_control);
+#else
+    eventos = xQueueCreate(COLA_EVENTOS, sizeof(evento_t));
+#endif
+    DigitalSetTimebase(UptimeStamp); // Las teclas se leen desde la interrupción de barrido
+#if (RECORDING == 1)
+    DigitalSetRecorder(RecordingSample);
+#endif
+    DisplaySetFrameCallback(board->display, RegistrarLatencia);
+#if (CONSOLE == 1)
+    Serial_Init(VELOCIDAD_UART, TerminarEnvio);
+    consola = ConsoleCreate(COMANDOS, sizeof(COMANDOS) / sizeof(COMANDOS[0]));
+    {
+        uint16_t tamanio;
+        uint8_t * recepcion = ConsoleGetReceiveBuffer(consola, &tamanio);
+
+        Serial_StartReceive(recepcion, tamanio, RecibirConsola);
+    }
+#elif (TELEMETRY == 1)
+    Serial_Init(VELOCIDAD_UART, NULL);
+#endif
+    TraceSetTimebase(UptimeStamp); // Se registran eventos desde tareas y desde interrupciones
+
+    teclas[TECLA_AJUSTAR_TIEMPO] = board->ajustar_tiempo;
+    teclas[TECLA_AJUSTAR_ALARMA] = board->ajustar_alarma;
+    teclas[TECLA_DECREMENTAR] = board->decrementar;
+    teclas[TECLA_INCREMENTAR] = board->incrementar;
+    teclas[TECLA_ACEPTAR] = board->aceptar;
+    teclas[TECLA_CANCELAR] = board->cancelar;
 
     SysTick_Init(1000);
-    CambiarModo(SIN_CONFIGURAR);
+    CambiarModo(MODO_RESTAURAR); // Muestra la hora si el RTC la conservó con la batería
+    MostrarHora();
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    xTaskCreateStatic(TareaPrincipal, "TareaPrincipal", PILA_TAREA_PRINCIPAL, NULL, tskIDLE_PRIORITY + 1, pila_principal,
+                      &control_principal);
+#else
     xTaskCreate(TareaPrincipal, "TareaPrincipal", PILA_TAREA_PRINCIPAL, NULL, tskIDLE_PRIORITY + 1, NULL);
-    xTaskCreate(TareaRefresco, "TareaRefresco", PILA_TAREA_REFRESCO, NULL, tskIDLE_PRIORITY, NULL);
+#endif
+
+    for (int plazo = 0; plazo < PLAZOS_CANTIDAD; plazo++)
+    {
+        // El período se fija al armar cada plazo
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+        plazos[plazo] =
+            xTimerCreateStatic("Plazo", 1, pdFALSE, (void *)(uintptr_t)plazo, VencerPlazo, &control_plazos[plazo]);
+#else
+        plazos[plazo] = xTimerCreate("Plazo", 1, pdFALSE, (void *)(uintptr_t)plazo, VencerPlazo);
+#endif
+    }
+
+#if (TELEMETRY == 1)
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    temporizador_telemetria = xTimerCreateStatic("Telemetria", pdMS_TO_TICKS(TELEMETRY_PERIOD), pdTRUE, NULL,
+                                                 EnviarTelemetria, &control_telemetria);
+#else
+    temporizador_telemetria =
+        xTimerCreate("Telemetria", pdMS_TO_TICKS(TELEMETRY_PERIOD), pdTRUE, NULL, EnviarTelemetria);
+#endif
+    if (telemetria_habilitada) // Deshabilitada no despierta a la tarea de temporizadores
+    {
+        xTimerStart(temporizador_telemetria, 0);
+    }
+#endif
+
+    // Pantalla, reloj y teclas se atienden desde interrupciones: ninguna tarea despierta si no pasó nada que mostrar
+    ScanTimer_Init(1, InterrupcionBarrido);
+    Keys_Init(CambiarTecla);
 
     vTaskStartScheduler();
     while (true)
@@ -0,0 +1,88 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Resumen del uso de memoria RAM
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "memoria.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+#if defined(__arm__)
+// Límites de las secciones que define el script de enlace
+extern uint8_t _data, _edata, _bss, _ebss;
+#endif
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void MemoryGetStats(memory_stats_t * stats)
+{
+    static TaskStatus_t estados[MEMORY_MAX_TASKS];
+    UBaseType_t cantidad;
+
+    memset(stats, 0, sizeof(*stats));
+
+#if defined(__arm__)
+    stats->data = &_edata - &_data;
+    stats->bss = &_ebss - &_bss;
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    stats->heap_size = configTOTAL_HEAP_SIZE;
+    stats->heap_free = xPortGetFreeHeapSize();
+#endif
+
+    vTaskSuspendAll();
+    cantidad = uxTaskGetSystemState(estados, MEMORY_MAX_TASKS, NULL);
+    for (UBaseType_t index = 0; index < cantidad; index++)
+    {
+        stats->task[index].name = estados[index].pcTaskName;
+        stats->task[index].stack_free = estados[index].usStackHighWaterMark * sizeof(StackType_t);
+    }
+    stats->tasks = cantidad;
+    xTaskResumeAll();
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -28,6 +28,7 @@ SPDX-License-Identifier: MIT
 /* === Headers files inclusions =============================================================== */
 
 #include "pantalla.h"
+#include "perfil.h"
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -52,6 +53,14 @@ struct display_s
     uint16_t flashing_count;
     uint16_t flashing_factor;
     uint8_t memory[DISPLAY_MAX_DIGITS];
+    uint32_t keys_scanning;
+    uint32_t keys;
+    bool keys_ready;
+    bool column_driven; // Ya se activó una columna, antes las filas no indican ninguna tecla
+    bool power_off;
+    uint8_t stamp_pending;
+    uint32_t stamp;
+    display_frame_shown_t FrameShown;
     struct display_driver_s driver[1];
 };
 
@@ -99,6 +108,13 @@ display_t DisplayCreate(uint8_t digits, display_driver_t driver)
         display->flashing_to = 0;
         display->flashing_count = 0;
         display->flashing_factor = 0;
+        display->keys_scanning = 0;
+        display->keys = 0;
+        display->keys_ready = false;
+        display->column_driven = false;
+        display->power_off = false;
+        display->stamp_pending = 0;
+        display->FrameShown = NULL;
         CopiarDrivers();
         BorrarMemoria();
         display->driver->ScreenTurnOff();
@@ -124,10 +140,31 @@ void DisplayRefresh(display_t display)
 {
     uint8_t segments;
 
+    if (display->power_off && !display->driver->KeysRead) // Con teclado las columnas se siguen barriendo
+    {
+        return;
+    }
+
+    PROBE_BEGIN(PROBE_DISPLAY_REFRESH);
+
+    // Lee las filas mientras la columna del dígito anterior sigue activa, salvo en el primer refresco
+    if (display->driver->KeysRead && display->column_driven)
+    {
+        uint32_t rows = display->driver->KeysRead() & ((1 << DISPLAY_KEY_ROWS) - 1);
+
+        display->keys_scanning |= rows << (display->active_digit * DISPLAY_KEY_ROWS);
+        if (display->active_digit == display->digits - 1) // Terminó el barrido de todas las columnas
+        {
+            display->keys = display->keys_scanning;
+            display->keys_ready = true;
+            display->keys_scanning = 0;
+        }
+    }
+
     display->driver->ScreenTurnOff();                                      // Borra pantalla
     display->active_digit = (display->active_digit + 1) % display->digits; // Cambia el digito avtivo entre 0 y 4.
 
-    segments = display->memory[display->active_digit];
+    segments = display->power_off ? 0 : display->memory[display->active_digit];
     if (display->flashing_factor)
     {
         if (display->active_digit == 0)
@@ -146,10 +183,30 @@ void DisplayRefresh(display_t display)
 
     display->driver->SegmentsTurnOn(segments);           // Enciende segmentos
     display->driver->DigitTurnOn(display->active_digit); // Enciende dígito
+    display->column_driven = true;
 
+    if (display->stamp_pending) // Cuenta los dígitos que faltan mostrar del cuadro marcado
+    {
+        display->stamp_pending--;
+        if ((display->stamp_pending == 0) && display->FrameShown)
+        {
+            display->FrameShown(display->stamp);
+        }
+    }
+
+    PROBE_END(PROBE_DISPLAY_REFRESH);
     return;
 }
 
+void DisplaySetPower(display_t display, bool on)
+{
+    display->power_off = !on;
+    if (display->power_off)
+    {
+        display->driver->ScreenTurnOff();
+    }
+}
+
 void DisplayFlashDigits(display_t display, uint8_t from, uint8_t to, uint16_t frec)
 {
     display->flashing_from = from;
@@ -163,6 +220,45 @@ void DisplayToggleDot(display_t display, uint8_t position)
     display->memory[position] ^= (1 << 7);
 }
 
+void DisplaySetFrameCallback(display_t display, display_frame_shown_t callback)
+{
+    display->FrameShown = callback;
+}
+
+void DisplayStampFrame(display_t display, uint32_t timestamp)
+{
+    display->stamp = timestamp;
+    display->stamp_pending = display->digits;
+}
+
+bool DisplayGetKeys(display_t display, uint32_t * keys)
+{
+    bool resultado = display->keys_ready;
+
+    *keys = display->keys;
+    display->keys_ready = false;
+
+    return resultado;
+}
+
+void DisplayWatchKeys(display_t display)
+{
+    if (!display->driver->KeysRead)
+    {
+        return;
+    }
+
+    display->driver->ScreenTurnOff();
+    for (uint8_t digit = 0; digit < display->digits; digit++)
+    {
+        display->driver->DigitTurnOn(digit);
+    }
+
+    // Con todas las columnas activas las filas no indican en qué columna está la tecla
+    display->column_driven = false;
+    display->keys_scanning = 0;
+}
+
 /* === End of documentation ==================================================================== */
 
 /** @} End of module definition for doxygen */
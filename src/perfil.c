@@ -0,0 +1,120 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Sondas de medición de tiempo de ejecución
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "perfil.h"
+#include <stddef.h>
+
+#if !defined(__arm__) && (VIRTUAL_TIME == 0)
+#include <time.h>
+#endif
+
+#if (VIRTUAL_TIME == 1)
+#include "virtual.h"
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+HISTOGRAM_DEFINE(display_refresh, PROBE_BUCKETS, PROBE_BUCKET_WIDTH);
+HISTOGRAM_DEFINE(clock_refresh, PROBE_BUCKETS, PROBE_BUCKET_WIDTH);
+HISTOGRAM_DEFINE(seconds_increment, PROBE_BUCKETS, PROBE_BUCKET_WIDTH);
+HISTOGRAM_DEFINE(key_handling, PROBE_BUCKETS, PROBE_BUCKET_WIDTH);
+
+static const histogram_t histogramas[PROBES_COUNT] = {
+    [PROBE_DISPLAY_REFRESH] = display_refresh,
+    [PROBE_CLOCK_REFRESH] = clock_refresh,
+    [PROBE_SECONDS_INCREMENT] = seconds_increment,
+    [PROBE_KEY_HANDLING] = key_handling,
+};
+
+static const char * const NOMBRES[PROBES_COUNT] = {
+    [PROBE_DISPLAY_REFRESH] = "DisplayRefresh",
+    [PROBE_CLOCK_REFRESH] = "ClockRefresh",
+    [PROBE_SECONDS_INCREMENT] = "SecondsIncrement",
+    [PROBE_KEY_HANDLING] = "KeyHandling",
+};
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+#if !defined(__arm__) && (VIRTUAL_TIME == 0)
+uint32_t ProbeTimestamp(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint32_t)(ahora.tv_sec * 1000000000ULL + ahora.tv_nsec);
+}
+#endif
+
+void ProbesInit(void)
+{
+#if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    for (int probe = 0; probe < PROBES_COUNT; probe++)
+    {
+        HistogramReset(histogramas[probe]);
+    }
+}
+
+void ProbeRecord(probe_t probe, uint32_t elapsed)
+{
+    HistogramRecord(histogramas[probe], elapsed);
+#if (VIRTUAL_TIME == 1)
+    VirtualProbe(probe); // En tiempo virtual la duración no dice nada, importa qué trabajo ejecutó el camino
+#endif
+}
+
+const char * ProbeName(probe_t probe)
+{
+    return (probe < PROBES_COUNT) ? NOMBRES[probe] : NULL;
+}
+
+void ProbeGetStats(probe_t probe, histogram_stats_t * stats)
+{
+    HistogramGetStats(histogramas[probe], stats);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,110 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Monitor de período y fluctuación de tareas periódicas
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "periodo.h"
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void PeriodMonitorStart(period_monitor_t monitor, uint32_t period, uint32_t tolerance, uint32_t now)
+{
+    HistogramReset(monitor->jitter);
+    monitor->scale = (1000ULL << 32) / period;
+    monitor->period = period;
+    monitor->tolerance = tolerance;
+    monitor->expected = now;
+    monitor->activations = 0;
+    monitor->late = 0;
+    monitor->missed = 0;
+    monitor->max_lateness = 0;
+
+    return;
+}
+
+uint32_t PeriodMonitorWake(period_monitor_t monitor, uint32_t now)
+{
+    int32_t diferencia = (int32_t)(now - monitor->expected);
+    uint32_t retraso = (diferencia > 0) ? (uint32_t)diferencia : 0; // Una activación adelantada no tiene retraso
+    uint32_t periodos = 0;
+
+    monitor->expected += monitor->period;
+    monitor->activations++;
+
+    if (retraso > monitor->max_lateness)
+    {
+        monitor->max_lateness = retraso;
+    }
+    if (retraso >= monitor->tolerance)
+    {
+        monitor->late++;
+    }
+
+    if (retraso < monitor->period)
+    {
+        // Como el retraso es menor que el período el producto entra en 64 bits y se evita la división
+        HistogramRecord(monitor->jitter, (uint32_t)((retraso * monitor->scale) >> 32));
+    }
+    else
+    {
+        // Solo las activaciones que perdieron su plazo pagan la división
+        periodos = retraso / monitor->period;
+        monitor->missed++;
+        HistogramRecord(monitor->jitter, (uint32_t)(((uint64_t)retraso * 1000) / monitor->period));
+    }
+
+    return periodos;
+}
+
+void PeriodMonitorGetStats(period_monitor_t monitor, period_stats_t * stats)
+{
+    stats->activations = monitor->activations;
+    stats->late = monitor->late;
+    stats->missed = monitor->missed;
+    stats->max_lateness = monitor->max_lateness;
+    HistogramGetStats(monitor->jitter, &stats->jitter);
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,121 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pool estático de descriptores
+ **
+ ** \addtogroup hal HAL
+ ** \brief Capa de abstracción de hardware
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "pool.h"
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void * PoolAllocate(pool_t pool)
+{
+    void * item = NULL;
+
+    for (uint16_t word = 0; word < POOL_BITMAP_WORDS(pool->capacity); word++)
+    {
+        uint32_t libres = ~pool->bitmap[word];
+
+        if (libres) // Hay al menos un bit libre en esta palabra
+        {
+            uint16_t index = word * 32 + __builtin_ctz(libres);
+
+            // Los bits se ocupan de menor a mayor, un libre fuera de rango indica que el pool está lleno
+            if (index < pool->capacity)
+            {
+                pool->bitmap[word] |= (1UL << (index % 32));
+                item = (uint8_t *)pool->items + index * pool->item_size;
+                memset(item, 0, pool->item_size);
+
+                pool->used++;
+                if (pool->used > pool->peak)
+                {
+                    pool->peak = pool->used;
+                }
+            }
+            break;
+        }
+    }
+
+    if (!item)
+    {
+        pool->failures++;
+    }
+
+    return item;
+}
+
+bool PoolRelease(pool_t pool, void * item)
+{
+    bool resultado = false;
+    uintptr_t offset = (uintptr_t)item - (uintptr_t)pool->items;
+
+    // Un puntero anterior al arreglo da un offset enorme y también queda fuera de rango
+    if (item && (offset < (uintptr_t)pool->capacity * pool->item_size) && (offset % pool->item_size == 0))
+    {
+        uint16_t index = offset / pool->item_size;
+        uint32_t mascara = 1UL << (index % 32);
+
+        if (pool->bitmap[index / 32] & mascara) // El elemento estaba en uso
+        {
+            pool->bitmap[index / 32] &= ~mascara;
+            pool->used--;
+            resultado = true;
+        }
+    }
+
+    return resultado;
+}
+
+void PoolGetStats(pool_t pool, pool_stats_t * stats)
+{
+    stats->capacity = pool->capacity;
+    stats->used = pool->used;
+    stats->peak = pool->peak;
+    stats->failures = pool->failures;
+    stats->bytes = pool->capacity * pool->item_size + POOL_BITMAP_WORDS(pool->capacity) * sizeof(uint32_t);
+
+    return;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -22,6 +22,8 @@ SPDX-License-Identifier: MIT
 
 #include "reloj.h"
 #include "controlbcd.h"
+#include "perfil.h"
+#include "traza.h"
 #include <stddef.h>
 #include <string.h>
 
@@ -29,6 +31,16 @@ SPDX-License-Identifier: MIT
 
 #define Compara(a, b) memcmp(reloj->a, reloj->b, sizeof(reloj->a)) == 0
 
+//! Empaqueta una hora de seis dígitos como tres bytes BCD (horas, minutos y segundos) para la traza.
+#define TrazaHora(hora)                                                                                                \
+    TRACE_DATA(((hora)[0] << 4) | (hora)[1], ((hora)[2] << 4) | (hora)[3], ((hora)[4] << 4) | (hora)[5])
+
+//! Segundos de un día.
+#define SEGUNDOS_DIA 86400
+
+//! Mayor salto de una fuente que se recorre segundo a segundo revisando la alarma, uno mayor es un ajuste de la hora.
+#define SALTO_MAXIMO 60
+
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
@@ -40,6 +52,8 @@ struct clock_s
     bool hora_valida : 1;   //! Indicador de hora válida.
     int tics_por_segundo;   //! Cantidad de tics para incrementar la hora en un segundo.
     int tics_actual;        //! Cantidad de tics actuales.
+    clock_source_t fuente;  //! Fuente de la hora, NULL para contar los tics.
+    uint32_t segundos;      //! Segundos desde la medianoche en la última lectura de la fuente.
 
     alarma_event_t ActivarAlarma; //! Función callback para activar la alarma.
     uint8_t alarma[6];            //! Vector de tamaño 6 con la alarma.
@@ -53,6 +67,11 @@ struct clock_s
 
 void AlarmCheck(clock_t reloj);
 
+/**
+ * @brief Lleva la hora del reloj a la que leyó de la fuente, revisando la alarma en cada segundo intermedio.
+ */
+void SourceAdvance(clock_t reloj, uint32_t segundos);
+
 /* === Public variable definitions ============================================================= */
 
 /* === Private variable definitions ============================================================ */
@@ -64,17 +83,39 @@ void AlarmCheck(clock_t reloj)
     // Alarma normal
     if (Compara(hora_actual, alarma) && reloj->alarma_habilitada && !(reloj->alarma_pospuesta))
     {
+        TraceRecord(TRACE_ALARM_FIRE, 0);
         reloj->ActivarAlarma(true);
     }
 
     // alarma pospuesta
     if (Compara(hora_actual, alarma_nueva) && reloj->alarma_habilitada && reloj->alarma_pospuesta)
     {
+        TraceRecord(TRACE_ALARM_FIRE, 1);
         reloj->ActivarAlarma(true);
         reloj->alarma_pospuesta = false;
     }
 }
 
+void SourceAdvance(clock_t reloj, uint32_t segundos)
+{
+    uint32_t salto = (segundos + SEGUNDOS_DIA - reloj->segundos) % SEGUNDOS_DIA;
+
+    if (salto <= SALTO_MAXIMO)
+    {
+        // Un ClockRefresh demorado, o el RTC que avanzó entre dos lecturas, no saltea la alarma
+        for (uint32_t segundo = 0; segundo < salto; segundo++)
+        {
+            SecondsIncrement(reloj->hora_actual);
+            AlarmCheck(reloj);
+        }
+    }
+    else
+    {
+        SegundosAHora(segundos, reloj->hora_actual);
+    }
+    reloj->segundos = segundos;
+}
+
 /* === Public function implementation ========================================================== */
 
 //******Funciones asociadas al reloj*******//
@@ -90,23 +131,65 @@ clock_t ClockCreate(int tics_por_segundo, alarma_event_t ActivarAlarma)
     return self;
 }
 
+void ClockSetSource(clock_t reloj, clock_source_t fuente)
+{
+    reloj->fuente = fuente;
+    reloj->tics_actual = 0;
+
+    if (fuente)
+    {
+        reloj->hora_valida = fuente->Read(&reloj->segundos);
+        SegundosAHora(reloj->segundos, reloj->hora_actual);
+    }
+
+    return;
+}
+
 bool ClockRefresh(clock_t reloj)
 {
-    reloj->tics_actual++;
+    bool resultado = false;
 
-    if (reloj->tics_actual >= reloj->tics_por_segundo)
+    PROBE_BEGIN(PROBE_CLOCK_REFRESH);
+    if (reloj->fuente)
     {
-        reloj->tics_actual = 0;
-        SecondsIncrement(reloj->hora_actual);
-        AlarmCheck(reloj);
+        uint32_t segundos;
+
+        // Los tics dentro del segundo se cuentan desde el cambio que se vio en la fuente
+        reloj->fuente->Read(&segundos);
+        if (segundos != reloj->segundos)
+        {
+            SourceAdvance(reloj, segundos);
+            reloj->tics_actual = 0;
+        }
+        else if (reloj->tics_actual < reloj->tics_por_segundo)
+        {
+            reloj->tics_actual++;
+        }
+    }
+    else
+    {
+        reloj->tics_actual++;
+
+        if (reloj->tics_actual >= reloj->tics_por_segundo)
+        {
+            reloj->tics_actual = 0;
+            SecondsIncrement(reloj->hora_actual);
+            AlarmCheck(reloj);
+        }
     }
 
     if ((reloj->tics_actual >= (reloj->tics_por_segundo / 2)))
     {
-        return true;
+        resultado = true;
     }
+    PROBE_END(PROBE_CLOCK_REFRESH);
 
-    return false;
+    return resultado;
+}
+
+bool ClockSecondChanged(clock_t reloj)
+{
+    return reloj->tics_actual == 0; // Con fuente, los tics quedan topeados hasta el próximo cambio
 }
 
 bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size)
@@ -117,6 +200,12 @@ bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size)
     {
         memcpy(reloj->hora_actual, hora, size);
         reloj->hora_valida = true;
+        if (reloj->fuente)
+        {
+            reloj->segundos = HoraASegundos(reloj->hora_actual);
+            reloj->fuente->Write(reloj->segundos);
+        }
+        TraceRecord(TRACE_CLOCK_SET, TrazaHora(reloj->hora_actual));
     }
 
     return reloj->hora_valida;
@@ -124,9 +213,23 @@ bool ClockSetTime(clock_t reloj, const uint8_t * hora, int size)
 
 bool ClockGetTime(clock_t reloj, uint8_t * hora, int size)
 {
-    memcpy(hora, reloj->hora_actual, size);
+    uint8_t actual[6];
+    uint32_t segundos;
+    bool valida = reloj->hora_valida;
 
-    return reloj->hora_valida;
+    if (reloj->fuente)
+    {
+        // La hora de la fuente no depende de que ClockRefresh se haya llamado desde el último segundo
+        valida = reloj->fuente->Read(&segundos) && valida;
+        SegundosAHora(segundos, actual);
+        memcpy(hora, actual, size);
+    }
+    else
+    {
+        memcpy(hora, reloj->hora_actual, size);
+    }
+
+    return valida;
 }
 
 //*****Funciones asociadas a la alarma*****//
@@ -140,6 +243,7 @@ void AlarmEnamble(clock_t reloj, bool estado)
 
 void AlarmPostpone(clock_t reloj, uint8_t minutos)
 {
+    TraceRecord(TRACE_ALARM_SNOOZE, minutos);
     if (!reloj->alarma_pospuesta) // Se ejecuta solo la primera vez que se pospone
     {
         memcpy(reloj->alarma_nueva, reloj->alarma, sizeof(reloj->alarma_nueva));
@@ -157,6 +261,7 @@ void AlarmPostpone(clock_t reloj, uint8_t minutos)
 
 void AlarmCancel(clock_t reloj)
 {
+    TraceRecord(TRACE_ALARM_CANCEL, 0);
     reloj->ActivarAlarma(false);
 
     return;
@@ -172,6 +277,7 @@ bool AlarmSetTime(clock_t reloj, const uint8_t * alarma, int size)
         memcpy(reloj->alarma, alarma, size);
         AlarmEnamble(reloj, true);
         reloj->alarma_valida = true;
+        TraceRecord(TRACE_ALARM_SET, TrazaHora(reloj->alarma));
     }
 
     return reloj->alarma_valida;
@@ -0,0 +1,241 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Tramas binarias de telemetría
+ **
+ ** \addtogroup metricas METRICAS
+ ** \brief Mediciones de desempeño
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "telemetria.h"
+#include "traza.h"
+
+/* === Macros definitions ====================================================================== */
+
+//! Tamaño de una trama sin codificar: tipo, secuencia, datos y CRC.
+#define TRAMA_MAXIMA (TELEMETRY_MAX_PAYLOAD + 4)
+
+/* === Private data type declarations ========================================================== */
+
+//! Trama en construcción antes de codificarla.
+typedef struct trama_s
+{
+    uint8_t datos[TRAMA_MAXIMA]; //!< Tipo, secuencia, datos y lugar para el CRC.
+    uint16_t largo;              //!< Cantidad de bytes escritos.
+} trama_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Comienza una trama escribiendo el tipo y el número de secuencia.
+ */
+static void Comenzar(trama_t * trama, telemetry_frame_t tipo);
+
+/**
+ * @brief Agrega un valor de 8, 16 o 32 bits a la trama, en little endian.
+ */
+static void Agregar8(trama_t * trama, uint8_t valor);
+static void Agregar16(trama_t * trama, uint16_t valor);
+static void Agregar32(trama_t * trama, uint32_t valor);
+
+/**
+ * @brief Agrega una hora de seis dígitos como tres bytes BCD.
+ */
+static void AgregarHora(trama_t * trama, const uint8_t * hora);
+
+/**
+ * @brief Calcula el CRC-16/CCITT (polinomio 0x1021, valor inicial 0xFFFF) con una tabla de 16 entradas.
+ */
+static uint16_t Crc16(const uint8_t * datos, uint16_t largo);
+
+/**
+ * @brief Agrega el CRC, codifica la trama con COBS y agrega el delimitador.
+ *
+ * @return uint16_t Cantidad de bytes escritos en la salida, cero si no entran.
+ */
+static uint16_t Terminar(trama_t * trama, uint8_t * salida, uint16_t capacidad);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static uint8_t secuencia = 0;
+
+/* === Private function implementation ========================================================= */
+
+static void Comenzar(trama_t * trama, telemetry_frame_t tipo)
+{
+    trama->largo = 0;
+    Agregar8(trama, tipo);
+    Agregar8(trama, secuencia++);
+}
+
+static void Agregar8(trama_t * trama, uint8_t valor)
+{
+    if (trama->largo < TRAMA_MAXIMA - 2) // Siempre queda lugar para el CRC
+    {
+        trama->datos[trama->largo++] = valor;
+    }
+}
+
+static void Agregar16(trama_t * trama, uint16_t valor)
+{
+    Agregar8(trama, valor);
+    Agregar8(trama, valor >> 8);
+}
+
+static void Agregar32(trama_t * trama, uint32_t valor)
+{
+    Agregar16(trama, valor);
+    Agregar16(trama, valor >> 16);
+}
+
+static void AgregarHora(trama_t * trama, const uint8_t * hora)
+{
+    for (int index = 0; index < 6; index += 2)
+    {
+        Agregar8(trama, (hora[index] << 4) | hora[index + 1]);
+    }
+}
+
+static uint16_t Crc16(const uint8_t * datos, uint16_t largo)
+{
+    static const uint16_t TABLA[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t index = 0; index < largo; index++)
+    {
+        crc = (crc << 4) ^ TABLA[(crc >> 12) ^ (datos[index] >> 4)];
+        crc = (crc << 4) ^ TABLA[(crc >> 12) ^ (datos[index] & 0x0F)];
+    }
+
+    return crc;
+}
+
+static uint16_t Terminar(trama_t * trama, uint8_t * salida, uint16_t capacidad)
+{
+    uint16_t crc = Crc16(trama->datos, trama->largo);
+    uint16_t codigo = 0;  // Posición del byte de código del bloque actual
+    uint16_t escrito = 1; // El primer byte de la salida es el primer código
+    uint8_t bloque = 1;   // Distancia desde el código hasta el próximo cero
+
+    trama->datos[trama->largo++] = crc;
+    trama->datos[trama->largo++] = crc >> 8;
+
+    // En el peor caso COBS agrega un byte cada 254 y se suma el delimitador
+    if (capacidad < trama->largo + trama->largo / 254 + 2)
+    {
+        return 0;
+    }
+
+    for (uint16_t index = 0; index < trama->largo; index++)
+    {
+        if (trama->datos[index] != 0)
+        {
+            salida[escrito++] = trama->datos[index];
+            bloque++;
+        }
+        if ((trama->datos[index] == 0) || (bloque == 0xFF))
+        {
+            salida[codigo] = bloque;
+            codigo = escrito++;
+            bloque = 1;
+        }
+    }
+    salida[codigo] = bloque;
+    salida[escrito++] = 0;
+
+    return escrito;
+}
+
+/* === Public function implementation ========================================================== */
+
+uint16_t TelemetryEncodeStatus(const telemetry_status_t * status, uint8_t * output, uint16_t size)
+{
+    trama_t trama;
+
+    Comenzar(&trama, TELEMETRY_STATUS);
+    Agregar32(&trama, status->uptime);
+    AgregarHora(&trama, status->time);
+    AgregarHora(&trama, status->alarm);
+    Agregar8(&trama, status->mode);
+    Agregar8(&trama, status->time_valid | (status->alarm_enabled << 1) | (status->alarm_ringing << 2));
+    Agregar32(&trama, status->main_wakeups);
+    Agregar32(&trama, status->scan_wakeups);
+    Agregar32(&trama, status->lost_events);
+    Agregar16(&trama, status->idle);
+    Agregar32(&trama, status->latency.samples);
+    Agregar32(&trama, status->latency.min);
+    Agregar32(&trama, status->latency.mean);
+    Agregar32(&trama, status->latency.p99);
+    Agregar32(&trama, status->latency.max);
+    Agregar32(&trama, status->scan.activations);
+    Agregar32(&trama, status->scan.late);
+    Agregar32(&trama, status->scan.missed);
+    Agregar32(&trama, status->scan.max_lateness);
+    Agregar32(&trama, status->scan.jitter.p99);
+    Agregar32(&trama, status->scan.jitter.max);
+    Agregar32(&trama, status->trace_written);
+
+    return Terminar(&trama, output, size);
+}
+
+uint16_t TelemetryEncodeTrace(uint32_t * cursor, uint8_t * output, uint16_t size)
+{
+    trace_entry_t eventos[TELEMETRY_TRACE_ENTRIES];
+    uint32_t primero;
+    uint16_t cantidad;
+    trama_t trama;
+
+    if (size < TELEMETRY_MAX_FRAME) // Se verifica antes de leer para no perder los eventos
+    {
+        return 0;
+    }
+
+    cantidad = TraceRead(cursor, eventos, TELEMETRY_TRACE_ENTRIES);
+    if (cantidad == 0)
+    {
+        return 0;
+    }
+    primero = *cursor - cantidad;
+
+    Comenzar(&trama, TELEMETRY_TRACE);
+    Agregar32(&trama, primero);
+    Agregar8(&trama, cantidad);
+    for (uint16_t index = 0; index < cantidad; index++)
+    {
+        Agregar32(&trama, eventos[index].timestamp);
+        Agregar32(&trama, eventos[index].event);
+    }
+
+    return Terminar(&trama, output, size);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,142 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Tiempo desde el arranque
+ **
+ ** Los milisegundos se guardan en dos palabras de 32 bits porque en el Cortex-M4 una lectura de 64 bits no es
+ ** atómica respecto de las interrupciones. Los segundos enteros se cuentan aparte, para que la fuente de la hora, que
+ ** se lee en cada tick, no tenga que dividir 64 bits.
+ **
+ ** \addtogroup tiempo TIEMPO
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "tiempo.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Segundos de un día.
+#define SEGUNDOS_DIA 86400
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static bool FuenteLeer(uint32_t * seconds);
+static void FuenteEscribir(uint32_t seconds);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+// Solo los escribe la interrupción del tick
+static volatile uint32_t alta = 0;
+static volatile uint32_t baja = 0;
+static volatile uint32_t segundos = 0;
+static uint32_t resto = 0; // Milisegundos desde el último segundo entero
+
+// Desplazamiento de la hora del día respecto de los segundos desde el arranque
+static uint32_t desplazamiento = 0;
+static bool fijada = false;
+
+/* === Private function implementation ========================================================= */
+
+static bool FuenteLeer(uint32_t * seconds)
+{
+    *seconds = (segundos % SEGUNDOS_DIA + desplazamiento) % SEGUNDOS_DIA;
+
+    return fijada;
+}
+
+static void FuenteEscribir(uint32_t seconds)
+{
+    desplazamiento = (seconds + SEGUNDOS_DIA - segundos % SEGUNDOS_DIA) % SEGUNDOS_DIA;
+    fijada = true;
+
+    return;
+}
+
+/* === Public function implementation ========================================================== */
+
+void UptimeAdvance(uint32_t milliseconds)
+{
+    uint32_t anterior = baja;
+
+    baja = anterior + milliseconds;
+    if (baja < anterior)
+    {
+        alta = alta + 1;
+    }
+
+    resto += milliseconds;
+    if (resto >= 1000)
+    {
+        segundos = segundos + resto / 1000;
+        resto %= 1000;
+    }
+
+    return;
+}
+
+uint64_t UptimeMilliseconds(void)
+{
+    uint32_t parte_alta, parte_baja;
+
+    // Si la interrupción del tick llevó la cuenta a la parte alta entre las lecturas, la parte baja ya no le corresponde
+    do
+    {
+        parte_alta = alta;
+        parte_baja = baja;
+    } while (parte_alta != alta);
+
+    return ((uint64_t)parte_alta << 32) | parte_baja;
+}
+
+uint32_t UptimeStamp(void)
+{
+    return baja;
+}
+
+uint64_t UptimeExpand(uint32_t stamp)
+{
+    uint64_t ahora = UptimeMilliseconds();
+
+    return ahora - (uint32_t)((uint32_t)ahora - stamp);
+}
+
+clock_source_t UptimeClockSource(void)
+{
+    static const struct clock_source_s fuente = {
+        .Read = FuenteLeer,
+        .Write = FuenteEscribir,
+    };
+
+    return &fuente;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
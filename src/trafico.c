@@ -0,0 +1,221 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Contabilidad del tráfico de los puertos GPIO
+ **
+ ** \addtogroup metricas METRICAS
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "trafico.h"
+#include <stddef.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Cuenta un acceso en el puerto y en el lugar de llamada, y agrega el lugar a la lista si es nuevo.
+ *
+ * @param write     El acceso es una escritura.
+ * @param redundant La escritura no cambia ningún terminal.
+ */
+static void Contar(traffic_site_t * site, uint8_t port, bool write, bool redundant);
+
+/**
+ * @brief Incrementa los contadores que corresponden a un acceso.
+ */
+static void Sumar(traffic_counts_t * counts, bool write, bool redundant);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static traffic_counts_t puertos[TRAFFIC_PORTS];
+static traffic_site_t * lugares = NULL;
+
+/* === Private function implementation ========================================================= */
+
+static void Contar(traffic_site_t * site, uint8_t port, bool write, bool redundant)
+{
+    // Solo el primero que marca el lugar lo agrega, aunque una interrupción lo use en medio de una tarea
+    if (!__atomic_test_and_set(&site->listed, __ATOMIC_RELAXED))
+    {
+        site->next = __atomic_load_n(&lugares, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&lugares, &site->next, site, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+        }
+    }
+
+    Sumar(&site->counts, write, redundant);
+    if (port < TRAFFIC_PORTS)
+    {
+        Sumar(&puertos[port], write, redundant);
+    }
+
+    return;
+}
+
+static void Sumar(traffic_counts_t * counts, bool write, bool redundant)
+{
+    if (!write)
+    {
+        __atomic_fetch_add(&counts->reads, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    __atomic_fetch_add(&counts->writes, 1, __ATOMIC_RELAXED);
+    if (redundant)
+    {
+        __atomic_fetch_add(&counts->redundant, 1, __ATOMIC_RELAXED);
+    }
+
+    return;
+}
+
+/* === Public function implementation ========================================================== */
+
+void TrafficGetPort(uint8_t port, traffic_counts_t * counts)
+{
+    if (port < TRAFFIC_PORTS)
+    {
+        *counts = puertos[port];
+    }
+
+    return;
+}
+
+const traffic_site_t * TrafficGetSites(void)
+{
+    return __atomic_load_n(&lugares, __ATOMIC_ACQUIRE);
+}
+
+void TrafficClear(void)
+{
+    for (int port = 0; port < TRAFFIC_PORTS; port++)
+    {
+        puertos[port] = (traffic_counts_t){0};
+    }
+
+    for (traffic_site_t * site = __atomic_load_n(&lugares, __ATOMIC_ACQUIRE); site; site = site->next)
+    {
+        site->counts = (traffic_counts_t){0};
+    }
+
+    return;
+}
+
+// Las funciones de LPCOpen se llaman entre paréntesis para que no las reemplacen las macros de trafico.h
+
+void TrafficSetPinDIR(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool output)
+{
+    Contar(site, port, true, ((pGPIO->DIR[port] >> pin) & 1) == output);
+    (Chip_GPIO_SetPinDIR)(pGPIO, port, pin, output);
+
+    return;
+}
+
+void TrafficSetPortDIRInput(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pinMask)
+{
+    Contar(site, port, true, (pGPIO->DIR[port] & pinMask) == 0);
+    (Chip_GPIO_SetPortDIRInput)(pGPIO, port, pinMask);
+
+    return;
+}
+
+void TrafficSetPinState(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin, bool setting)
+{
+    Contar(site, port, true, ((pGPIO->SET[port] >> pin) & 1) == setting);
+    (Chip_GPIO_SetPinState)(pGPIO, port, pin, setting);
+
+    return;
+}
+
+void TrafficSetPinToggle(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint8_t pin)
+{
+    Contar(site, port, true, false);
+    (Chip_GPIO_SetPinToggle)(pGPIO, port, pin);
+
+    return;
+}
+
+void TrafficSetValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue)
+{
+    Contar(site, port, true, (bitValue & ~pGPIO->SET[port]) == 0);
+    (Chip_GPIO_SetValue)(pGPIO, port, bitValue);
+
+    return;
+}
+
+void TrafficClearValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t bitValue)
+{
+    Contar(site, port, true, (bitValue & pGPIO->SET[port]) == 0);
+    (Chip_GPIO_ClearValue)(pGPIO, port, bitValue);
+
+    return;
+}
+
+void TrafficSetPortToggle(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t pins)
+{
+    Contar(site, port, true, pins == 0);
+    (Chip_GPIO_SetPortToggle)(pGPIO, port, pins);
+
+    return;
+}
+
+void TrafficSetPortMask(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t mask)
+{
+    Contar(site, port, true, mask == pGPIO->MASK[port]);
+    (Chip_GPIO_SetPortMask)(pGPIO, port, mask);
+
+    return;
+}
+
+void TrafficSetMaskedPortValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port, uint32_t value)
+{
+    Contar(site, port, true, ((value ^ pGPIO->SET[port]) & ~pGPIO->MASK[port]) == 0);
+    (Chip_GPIO_SetMaskedPortValue)(pGPIO, port, value);
+
+    return;
+}
+
+bool TrafficReadPortBit(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint32_t port, uint8_t pin)
+{
+    Contar(site, port, false, false);
+
+    return (Chip_GPIO_ReadPortBit)(pGPIO, port, pin);
+}
+
+uint32_t TrafficGetPortValue(traffic_site_t * site, LPC_GPIO_T * pGPIO, uint8_t port)
+{
+    Contar(site, port, false, false);
+
+    return (Chip_GPIO_GetPortValue)(pGPIO, port);
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
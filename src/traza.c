@@ -0,0 +1,141 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Registro binario de eventos en un buffer circular
+ **
+ ** \addtogroup traza TRAZA
+ ** \brief Registro de eventos para diagnóstico
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "traza.h"
+
+/* === Macros definitions ====================================================================== */
+
+#if (TRACE_ENTRIES & (TRACE_ENTRIES - 1)) != 0
+#error "TRACE_ENTRIES debe ser una potencia de dos"
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+//! Buffer completo tal como lo lee la herramienta de decodificación.
+struct trace_buffer_s
+{
+    uint32_t magic;                       //!< Identificador del formato, TRACE_MAGIC.
+    uint16_t capacity;                    //!< Cantidad de eventos del buffer.
+    uint16_t entry_size;                  //!< Tamaño de cada evento en bytes.
+    volatile uint32_t written;            //!< Cantidad total de eventos registrados desde el inicio.
+    trace_entry_t entries[TRACE_ENTRIES]; //!< Eventos, el siguiente se escribe en written % capacity.
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static struct trace_buffer_s traza = {
+    .magic = TRACE_MAGIC,
+    .capacity = TRACE_ENTRIES,
+    .entry_size = sizeof(trace_entry_t),
+};
+
+static trace_timebase_t timebase = NULL;
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void TraceSetTimebase(trace_timebase_t function)
+{
+    timebase = function;
+
+    return;
+}
+
+void TraceRecord(trace_event_t event, uint32_t data)
+{
+    // La reserva atómica de la posición permite que una interrupción registre en medio de una tarea sin pisarla
+    uint32_t index = __atomic_fetch_add(&traza.written, 1, __ATOMIC_RELAXED) & (TRACE_ENTRIES - 1);
+    trace_entry_t * entry = &traza.entries[index];
+
+    entry->event = 0; // Marca el evento como incompleto para TraceRead hasta que termine de escribirse
+    entry->timestamp = timebase ? timebase() : 0;
+    entry->event = (uint32_t)event | (data << 8);
+
+    return;
+}
+
+uint16_t TraceRead(uint32_t * cursor, trace_entry_t * entries, uint16_t count)
+{
+    uint32_t written = __atomic_load_n(&traza.written, __ATOMIC_RELAXED);
+    uint16_t copied = 0;
+
+    if ((int32_t)(written - *cursor) < 0) // El buffer se vació después de la lectura anterior
+    {
+        *cursor = 0;
+    }
+    if (written - *cursor > TRACE_ENTRIES) // Los eventos más antiguos ya se pisaron
+    {
+        *cursor = written - TRACE_ENTRIES;
+    }
+
+    while ((*cursor != written) && (copied < count))
+    {
+        trace_entry_t * entry = &traza.entries[*cursor & (TRACE_ENTRIES - 1)];
+
+        entries[copied] = *entry;
+        if (entries[copied].event == 0)
+        {
+            break;
+        }
+        copied++;
+        (*cursor)++;
+    }
+
+    return copied;
+}
+
+uint32_t TraceCount(void)
+{
+    return __atomic_load_n(&traza.written, __ATOMIC_RELAXED);
+}
+
+void TraceClear(void)
+{
+    __atomic_store_n(&traza.written, 0, __ATOMIC_RELAXED);
+
+    return;
+}
+
+const void * TraceGetBuffer(size_t * size)
+{
+    *size = sizeof(traza);
+
+    return &traza;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Envía comandos a la consola del reloj despertador por la UART de depuración y muestra las respuestas.
+
+Cada respuesta termina con el indicador "> " y un byte cero. Los bloques terminados en cero que no terminan con el
+indicador son tramas de telemetría y se descartan, por lo que no hace falta deshabilitarla.
+
+Uso: consola.py /dev/ttyUSB1 "hora 07:30" "alarma 06:45" alarma    (o la pseudo terminal de tools/consola_pty.c)
+     Sin comandos los lee de la entrada estándar, uno por línea. Termina con error si alguna respuesta lo es.
+"""
+
+import argparse
+import os
+import select
+import sys
+
+from telemetria import abrir
+
+INDICADOR = b"> "
+
+
+def respuesta(descriptor, espera, pendiente):
+    """Devuelve la próxima respuesta de la consola, sin el indicador, o None si no llega a tiempo."""
+    while True:
+        while 0 in pendiente:
+            fin = pendiente.index(0)
+            bloque = bytes(pendiente[:fin])
+            del pendiente[:fin + 1]
+            if bloque.endswith(INDICADOR):
+                return bloque[:-len(INDICADOR)].decode("ascii", errors="replace")
+        if not select.select([descriptor], [], [], espera)[0]:
+            return None
+        pendiente += os.read(descriptor, 256)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("puerto", help="puerto serie o pseudo terminal")
+    parser.add_argument("comandos", nargs="*", help="comandos a enviar, por defecto los de la entrada estándar")
+    parser.add_argument("--baudios", type=int, default=115200, help="velocidad del puerto serie")
+    parser.add_argument("--espera", type=float, default=3.0, help="segundos que se espera cada respuesta")
+    args = parser.parse_args()
+
+    descriptor = abrir(args.puerto, args.baudios, os.O_RDWR)
+    pendiente = bytearray()
+    errores = 0
+
+    for comando in args.comandos or (linea.strip() for linea in sys.stdin):
+        os.write(descriptor, comando.encode("ascii") + b"\r")
+        texto = respuesta(descriptor, args.espera, pendiente)
+        if texto is None:
+            print("%s: sin respuesta" % comando, file=sys.stderr)
+            return 2
+        print("> %s\n%s" % (comando, texto.replace("\r\n", "\n")), end="")
+        sys.stdout.flush()
+        errores += texto.startswith("error")
+
+    os.close(descriptor)
+    return 1 if errores else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,255 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Consola de comandos en una pseudo terminal
+ **
+ ** Atiende en una pseudo terminal la misma consola que el equipo ofrece por la UART de depuración, con el módulo
+ ** src/consola.c y el reloj de src/reloj.c. Los bytes recibidos se copian al buffer circular de la consola como lo
+ ** haría el DMA, de modo que se ejercitan la búsqueda de líneas y la separación de argumentos sobre el buffer. La hora
+ ** la cuenta el reloj monótono de la computadora con la fuente de host/src/monotonico.c. Sirve para probar la consola
+ ** y tools/consola.py sin la placa:
+ **
+ **     gcc -Iinc -Ihost/inc -o consola_pty tools/consola_pty.c src/consola.c src/reloj.c src/controlbcd.c \
+ **         src/traza.c host/src/monotonico.c
+ **     ./consola_pty &
+ **     python3 tools/consola.py /dev/pts/N "hora 12:30:00" alarma
+ **
+ ** \addtogroup herramientas HERRAMIENTAS
+ ** \brief Herramientas para la computadora
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+// reloj.h llama clock_t a la referencia del reloj, que choca con el tipo de la biblioteca estándar
+#define clock_t reloj_t
+#include "reloj.h"
+#undef clock_t
+
+#include "consola.h"
+#include "controlbcd.h"
+#include "monotonico.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Período de revisión de la recepción en milisegundos; el equipo la revisa en cada interrupción de la UART.
+#define PERIODO_CONSOLA 20
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Informa por la salida de errores cuando la alarma comienza o deja de sonar.
+ */
+static void ActivarAlarma(bool estado);
+
+/**
+ * @brief Copia lo recibido al buffer de la consola, volviendo al comienzo al llegar al final como el DMA.
+ *
+ * @return int Cantidad de bytes copiados, negativo si la pseudo terminal se cerró.
+ */
+static int Recibir(int descriptor);
+
+static void ComandoHora(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void ComandoAlarma(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+static void ComandoEstado(console_t consola, uint8_t cantidad, const console_argument_t * argumentos);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static reloj_t reloj;
+static console_t consola;
+static uint8_t * recepcion;
+static uint16_t tamanio;
+static uint16_t posicion = 0;
+static uint32_t milisegundos = 0;
+
+static const console_command_t COMANDOS[] = {
+    {"hora", "hora [HH:MM:SS]", ComandoHora},
+    {"alarma", "alarma [HH:MM:SS | si | no]", ComandoAlarma},
+    {"estado", "estado", ComandoEstado},
+};
+
+/* === Private function implementation ========================================================= */
+
+static void ActivarAlarma(bool estado)
+{
+    fprintf(stderr, "alarma %s\n", estado ? "sonando" : "apagada");
+}
+
+static int Recibir(int descriptor)
+{
+    ssize_t leidos = read(descriptor, recepcion + posicion, tamanio - posicion);
+
+    if (leidos > 0)
+    {
+        posicion = (posicion + leidos) % tamanio;
+    }
+
+    return (leidos < 0) ? 0 : (leidos == 0) ? -1 : leidos;
+}
+
+static void ComandoHora(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    uint8_t hora[6];
+
+    if ((cantidad == 1) && (ConsoleArgumentDigits(consola, &argumentos[0], hora, sizeof(hora)) == sizeof(hora)) &&
+        HoraValida(hora))
+    {
+        ClockSetTime(reloj, hora, sizeof(hora));
+    }
+    else if (cantidad != 0)
+    {
+        ConsoleWrite(consola, "error: uso hora HH:MM:SS\n");
+        return;
+    }
+
+    ConsoleWrite(consola, "hora ");
+    if (ClockGetTime(reloj, hora, sizeof(hora)))
+    {
+        ConsoleWriteDigits(consola, hora, sizeof(hora));
+        ConsoleWrite(consola, "\n");
+    }
+    else
+    {
+        ConsoleWrite(consola, "sin ajustar\n");
+    }
+}
+
+static void ComandoAlarma(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    uint8_t hora[6];
+
+    if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "si"))
+    {
+        AlarmEnamble(reloj, true);
+    }
+    else if ((cantidad == 1) && ConsoleArgumentIs(consola, &argumentos[0], "no"))
+    {
+        AlarmEnamble(reloj, false);
+    }
+    else if ((cantidad == 1) &&
+             (ConsoleArgumentDigits(consola, &argumentos[0], hora, sizeof(hora)) == sizeof(hora)) && HoraValida(hora))
+    {
+        AlarmSetTime(reloj, hora, sizeof(hora));
+    }
+    else if (cantidad != 0)
+    {
+        ConsoleWrite(consola, "error: uso alarma [HH:MM:SS | si | no]\n");
+        return;
+    }
+
+    ConsoleWrite(consola, "alarma ");
+    if (AlarmGetTime(reloj, hora, sizeof(hora)))
+    {
+        ConsoleWriteDigits(consola, hora, sizeof(hora));
+    }
+    else
+    {
+        ConsoleWrite(consola, "sin ajustar");
+    }
+    ConsoleWrite(consola, AlarmGetState(reloj) ? " habilitada\n" : " deshabilitada\n");
+}
+
+static void ComandoEstado(console_t consola, uint8_t cantidad, const console_argument_t * argumentos)
+{
+    (void)cantidad;
+    (void)argumentos;
+
+    ConsoleWrite(consola, "tiempo encendido ");
+    ConsoleWriteNumber(consola, milisegundos, 3);
+    ConsoleWrite(consola, " s\n");
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void)
+{
+    const uint8_t * respuesta;
+    uint16_t largo;
+    struct termios modo;
+    int maestro, esclavo;
+
+    maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((maestro < 0) || grantpt(maestro) || unlockpt(maestro))
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+
+    // El extremo esclavo queda abierto y en modo crudo para que la terminal no altere los bytes ni haga eco
+    esclavo = open(ptsname(maestro), O_RDWR | O_NOCTTY);
+    tcgetattr(esclavo, &modo);
+    cfmakeraw(&modo);
+    tcsetattr(esclavo, TCSANOW, &modo);
+    fcntl(maestro, F_SETFL, O_NONBLOCK);
+    printf("%s\n", ptsname(maestro));
+    fflush(stdout);
+
+    reloj = ClockCreate(1000, ActivarAlarma);
+    ClockSetSource(reloj, MonotonicClockCreate());
+    consola = ConsoleCreate(COMANDOS, sizeof(COMANDOS) / sizeof(COMANDOS[0]));
+    recepcion = ConsoleGetReceiveBuffer(consola, &tamanio);
+
+    while (true)
+    {
+        // Vacía la pseudo terminal en dos partes si lo recibido da la vuelta al buffer
+        if ((Recibir(maestro) < 0) || (Recibir(maestro) < 0))
+        {
+            break;
+        }
+
+        // En el equipo lo que sigue se reparte entre las interrupciones de la UART y la tarea principal
+        if (ConsoleReceive(consola, posicion))
+        {
+            ConsoleProcess(consola);
+        }
+        largo = ConsoleTransmit(consola, &respuesta);
+        if (largo && (write(maestro, respuesta, largo) < 0))
+        {
+            perror("write");
+            return 1;
+        }
+        ConsoleTransmitted(consola);
+
+        // La hora avanza con la fuente, alcanza una llamada por período para revisar la alarma
+        usleep(PERIODO_CONSOLA * 1000);
+        ClockRefresh(reloj);
+        milisegundos += PERIODO_CONSOLA;
+    }
+
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Estima el peor caso de uso de pila de cada tarea a partir del grafo de llamadas del compilador.
+
+Lee los archivos .ci que genera gcc con -fcallgraph-info=su, une los grafos de todos los módulos y recorre la cadena
+de llamadas más profunda desde cada función raíz. Las llamadas indirectas de cada función se resuelven con los
+destinos que indica la opción --indirecto; las que no se resuelven no suman pila y se informan con un aviso.
+
+Uso: pilas.py build --raiz TareaPrincipal:2048 [--indirecto LLAMADOR[,LLAMADOR]=REGEX] [--contexto BYTES]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+NODO = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+ARISTA = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+PILA = re.compile(r"\\n(\d+) bytes \((\w+)")
+INDIRECTA = "__indirect_call"
+
+
+def nombre(titulo):
+    # Las funciones estáticas se titulan "archivo:función"
+    return titulo.rsplit(":", 1)[-1]
+
+
+def leer_grafo(directorio):
+    pilas, tipos, llamadas = {}, {}, {}
+    for raiz, _, archivos in os.walk(directorio):
+        for archivo in archivos:
+            if not archivo.endswith(".ci"):
+                continue
+            with open(os.path.join(raiz, archivo), encoding="utf-8", errors="replace") as entrada:
+                for linea in entrada:
+                    nodo = NODO.match(linea)
+                    if nodo:
+                        pila = PILA.search(nodo.group(2))
+                        if pila:
+                            pilas[nombre(nodo.group(1))] = int(pila.group(1))
+                            tipos[nombre(nodo.group(1))] = pila.group(2)
+                        continue
+                    arista = ARISTA.match(linea)
+                    if arista:
+                        origen, destino = nombre(arista.group(1)), nombre(arista.group(2))
+                        llamadas.setdefault(origen, set()).add(destino)
+    return pilas, tipos, llamadas
+
+
+class Analisis:
+    def __init__(self, pilas, tipos, llamadas, indirectos):
+        self.pilas, self.tipos, self.llamadas = pilas, tipos, llamadas
+        self.indirectos = {}
+        for llamadores, destinos in indirectos:
+            candidatos = [f for f in pilas if destinos.search(f)] + [f for f in llamadas if destinos.search(f)]
+            for llamador in llamadores:
+                self.indirectos.setdefault(llamador, set()).update(candidatos)
+        self.memoria = {}
+        self.avisos = set()
+
+    def destinos(self, funcion):
+        destinos = set(self.llamadas.get(funcion, ()))
+        base = funcion.split(".")[0]  # Los clones del optimizador se llaman como el original con un sufijo
+        if INDIRECTA in destinos:
+            destinos.discard(INDIRECTA)
+            if base in self.indirectos:
+                destinos.update(self.indirectos[base])
+            else:
+                self.avisos.add("%s hace llamadas indirectas sin resolver, la estimación es incompleta" % funcion)
+        return destinos
+
+    def peor_caso(self, funcion, camino=()):
+        """Devuelve los bytes y la cadena de llamadas más profunda que comienza en la función."""
+        if funcion in self.memoria:
+            return self.memoria[funcion]
+        if funcion in camino:
+            self.avisos.add("recursión en %s, se cuenta una sola vez" % funcion)
+            return 0, []
+        if funcion not in self.pilas:
+            self.avisos.add("%s no tiene información de pila (biblioteca o ensamblador)" % funcion)
+        if self.tipos.get(funcion, "static") != "static":
+            self.avisos.add("%s usa pila %s" % (funcion, self.tipos[funcion]))
+
+        mayor, cadena = 0, []
+        for destino in sorted(self.destinos(funcion)):
+            bytes_destino, cadena_destino = self.peor_caso(destino, camino + (funcion,))
+            if bytes_destino > mayor:
+                mayor, cadena = bytes_destino, cadena_destino
+
+        resultado = (self.pilas.get(funcion, 0) + mayor, [funcion] + cadena)
+        self.memoria[funcion] = resultado
+        return resultado
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("directorio", help="directorio donde se buscan los archivos .ci")
+    parser.add_argument("--raiz", action="append", default=[], metavar="FUNCION[:BYTES]",
+                        help="función de entrada de una tarea o interrupción y tamaño de su pila en bytes")
+    parser.add_argument("--indirecto", action="append", default=[], metavar="LLAMADOR[,LLAMADOR]=REGEX",
+                        help="funciones que pueden ser destino de las llamadas indirectas de los llamadores")
+    parser.add_argument("--contexto", type=int, default=204, metavar="BYTES",
+                        help="pila que ocupa el contexto guardado al cambiar de tarea (por defecto Cortex-M4F con FPU)")
+    args = parser.parse_args()
+
+    pilas, tipos, llamadas = leer_grafo(args.directorio)
+    if not pilas:
+        print("pilas.py: no se encontraron archivos .ci en %s, compile con -fcallgraph-info=su" % args.directorio,
+              file=sys.stderr)
+        return 1
+
+    indirectos = []
+    for indirecto in args.indirecto:
+        llamadores, _, destinos = indirecto.partition("=")
+        indirectos.append((llamadores.split(","), re.compile(destinos)))
+
+    analisis = Analisis(pilas, tipos, llamadas, indirectos)
+    excedida = False
+
+    print("%-20s %8s %8s %8s  %s" % ("raiz", "estimada", "pila", "margen", "cadena"))
+    for raiz in args.raiz:
+        funcion, _, tamanio = raiz.partition(":")
+        bytes_cadena, cadena = analisis.peor_caso(funcion)
+        estimada = bytes_cadena + args.contexto
+        if tamanio:
+            margen = int(tamanio) - estimada
+            excedida = excedida or margen < 0
+            print("%-20s %8d %8s %8d  %s" % (funcion, estimada, tamanio, margen, " > ".join(cadena)))
+        else:
+            print("%-20s %8d %8s %8s  %s" % (funcion, estimada, "-", "-", " > ".join(cadena)))
+
+    for aviso in sorted(analisis.avisos):
+        print("aviso: %s" % aviso)
+
+    return 2 if excedida else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
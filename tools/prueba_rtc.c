@@ -0,0 +1,220 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Prueba de la fuente de la hora del RTC
+ **
+ ** Ejecuta RtcInit, RtcRead y RtcWrite de src/bspreloj.c, compiladas con CLOCK_RTC en 1, sobre registros del RTC y de
+ ** respaldo falsos que la prueba lee y escribe directamente, sin el modelo de host/src/chip.c que cuenta los segundos.
+ ** CTIME0 se carga con la disposición del LPC43xx: segundos en los bits 5 a 0, minutos en los bits 13 a 8, horas en
+ ** los bits 20 a 16 y el día de la semana en los bits 26 a 24; los bits reservados tienen un valor indefinido, por lo
+ ** que la prueba también los pone en uno. La marca de REGFILE[0] indica si la hora del RTC es válida.
+ **
+ **     make rtc-test                               compila y ejecuta, termina con error si falla una verificación
+ **
+ ** \addtogroup herramientas HERRAMIENTAS
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "chip.h"
+#include <stdio.h>
+
+/* === Macros definitions ====================================================================== */
+
+// Los registros falsos reemplazan a los del modelo antes de compilar el módulo
+#undef LPC_RTC
+#undef LPC_REGFILE
+#define LPC_RTC     (&rtc_falso)
+#define LPC_REGFILE (&regfile_falso)
+
+//! Campos de CTIME0 en las posiciones del LPC43xx.
+#define CTIME0(horas, minutos, segundos, dia) ((segundos) | ((minutos) << 8) | ((horas) << 16) | ((dia) << 24))
+
+//! Bits reservados de CTIME0, con valor indefinido en la lectura.
+#define CTIME0_RESERVADOS 0xF8E0C0C0
+
+//! Informa una verificación que falla y la cuenta.
+#define VERIFICAR(condicion)                                                                                           \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condicion))                                                                                              \
+        {                                                                                                              \
+            printf("%s:%d: falla %s\n", __FILE__, __LINE__, #condicion);                                               \
+            fallas++;                                                                                                  \
+        }                                                                                                              \
+    } while (0)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+//! Decodificación de CTIME0 con la marca válida.
+static void PruebaLectura(void);
+
+//! Validez de la hora según la marca de REGFILE[0].
+static void PruebaMarca(void);
+
+//! Escritura de los contadores y de la marca.
+static void PruebaEscritura(void);
+
+//! Inicialización del RTC con y sin la marca.
+static void PruebaInicio(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static LPC_RTC_T rtc_falso;
+static LPC_REGFILE_T regfile_falso;
+static int fallas;
+
+/* === Private function implementation ========================================================= */
+
+// El módulo se compila dentro de la prueba para que use los registros falsos
+#include "../src/bspreloj.c"
+
+void SimulatorOutputsChanged(uint8_t port, uint32_t outputs)
+{
+    (void)port;
+    (void)outputs;
+}
+
+int SimulatorSerial(void)
+{
+    return -1;
+}
+
+void SimulatorStartInterrupts(void)
+{
+}
+
+static void PruebaLectura(void)
+{
+    uint32_t segundos;
+
+    regfile_falso.REGFILE[RTC_BACKUP_REGISTER] = RTC_VALID_MARK;
+    rtc_falso.CTIME[0] = CTIME0(0, 0, 0, 0);
+    VERIFICAR(RtcRead(&segundos) && segundos == 0);
+
+    rtc_falso.CTIME[0] = CTIME0(12, 34, 56, 3);
+    VERIFICAR(RtcRead(&segundos) && segundos == (12 * 60 + 34) * 60 + 56);
+
+    // Todos los campos en su máximo y los bits reservados en uno
+    rtc_falso.CTIME[0] = CTIME0(23, 59, 59, 6) | CTIME0_RESERVADOS;
+    VERIFICAR(RtcRead(&segundos) && segundos == 86399);
+
+    // Cada campo por separado, para que un corrimiento equivocado no se compense con otro
+    rtc_falso.CTIME[0] = CTIME0(0, 0, 59, 0) | CTIME0_RESERVADOS;
+    VERIFICAR(RtcRead(&segundos) && segundos == 59);
+    rtc_falso.CTIME[0] = CTIME0(0, 59, 0, 0) | CTIME0_RESERVADOS;
+    VERIFICAR(RtcRead(&segundos) && segundos == 59 * 60);
+    rtc_falso.CTIME[0] = CTIME0(23, 0, 0, 0) | CTIME0_RESERVADOS;
+    VERIFICAR(RtcRead(&segundos) && segundos == 23 * 3600);
+
+    return;
+}
+
+static void PruebaMarca(void)
+{
+    uint32_t segundos;
+
+    rtc_falso.CTIME[0] = CTIME0(8, 15, 30, 1);
+
+    // Sin la marca la hora se entrega igual, pero no es válida
+    regfile_falso.REGFILE[RTC_BACKUP_REGISTER] = 0;
+    VERIFICAR(!RtcRead(&segundos) && segundos == (8 * 60 + 15) * 60 + 30);
+
+    regfile_falso.REGFILE[RTC_BACKUP_REGISTER] = RTC_VALID_MARK ^ 1;
+    VERIFICAR(!RtcRead(&segundos));
+
+    regfile_falso.REGFILE[RTC_BACKUP_REGISTER] = RTC_VALID_MARK;
+    VERIFICAR(RtcRead(&segundos));
+
+    return;
+}
+
+static void PruebaEscritura(void)
+{
+    static const uint32_t horas[] = {0, 59, 3599, 3600, 45296, 86399};
+    uint32_t segundos;
+
+    for (unsigned int indice = 0; indice < sizeof(horas) / sizeof(horas[0]); indice++)
+    {
+        regfile_falso = (LPC_REGFILE_T){0};
+        regfile_falso.REGFILE[RTC_BACKUP_REGISTER + 1] = 0xCAFE;
+        rtc_falso = (LPC_RTC_T){0};
+
+        RtcWrite(horas[indice]);
+        VERIFICAR(rtc_falso.TIME[RTC_TIMETYPE_HOUR] == horas[indice] / 3600);
+        VERIFICAR(rtc_falso.TIME[RTC_TIMETYPE_MINUTE] == (horas[indice] / 60) % 60);
+        VERIFICAR(rtc_falso.TIME[RTC_TIMETYPE_SECOND] == horas[indice] % 60);
+        VERIFICAR(regfile_falso.REGFILE[RTC_BACKUP_REGISTER] == RTC_VALID_MARK);
+        VERIFICAR(regfile_falso.REGFILE[RTC_BACKUP_REGISTER + 1] == 0xCAFE);
+
+        // El RTC muestra en CTIME0 lo que se escribió en los contadores
+        rtc_falso.CTIME[0] = CTIME0(rtc_falso.TIME[RTC_TIMETYPE_HOUR], rtc_falso.TIME[RTC_TIMETYPE_MINUTE],
+                                    rtc_falso.TIME[RTC_TIMETYPE_SECOND], 0);
+        VERIFICAR(RtcRead(&segundos) && segundos == horas[indice]);
+    }
+
+    return;
+}
+
+static void PruebaInicio(void)
+{
+    // Sin la marca el RTC se inicializa y se pone en marcha
+    regfile_falso = (LPC_REGFILE_T){0};
+    rtc_falso = (LPC_RTC_T){0};
+    rtc_falso.AMR = 0;
+    RtcInit();
+    VERIFICAR(rtc_falso.CCR & RTC_CCR_CLKEN);
+    VERIFICAR(rtc_falso.AMR == 0xFF);
+    VERIFICAR(board.clock_source && board.clock_source->Read == RtcRead && board.clock_source->Write == RtcWrite);
+
+    // Con la marca el RTC siguió contando con la batería y no se toca
+    regfile_falso.REGFILE[RTC_BACKUP_REGISTER] = RTC_VALID_MARK;
+    rtc_falso = (LPC_RTC_T){.CCR = RTC_CCR_CLKEN, .TIME = {[RTC_TIMETYPE_HOUR] = 7}};
+    RtcInit();
+    VERIFICAR(rtc_falso.CCR == RTC_CCR_CLKEN && rtc_falso.AMR == 0 && rtc_falso.TIME[RTC_TIMETYPE_HOUR] == 7);
+    VERIFICAR(regfile_falso.REGFILE[RTC_BACKUP_REGISTER] == RTC_VALID_MARK);
+
+    return;
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(void)
+{
+    PruebaLectura();
+    PruebaMarca();
+    PruebaEscritura();
+    PruebaInicio();
+
+    printf("%s\n", fallas ? "RTC con fallas" : "RTC correcto");
+
+    return fallas ? 1 : 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,806 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Pruebas de rendimiento de los caminos críticos
+ **
+ ** Mide en la computadora el costo por operación de las funciones que corren en cada tick o en cada refresco de la
+ ** pantalla, compiladas desde src/ sin cambios. La pantalla usa un controlador que no hace nada, de modo que se mide
+ ** solo la lógica del módulo. El diario de ajustes usa una EEPROM en memoria con las páginas de la del LPC4337, por
+ ** lo que la restauración mide la validación de los registros y no la lectura de la memoria real; las pruebas
+ ** SettingsRestore/N recorren un diario lleno de N registros, todos válidos, que es el peor caso del arranque. Las
+ ** pruebas terminadas en /fuente usan una fuente de la hora en memoria que, como el RTC, cambia de segundo cada mil
+ ** lecturas, por lo que miden el costo propio del reloj con una fuente sin el acceso al periférico.
+ **
+ ** Las pruebas Salidas/N y Grupo/N escriben el mismo patrón en N salidas digitales, una por una o como un grupo, sobre
+ ** el modelo de los registros GPIO de host/src/chip.c con la contabilidad de trafico.h. Las salidas ocupan dos puertos
+ ** y uno de ellos mezcla lógica directa e inversa. Además del tiempo se informan las escrituras en los registros por
+ ** operación, que no dependen de la computadora; el tiempo incluye el de la contabilidad.
+ **
+ ** Cada prueba se calibra para que una muestra dure al menos DURACION_MUESTRA, se ejecuta durante CALENTAMIENTO sin
+ ** registrar y luego toma las muestras indicadas. De cada muestra se obtienen los nanosegundos y, si el sistema permite
+ ** leer los contadores de hardware, las instrucciones por operación. Las muestras que se alejan de la mediana más de
+ ** tres desvíos absolutos medianos se descartan, y se informa la mediana y el desvío de las restantes. Las
+ ** instrucciones son casi deterministas y son la mejor referencia para comparar entre commits; el tiempo depende de la
+ ** carga de la computadora. El costo incluye el del lazo que repite la operación.
+ **
+ **     make bench                                  compila, ejecuta y guarda build/host/rendimiento.json
+ **     ./rendimiento [-r muestras] [-f filtro] [-j archivo.json]
+ **     python3 tools/rendimiento.py anterior.json build/host/rendimiento.json
+ **
+ ** \addtogroup herramientas HERRAMIENTAS
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+
+// reloj.h llama clock_t a la referencia del reloj, que choca con el tipo de la biblioteca estándar
+#define clock_t reloj_t
+#include "reloj.h"
+#undef clock_t
+
+#include "ajustes.h"
+#include "controlbcd.h"
+#include "digital.h"
+#include "pantalla.h"
+#include "simulador.h"
+#include "tiempo.h"
+#include "trafico.h"
+#include <linux/perf_event.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+//! Duración mínima de una muestra en nanosegundos.
+#define DURACION_MUESTRA 2000000
+
+//! Tiempo de ejecución previo a las muestras en nanosegundos.
+#define CALENTAMIENTO 100000000
+
+//! Cantidad de muestras por defecto y máxima.
+#define MUESTRAS         31
+#define MUESTRAS_MAXIMAS 1001
+
+//! Distancia a la mediana, en desvíos absolutos medianos, a partir de la cual una muestra se descarta.
+#define LIMITE_DESVIOS 3.0
+
+//! Tamaño de página y mayor cantidad de páginas de la EEPROM simulada del diario de ajustes.
+#define PAGINA_DIARIO  128
+#define PAGINAS_DIARIO 127
+
+//! Segundos de un día.
+#define SEGUNDOS_DIA 86400
+
+//! Salidas digitales de las pruebas de escritura en los puertos.
+#define SALIDAS 8
+
+/* === Private data type declarations ========================================================== */
+
+//! Prueba de rendimiento.
+typedef struct
+{
+    const char * nombre;
+    void (*Preparar)(void);                 //!< Deja el estado inicial, puede ser NULL.
+    void (*Ejecutar)(uint32_t operaciones); //!< Repite la operación medida.
+} prueba_t;
+
+//! Resultado de una prueba.
+typedef struct
+{
+    uint32_t operaciones; //!< Operaciones por muestra.
+    uint32_t muestras;    //!< Muestras conservadas.
+    uint32_t descartadas; //!< Muestras descartadas por alejarse de la mediana.
+    double mediana;       //!< Mediana de los nanosegundos por operación.
+    double minimo;        //!< Mínimo de los nanosegundos por operación.
+    double desvio;        //!< Desvío estándar de los nanosegundos por operación.
+    double instrucciones; //!< Mediana de las instrucciones por operación, negativo si no se pudieron contar.
+    double escrituras;    //!< Escrituras en los registros GPIO por operación.
+} resultado_t;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void Alarma(bool estado);
+static void PantallaApagar(void);
+static void SegmentosEncender(uint8_t segmentos);
+static void DigitoEncender(uint8_t digito);
+static void DiarioLeer(uint16_t pagina, uint32_t * palabras);
+static bool DiarioEscribir(uint16_t pagina, uint16_t desplazamiento, const uint32_t * palabras, uint16_t cantidad);
+static bool FuenteLeer(uint32_t * segundos);
+static void FuenteEscribir(uint32_t segundos);
+
+static void CrearReloj(int tics_por_segundo, clock_source_t fuente);
+static void PrepararReloj(void);
+static void PrepararRelojSegundos(void);
+static void PrepararRelojFuente(void);
+static void PrepararPantalla(void);
+static void EjecutarClockRefresh(uint32_t operaciones);
+static void EjecutarClockGetTime(uint32_t operaciones);
+static void EjecutarUptimeAdvance(uint32_t operaciones);
+static void EjecutarUptimeMilliseconds(uint32_t operaciones);
+static void EjecutarSecondsIncrement(uint32_t operaciones);
+static void EjecutarIncrementarMinuto(uint32_t operaciones);
+static void EjecutarDecrementarHora(uint32_t operaciones);
+static void EjecutarHoraValida(uint32_t operaciones);
+static void EjecutarDisplayWriteBCD(uint32_t operaciones);
+static void EjecutarDisplayRefresh(uint32_t operaciones);
+static void LlenarDiario(settings_driver_t controlador);
+static void PrepararDiario8(void);
+static void PrepararDiario64(void);
+static void PrepararDiario1016(void);
+static void EjecutarSettingsRestore(uint32_t operaciones);
+static void PrepararSalidas(void);
+static void EjecutarSalidas(uint32_t operaciones);
+static void EjecutarGrupo(uint32_t operaciones);
+static uint32_t EscriturasGpio(void);
+
+/**
+ * @brief Abre el contador de instrucciones de usuario del hilo actual.
+ *
+ * @return int Descriptor del contador, negativo si el sistema no lo permite.
+ */
+static int AbrirContador(void);
+
+/**
+ * @brief Toma una muestra de una prueba.
+ *
+ * @param nanosegundos  Duración de la muestra.
+ * @param instrucciones Instrucciones ejecutadas, sin cambios si no hay contador.
+ * @param escrituras    Escrituras en los registros GPIO.
+ */
+static void Muestrear(const prueba_t * prueba, uint32_t operaciones, uint64_t * nanosegundos, uint64_t * instrucciones,
+                      uint32_t * escrituras);
+
+/**
+ * @brief Calibra, calienta y mide una prueba.
+ */
+static void Medir(const prueba_t * prueba, uint32_t muestras, resultado_t * resultado);
+
+static double Mediana(double * valores, uint32_t cantidad);
+static int Comparar(const void * a, const void * b);
+static uint64_t Nanosegundos(void);
+
+//! Atención de la interrupción del DMA que necesita el modelo de los registros, no se usa.
+void DMA_IRQHandler(void);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static const struct display_driver_s CONTROLADOR_NULO = {
+    .ScreenTurnOff = PantallaApagar,
+    .SegmentsTurnOn = SegmentosEncender,
+    .DigitTurnOn = DigitoEncender,
+};
+
+//! Diarios de ajustes de una, ocho y todas las páginas de la EEPROM.
+static const struct settings_driver_s DIARIOS[] = {
+    {.pages = 1, .page_size = PAGINA_DIARIO, .Read = DiarioLeer, .Write = DiarioEscribir},
+    {.pages = 8, .page_size = PAGINA_DIARIO, .Read = DiarioLeer, .Write = DiarioEscribir},
+    {.pages = PAGINAS_DIARIO, .page_size = PAGINA_DIARIO, .Read = DiarioLeer, .Write = DiarioEscribir},
+};
+
+static const struct clock_source_s FUENTE_MEMORIA = {
+    .Read = FuenteLeer,
+    .Write = FuenteEscribir,
+};
+
+//! Horas válidas e inválidas que recorren las pruebas, para que las ramas no sean siempre las mismas.
+static const uint8_t HORAS[8][6] = {
+    {0, 0, 0, 0, 0, 0}, {2, 3, 5, 9, 5, 9}, {1, 2, 3, 0, 4, 5}, {2, 4, 0, 0, 0, 0},
+    {0, 7, 6, 0, 0, 0}, {1, 9, 5, 9, 6, 0}, {0, 9, 1, 5, 3, 0}, {3, 0, 0, 0, 0, 0},
+};
+
+static const prueba_t PRUEBAS[] = {
+    {"ClockRefresh", PrepararReloj, EjecutarClockRefresh},
+    {"ClockRefresh/segundo", PrepararRelojSegundos, EjecutarClockRefresh},
+    {"ClockRefresh/fuente", PrepararRelojFuente, EjecutarClockRefresh},
+    {"ClockGetTime", PrepararReloj, EjecutarClockGetTime},
+    {"ClockGetTime/fuente", PrepararRelojFuente, EjecutarClockGetTime},
+    {"UptimeAdvance", NULL, EjecutarUptimeAdvance},
+    {"UptimeMilliseconds", NULL, EjecutarUptimeMilliseconds},
+    {"SecondsIncrement", NULL, EjecutarSecondsIncrement},
+    {"IncrementarMinuto", NULL, EjecutarIncrementarMinuto},
+    {"DecrementarHora", NULL, EjecutarDecrementarHora},
+    {"HoraValida", NULL, EjecutarHoraValida},
+    {"DisplayWriteBCD", PrepararPantalla, EjecutarDisplayWriteBCD},
+    {"DisplayRefresh", PrepararPantalla, EjecutarDisplayRefresh},
+    {"SettingsRestore/8", PrepararDiario8, EjecutarSettingsRestore},
+    {"SettingsRestore/64", PrepararDiario64, EjecutarSettingsRestore},
+    {"SettingsRestore/1016", PrepararDiario1016, EjecutarSettingsRestore},
+    {"Salidas/8", PrepararSalidas, EjecutarSalidas},
+    {"Grupo/8", PrepararSalidas, EjecutarGrupo},
+};
+
+//! Puerto, terminal y lógica de las salidas de las pruebas de escritura, el puerto 3 mezcla las dos lógicas.
+static const struct
+{
+    uint8_t gpio;
+    uint8_t bit;
+    bool inverted;
+} TERMINALES[SALIDAS] = {
+    {2, 0, false}, {2, 1, false}, {2, 2, false}, {2, 3, false},
+    {3, 0, false}, {3, 1, false}, {3, 2, true},  {3, 3, true},
+};
+
+static reloj_t reloj;
+static display_t pantalla;
+static uint8_t hora[6];
+static int contador = -1;
+static uint32_t eeprom[PAGINAS_DIARIO][PAGINA_DIARIO / sizeof(uint32_t)];
+static uint32_t fuente_segundos;
+static uint32_t fuente_lecturas;
+static digital_output_t salidas[SALIDAS];
+static digital_group_t grupo;
+
+//! Destino de los resultados, para que el compilador no elimine las operaciones.
+static volatile uint32_t sumidero;
+
+/* === Private function implementation ========================================================= */
+
+void DMA_IRQHandler(void)
+{
+}
+
+void RIT_IRQHandler(void)
+{
+}
+
+void UART2_IRQHandler(void)
+{
+}
+
+void SimulatorOutputsChanged(uint8_t port, uint32_t outputs)
+{
+    sumidero += port + outputs;
+}
+
+int SimulatorSerial(void)
+{
+    return -1;
+}
+
+void SimulatorStartInterrupts(void)
+{
+}
+
+static void Alarma(bool estado)
+{
+    sumidero += estado;
+}
+
+static void PantallaApagar(void)
+{
+}
+
+static void SegmentosEncender(uint8_t segmentos)
+{
+    (void)segmentos;
+}
+
+static void DigitoEncender(uint8_t digito)
+{
+    (void)digito;
+}
+
+static void DiarioLeer(uint16_t pagina, uint32_t * palabras)
+{
+    memcpy(palabras, eeprom[pagina], PAGINA_DIARIO);
+}
+
+static bool DiarioEscribir(uint16_t pagina, uint16_t desplazamiento, const uint32_t * palabras, uint16_t cantidad)
+{
+    memcpy(&eeprom[pagina][desplazamiento / sizeof(uint32_t)], palabras, cantidad * sizeof(uint32_t));
+
+    return true;
+}
+
+static bool FuenteLeer(uint32_t * segundos)
+{
+    if (++fuente_lecturas >= 1000)
+    {
+        fuente_lecturas = 0;
+        fuente_segundos = (fuente_segundos + 1) % SEGUNDOS_DIA;
+    }
+    *segundos = fuente_segundos;
+
+    return true;
+}
+
+static void FuenteEscribir(uint32_t segundos)
+{
+    fuente_segundos = segundos;
+}
+
+static void CrearReloj(int tics_por_segundo, clock_source_t fuente)
+{
+    static const uint8_t ALARMA[6] = {0, 6, 3, 0, 0, 0};
+
+    reloj = ClockCreate(tics_por_segundo, Alarma);
+    ClockSetSource(reloj, fuente);
+    ClockSetTime(reloj, HORAS[1], sizeof(hora));
+    AlarmSetTime(reloj, ALARMA, sizeof(ALARMA));
+}
+
+static void PrepararReloj(void)
+{
+    CrearReloj(1000, NULL);
+}
+
+static void PrepararRelojSegundos(void)
+{
+    CrearReloj(1, NULL); // Cada tick avanza un segundo y compara con la alarma
+}
+
+static void PrepararRelojFuente(void)
+{
+    CrearReloj(1000, &FUENTE_MEMORIA);
+}
+
+static void PrepararPantalla(void)
+{
+    pantalla = DisplayCreate(4, &CONTROLADOR_NULO);
+    DisplayWriteBCD(pantalla, hora, 4);
+}
+
+static void EjecutarClockRefresh(uint32_t operaciones)
+{
+    uint32_t suma = 0;
+
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        suma += ClockRefresh(reloj);
+    }
+    sumidero += suma;
+}
+
+static void EjecutarClockGetTime(uint32_t operaciones)
+{
+    uint32_t suma = 0;
+
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        suma += ClockGetTime(reloj, hora, sizeof(hora));
+    }
+    sumidero += suma + hora[5];
+}
+
+static void EjecutarUptimeAdvance(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        UptimeAdvance(1);
+    }
+}
+
+static void EjecutarUptimeMilliseconds(uint32_t operaciones)
+{
+    uint64_t suma = 0;
+
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        suma += UptimeMilliseconds();
+    }
+    sumidero += (uint32_t)suma;
+}
+
+static void EjecutarSecondsIncrement(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        SecondsIncrement(hora);
+    }
+}
+
+static void EjecutarIncrementarMinuto(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        IncrementarMinuto(hora);
+    }
+}
+
+static void EjecutarDecrementarHora(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        DecrementarHora(hora);
+    }
+}
+
+static void EjecutarHoraValida(uint32_t operaciones)
+{
+    uint32_t suma = 0;
+
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        suma += HoraValida(HORAS[operacion & 7]);
+    }
+    sumidero += suma;
+}
+
+static void EjecutarDisplayWriteBCD(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        DisplayWriteBCD(pantalla, (uint8_t *)&HORAS[operacion & 7][2], 4); // Solo lee los dígitos
+    }
+}
+
+static void EjecutarDisplayRefresh(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        DisplayRefresh(pantalla);
+    }
+}
+
+static void LlenarDiario(settings_driver_t controlador)
+{
+    uint32_t registros = controlador->pages * (PAGINA_DIARIO / SETTINGS_RECORD_SIZE);
+    settings_t ajustes = {.alarm_valid = true, .telemetry = true};
+
+    // Una vuelta y media, para que el último registro no quede al final de la región
+    memset(eeprom, 0, sizeof(eeprom));
+    SettingsInit(controlador);
+    for (uint32_t registro = 0; registro < registros + registros / 2; registro++)
+    {
+        memcpy(ajustes.alarm, HORAS[registro & 7], sizeof(ajustes.alarm));
+        ajustes.alarm_enabled = registro & 1;
+        SettingsSave(&ajustes);
+        SettingsFlush();
+    }
+}
+
+static void PrepararDiario8(void)
+{
+    LlenarDiario(&DIARIOS[0]);
+}
+
+static void PrepararDiario64(void)
+{
+    LlenarDiario(&DIARIOS[1]);
+}
+
+static void PrepararDiario1016(void)
+{
+    LlenarDiario(&DIARIOS[2]);
+}
+
+static void EjecutarSettingsRestore(uint32_t operaciones)
+{
+    settings_t ajustes;
+    uint32_t suma = 0;
+
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        suma += SettingsRestore(&ajustes);
+    }
+    sumidero += suma;
+}
+
+static void PrepararSalidas(void)
+{
+    // Los descriptores no se liberan, las dos pruebas comparten las mismas salidas
+    if (!grupo)
+    {
+        for (int indice = 0; indice < SALIDAS; indice++)
+        {
+            salidas[indice] = DigitalOutputCreate(TERMINALES[indice].gpio, TERMINALES[indice].bit,
+                                                  TERMINALES[indice].inverted);
+        }
+        grupo = DigitalGroupCreate(salidas, SALIDAS);
+    }
+    if (!grupo)
+    {
+        fprintf(stderr, "no se pudo crear el grupo de salidas\n");
+        exit(1);
+    }
+}
+
+static void EjecutarSalidas(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        uint32_t patron = operacion * 0x9D; // Recorre patrones que cambian salidas en los dos puertos
+
+        for (int indice = 0; indice < SALIDAS; indice++)
+        {
+            if (patron & (1UL << indice))
+            {
+                DigitalOutputActivate(salidas[indice]);
+            }
+            else
+            {
+                DigitalOutputDeactivate(salidas[indice]);
+            }
+        }
+    }
+}
+
+static void EjecutarGrupo(uint32_t operaciones)
+{
+    for (uint32_t operacion = 0; operacion < operaciones; operacion++)
+    {
+        uint32_t patron = operacion * 0x9D; // Recorre patrones que cambian salidas en los dos puertos
+
+        DigitalGroupActivate(grupo, patron & ((1UL << SALIDAS) - 1));
+        DigitalGroupDeactivate(grupo, ~patron & ((1UL << SALIDAS) - 1));
+    }
+}
+
+static uint32_t EscriturasGpio(void)
+{
+    traffic_counts_t cuentas;
+    uint32_t escrituras = 0;
+
+    for (uint8_t puerto = 0; puerto < TRAFFIC_PORTS; puerto++)
+    {
+        TrafficGetPort(puerto, &cuentas);
+        escrituras += cuentas.writes;
+    }
+
+    return escrituras;
+}
+
+static int AbrirContador(void)
+{
+    struct perf_event_attr atributos;
+
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.size = sizeof(atributos);
+    atributos.config = PERF_COUNT_HW_INSTRUCTIONS;
+    atributos.disabled = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+
+    return syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+
+static void Muestrear(const prueba_t * prueba, uint32_t operaciones, uint64_t * nanosegundos, uint64_t * instrucciones,
+                      uint32_t * escrituras)
+{
+    uint32_t previas = EscriturasGpio();
+    uint64_t inicio;
+
+    if (contador >= 0)
+    {
+        ioctl(contador, PERF_EVENT_IOC_RESET, 0);
+        ioctl(contador, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    inicio = Nanosegundos();
+    prueba->Ejecutar(operaciones);
+    *nanosegundos = Nanosegundos() - inicio;
+    *escrituras = EscriturasGpio() - previas;
+
+    if ((contador >= 0) && (ioctl(contador, PERF_EVENT_IOC_DISABLE, 0) == 0) &&
+        (read(contador, instrucciones, sizeof(*instrucciones)) != sizeof(*instrucciones)))
+    {
+        *instrucciones = 0;
+    }
+}
+
+static void Medir(const prueba_t * prueba, uint32_t muestras, resultado_t * resultado)
+{
+    static double tiempos[MUESTRAS_MAXIMAS];
+    static double cuentas[MUESTRAS_MAXIMAS];
+    static double distancias[MUESTRAS_MAXIMAS];
+    uint64_t nanosegundos, instrucciones = 0, inicio;
+    uint32_t operaciones = 1, escrituras = 0;
+    double mediana, limite, suma = 0, cuadrados = 0;
+
+    if (prueba->Preparar)
+    {
+        prueba->Preparar();
+    }
+
+    // Duplica las operaciones por muestra hasta que una muestra dure lo suficiente
+    for (Muestrear(prueba, operaciones, &nanosegundos, &instrucciones, &escrituras); nanosegundos < DURACION_MUESTRA;
+         Muestrear(prueba, operaciones, &nanosegundos, &instrucciones, &escrituras))
+    {
+        operaciones *= 2;
+    }
+
+    for (inicio = Nanosegundos(); (Nanosegundos() - inicio) < CALENTAMIENTO;)
+    {
+        Muestrear(prueba, operaciones, &nanosegundos, &instrucciones, &escrituras);
+    }
+
+    for (uint32_t muestra = 0; muestra < muestras; muestra++)
+    {
+        Muestrear(prueba, operaciones, &nanosegundos, &instrucciones, &escrituras);
+        tiempos[muestra] = (double)nanosegundos / operaciones;
+        cuentas[muestra] = (double)instrucciones / operaciones;
+    }
+
+    // Descarta las muestras alejadas de la mediana, por ejemplo las interrumpidas por el sistema operativo
+    memcpy(distancias, tiempos, muestras * sizeof(double));
+    mediana = Mediana(distancias, muestras);
+    for (uint32_t muestra = 0; muestra < muestras; muestra++)
+    {
+        distancias[muestra] = fabs(tiempos[muestra] - mediana);
+    }
+    limite = LIMITE_DESVIOS * 1.4826 * Mediana(distancias, muestras);
+
+    memset(resultado, 0, sizeof(*resultado));
+    resultado->operaciones = operaciones;
+    resultado->minimo = INFINITY;
+    for (uint32_t muestra = 0; muestra < muestras; muestra++)
+    {
+        if (fabs(tiempos[muestra] - mediana) > limite)
+        {
+            resultado->descartadas++;
+            continue;
+        }
+        tiempos[resultado->muestras] = tiempos[muestra];
+        cuentas[resultado->muestras] = cuentas[muestra];
+        resultado->muestras++;
+        suma += tiempos[muestra];
+        cuadrados += tiempos[muestra] * tiempos[muestra];
+        resultado->minimo = fmin(resultado->minimo, tiempos[muestra]);
+    }
+
+    resultado->mediana = Mediana(tiempos, resultado->muestras);
+    resultado->desvio = sqrt(fmax(0, cuadrados / resultado->muestras - pow(suma / resultado->muestras, 2)));
+    resultado->instrucciones = (contador >= 0) ? Mediana(cuentas, resultado->muestras) : -1;
+    resultado->escrituras = (double)escrituras / operaciones; // Las pruebas escriben lo mismo en cada muestra
+}
+
+static double Mediana(double * valores, uint32_t cantidad)
+{
+    qsort(valores, cantidad, sizeof(double), Comparar);
+
+    return (cantidad % 2) ? valores[cantidad / 2] : (valores[cantidad / 2 - 1] + valores[cantidad / 2]) / 2;
+}
+
+static int Comparar(const void * a, const void * b)
+{
+    double diferencia = *(const double *)a - *(const double *)b;
+
+    return (diferencia > 0) - (diferencia < 0);
+}
+
+static uint64_t Nanosegundos(void)
+{
+    struct timespec ahora;
+
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+
+    return (uint64_t)ahora.tv_sec * 1000000000 + ahora.tv_nsec;
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(int argc, char * argv[])
+{
+    const char * filtro = NULL;
+    const char * archivo = NULL;
+    uint32_t muestras = MUESTRAS;
+    FILE * json = NULL;
+    bool primera = true;
+    int opcion;
+
+    while ((opcion = getopt(argc, argv, "r:f:j:")) != -1)
+    {
+        switch (opcion)
+        {
+        case 'r':
+            muestras = strtoul(optarg, NULL, 10);
+            break;
+        case 'f':
+            filtro = optarg;
+            break;
+        case 'j':
+            archivo = optarg;
+            break;
+        default:
+            fprintf(stderr, "uso: %s [-r muestras] [-f filtro] [-j archivo.json]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((muestras < 3) || (muestras > MUESTRAS_MAXIMAS))
+    {
+        fprintf(stderr, "la cantidad de muestras debe estar entre 3 y %d\n", MUESTRAS_MAXIMAS);
+        return 2;
+    }
+
+    if (archivo && !(json = fopen(archivo, "w")))
+    {
+        perror(archivo);
+        return 1;
+    }
+
+    contador = AbrirContador();
+    if (contador < 0)
+    {
+        fprintf(stderr, "sin contador de instrucciones, se informa solo el tiempo\n");
+    }
+
+    printf("%-22s %10s %10s %8s %10s %8s %9s %7s\n", "prueba", "ns/op", "min", "desvio", "instr/op", "escr/op", "ops",
+           "desc");
+    if (json)
+    {
+        fprintf(json, "{\n  \"compilador\": \"%s\",\n  \"muestras\": %u,\n  \"pruebas\": [", __VERSION__, muestras);
+    }
+
+    for (size_t indice = 0; indice < sizeof(PRUEBAS) / sizeof(PRUEBAS[0]); indice++)
+    {
+        const prueba_t * prueba = &PRUEBAS[indice];
+        resultado_t resultado;
+
+        if (filtro && !strstr(prueba->nombre, filtro))
+        {
+            continue;
+        }
+
+        Medir(prueba, muestras, &resultado);
+        printf("%-22s %10.3f %10.3f %8.3f ", prueba->nombre, resultado.mediana, resultado.minimo, resultado.desvio);
+        if (resultado.instrucciones >= 0)
+        {
+            printf("%10.2f", resultado.instrucciones);
+        }
+        else
+        {
+            printf("%10s", "-");
+        }
+        printf(" %8.2f %9u %3u/%-3u\n", resultado.escrituras, resultado.operaciones, resultado.descartadas, muestras);
+        fflush(stdout);
+
+        if (json)
+        {
+            fprintf(json, "%s\n    {\"nombre\": \"%s\", \"ns_op\": %.4f, \"ns_op_min\": %.4f, \"desvio\": %.4f, ",
+                    primera ? "" : ",", prueba->nombre, resultado.mediana, resultado.minimo, resultado.desvio);
+            if (resultado.instrucciones >= 0)
+            {
+                fprintf(json, "\"instrucciones_op\": %.3f, ", resultado.instrucciones);
+            }
+            else
+            {
+                fprintf(json, "\"instrucciones_op\": null, ");
+            }
+            fprintf(json, "\"escrituras_op\": %.3f, \"operaciones\": %u, \"muestras\": %u, \"descartadas\": %u}",
+                    resultado.escrituras, resultado.operaciones, resultado.muestras, resultado.descartadas);
+            primera = false;
+        }
+    }
+
+    if (json)
+    {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+
+    return 0;
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Compara dos resultados de las pruebas de rendimiento de tools/rendimiento.c.
+
+Las instrucciones por operación son casi deterministas y se comparan con un umbral chico. El tiempo depende de la
+carga de la computadora y se compara con un umbral mayor, solo entre resultados tomados en la misma computadora.
+
+Uso: rendimiento.py anterior.json nuevo.json [--umbral 2] [--umbral-tiempo 10]
+     Termina con error si alguna prueba empeora más que el umbral.
+"""
+
+import argparse
+import json
+import sys
+
+
+def cambio(anterior, nuevo):
+    """Devuelve la variación porcentual, o None si falta alguno de los valores."""
+    if anterior is None or nuevo is None or anterior == 0:
+        return None
+    return 100.0 * (nuevo - anterior) / anterior
+
+
+def columna(anterior, nuevo, variacion, formato):
+    if anterior is None or nuevo is None:
+        return "%26s" % "-"
+    return "%s -> %s %+6.1f%%" % (formato % anterior, formato % nuevo, variacion)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("anterior", help="resultados de referencia")
+    parser.add_argument("nuevo", help="resultados a comparar")
+    parser.add_argument("--umbral", type=float, default=2.0, help="aumento tolerado de instrucciones, en %%")
+    parser.add_argument("--umbral-tiempo", type=float, default=10.0, help="aumento tolerado del tiempo, en %%")
+    args = parser.parse_args()
+
+    with open(args.anterior) as archivo:
+        anteriores = {prueba["nombre"]: prueba for prueba in json.load(archivo)["pruebas"]}
+    with open(args.nuevo) as archivo:
+        nuevas = json.load(archivo)["pruebas"]
+
+    peores = []
+    print("%-22s %26s %26s" % ("prueba", "ns/op", "instr/op"))
+    for prueba in nuevas:
+        nombre = prueba["nombre"]
+        anterior = anteriores.get(nombre)
+        if anterior is None:
+            print("%-22s nueva" % nombre)
+            continue
+        tiempo = cambio(anterior["ns_op"], prueba["ns_op"])
+        instrucciones = cambio(anterior["instrucciones_op"], prueba["instrucciones_op"])
+        marca = ""
+        if instrucciones is not None and instrucciones > args.umbral:
+            marca = "  << instrucciones"
+        elif tiempo is not None and tiempo > args.umbral_tiempo:
+            marca = "  << tiempo"
+        if marca:
+            peores.append(nombre)
+        print("%-22s %26s %26s%s" % (
+            nombre, columna(anterior["ns_op"], prueba["ns_op"], tiempo, "%7.2f"),
+            columna(anterior["instrucciones_op"], prueba["instrucciones_op"], instrucciones, "%7.1f"), marca))
+
+    if peores:
+        print("empeoraron: %s" % ", ".join(peores), file=sys.stderr)
+    return 1 if peores else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
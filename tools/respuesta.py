@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Calcula el peor tiempo de respuesta de cada tarea e interrupción y lo compara con sus plazos.
+
+Lee las activaciones que escribe la simulación en tiempo virtual con el comando activaciones del guion: cada trabajo
+de cada tarea con el tick en que se liberó y las sondas de perfil.h que ejecutó. El costo de un trabajo es el costo
+base de la tarea más el de cada sonda por la cantidad de veces que la ejecutó, con los costos medidos en la placa con
+el comando sondas de la consola. El peor costo de cada tarea y la menor separación entre sus liberaciones alimentan el
+análisis de tiempo de respuesta con prioridades fijas y desalojo, que da una cota para cada una. Después se simulan
+los mismos trabajos con esos costos, junto con las interrupciones periódicas, y se comprueba que ninguna respuesta
+supere la cota. Las prioridades de las tareas son las de FreeRTOS; las interrupciones se indican con el nivel del
+NVIC, donde un número menor es más prioritario, y desalojan a cualquier tarea.
+
+Uso: respuesta.py ACTIVACIONES... --tarea NOMBRE=PRIORIDAD,COSTO_US,PLAZO_US[,PERIODO_US] [--sonda NOMBRE=COSTO_US]
+                  [--anidada SONDA] [--interrupcion NOMBRE=NIVEL,COSTO_US,PERIODO_US[,PLAZO_US]] [--bloqueo US]
+"""
+
+import argparse
+import heapq
+import math
+import sys
+
+# Las interrupciones quedan por encima de cualquier prioridad de FreeRTOS
+PRIORIDAD_INTERRUPCION = 1000
+# Iteraciones del análisis antes de darlo por divergente
+ITERACIONES = 10000
+
+
+class Tarea:
+    def __init__(self, nombre, prioridad, costo, plazo, periodo, interrupcion=False):
+        self.nombre, self.prioridad, self.base = nombre, prioridad, costo
+        self.plazo, self.periodo, self.interrupcion = plazo, periodo, interrupcion
+        self.costo = costo
+        self.separacion = None
+        self.trabajos = 0
+        self.cota = None
+        self.simulada = 0.0
+
+
+def numero(texto):
+    return None if texto in ("", "-") else float(texto)
+
+
+def leer_tarea(texto):
+    nombre, _, valores = texto.partition("=")
+    campos = valores.split(",")
+    if len(campos) not in (3, 4):
+        raise argparse.ArgumentTypeError("se esperaba NOMBRE=PRIORIDAD,COSTO_US,PLAZO_US[,PERIODO_US]: %s" % texto)
+    periodo = numero(campos[3]) if len(campos) == 4 else None
+    return Tarea(nombre, int(campos[0]), float(campos[1]), numero(campos[2]), periodo)
+
+
+def leer_interrupcion(texto):
+    nombre, _, valores = texto.partition("=")
+    campos = valores.split(",")
+    if len(campos) not in (3, 4):
+        raise argparse.ArgumentTypeError("se esperaba NOMBRE=NIVEL,COSTO_US,PERIODO_US[,PLAZO_US]: %s" % texto)
+    plazo = numero(campos[3]) if len(campos) == 4 else None
+    return Tarea(nombre, PRIORIDAD_INTERRUPCION - int(campos[0]), float(campos[1]), plazo, float(campos[2]), True)
+
+
+def leer_sonda(texto):
+    nombre, _, costo = texto.partition("=")
+    return nombre, float(costo)
+
+
+def leer_activaciones(archivo, tareas, costos, anidadas, tick, avisos):
+    """Devuelve los trabajos del archivo como (liberación en us, nombre, costo), uniendo los de un mismo tick."""
+    trabajos = {}
+    with open(archivo, encoding="utf-8") as entrada:
+        for linea in entrada:
+            campos = linea.rstrip("\n").split("\t")
+            if len(campos) < 2:
+                continue
+            liberacion, nombre = int(campos[0]), campos[1]
+            tarea = tareas.get(nombre)
+            if tarea is None:
+                avisos.add("la tarea %s no tiene prioridad ni costo, no se analiza" % nombre)
+                continue
+            costo = 0.0
+            if len(campos) > 2 and campos[2]:
+                for sonda in campos[2].split(","):
+                    sonda, _, veces = sonda.partition(":")
+                    if sonda in anidadas:
+                        continue
+                    if sonda not in costos:
+                        avisos.add("la sonda %s no tiene costo, no suma" % sonda)
+                        continue
+                    costo += costos[sonda] * int(veces)
+            # Un trabajo que se bloquea y se vuelve a liberar en el mismo tick es, para el análisis, uno solo
+            clave = (liberacion, nombre)
+            trabajos[clave] = trabajos.get(clave, 0.0) + costo
+    resultado = []
+    for (liberacion, nombre), costo in trabajos.items():
+        resultado.append((liberacion * tick, nombre, tareas[nombre].base + costo))
+    resultado.sort()
+    return resultado
+
+
+def caracterizar(trabajos, tareas):
+    anteriores = {}
+    for liberacion, nombre, costo in trabajos:
+        tarea = tareas[nombre]
+        tarea.trabajos += 1
+        tarea.costo = max(tarea.costo, costo)
+        if nombre in anteriores:
+            separacion = liberacion - anteriores[nombre]
+            if tarea.separacion is None or separacion < tarea.separacion:
+                tarea.separacion = separacion
+        anteriores[nombre] = liberacion
+
+
+def cota(tarea, todas, bloqueo):
+    """Iteración del análisis de tiempo de respuesta, None si no converge antes de superar el plazo."""
+    interferentes = [otra for otra in todas if otra is not tarea and otra.prioridad >= tarea.prioridad]
+    for otra in interferentes:
+        if otra.periodo is None and otra.separacion is None:
+            return None
+    limite = 100 * (tarea.plazo or tarea.periodo or tarea.separacion or 1e6)
+    # Las interrupciones del mismo nivel no se desalojan: la que llega espera a la que está atendiendo y a las que
+    # llegaron mientras tanto, una por cada llegada de cada otra antes de que empiece
+    if tarea.interrupcion:
+        return cota_interrupcion(tarea, interferentes, limite)
+    respuesta = tarea.costo + bloqueo
+    for _ in range(ITERACIONES):
+        siguiente = tarea.costo + bloqueo
+        for otra in interferentes:
+            siguiente += math.ceil(respuesta / (otra.periodo or otra.separacion)) * otra.costo
+        if siguiente == respuesta:
+            return respuesta
+        if siguiente > limite:
+            return None
+        respuesta = siguiente
+    return None
+
+
+def cota_interrupcion(tarea, interferentes, limite):
+    """Análisis no expropiativo dentro del nivel de la interrupción, None si no converge antes del límite."""
+    mismo_nivel = [otra for otra in interferentes if otra.prioridad == tarea.prioridad]
+    superiores = [otra for otra in interferentes if otra.prioridad > tarea.prioridad]
+    inicio = sum(otra.costo for otra in mismo_nivel)
+    for _ in range(ITERACIONES):
+        siguiente = sum((math.floor(inicio / (otra.periodo or otra.separacion)) + 1) * otra.costo
+                        for otra in mismo_nivel)
+        siguiente += sum(math.ceil(inicio / (otra.periodo or otra.separacion)) * otra.costo for otra in superiores)
+        if siguiente == inicio:
+            return inicio + tarea.costo
+        if siguiente > limite:
+            return None
+        inicio = siguiente
+    return None
+
+
+def simular(trabajos, tareas, interrupciones):
+    """Desalojo por prioridad fija, en orden de llegada dentro de una misma prioridad; actualiza la peor respuesta."""
+    llegadas = list(trabajos)
+    if not llegadas:
+        return
+    fin = llegadas[-1][0]
+    for interrupcion in interrupciones:
+        instante = 0.0
+        while instante <= fin:
+            llegadas.append((instante, interrupcion.nombre, interrupcion.costo))
+            instante += interrupcion.periodo
+    llegadas.sort()
+
+    listos = []
+    ahora = 0.0
+    orden = 0
+    for liberacion, nombre, costo in llegadas + [(math.inf, None, 0.0)]:
+        # Ejecuta los trabajos listos hasta la próxima llegada
+        while listos and ahora < liberacion:
+            prioridad, inicio, numero_orden, restante, tarea = listos[0]
+            paso = min(restante, liberacion - ahora)
+            ahora += paso
+            restante -= paso
+            if restante <= 1e-9:
+                heapq.heappop(listos)
+                tarea.simulada = max(tarea.simulada, ahora - inicio)
+            else:
+                listos[0] = (prioridad, inicio, numero_orden, restante, tarea)
+        if nombre is None:
+            break
+        ahora = max(ahora, liberacion)
+        tarea = tareas[nombre]
+        orden += 1
+        heapq.heappush(listos, (-tarea.prioridad, liberacion, orden, costo, tarea))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("activaciones", nargs="+", help="archivos que escribe el comando activaciones del guion")
+    parser.add_argument("--tarea", action="append", default=[], type=leer_tarea,
+                        metavar="NOMBRE=PRIORIDAD,COSTO_US,PLAZO_US[,PERIODO_US]",
+                        help="prioridad de FreeRTOS, costo base de cada trabajo, plazo de respuesta o - si no tiene, "
+                             "y período si no se quiere tomar la menor separación observada")
+    parser.add_argument("--sonda", action="append", default=[], type=leer_sonda, metavar="NOMBRE=COSTO_US",
+                        help="peor duración medida de una sonda de perfil.h")
+    parser.add_argument("--anidada", action="append", default=[], metavar="SONDA",
+                        help="sonda que se mide dentro de otra, cuyo costo ya la incluye")
+    parser.add_argument("--interrupcion", action="append", default=[], type=leer_interrupcion,
+                        metavar="NOMBRE=NIVEL,COSTO_US,PERIODO_US[,PLAZO_US]",
+                        help="interrupción periódica o con la menor separación entre llegadas indicada")
+    parser.add_argument("--bloqueo", type=float, default=0.0, metavar="US",
+                        help="sección crítica más larga del núcleo y del firmware, que demora a cualquier tarea")
+    parser.add_argument("--tick", type=float, default=1000.0, metavar="US", help="período del tick")
+    args = parser.parse_args()
+
+    tareas = {tarea.nombre: tarea for tarea in args.tarea + args.interrupcion}
+    costos = dict(args.sonda)
+    avisos = set()
+
+    registros = []
+    for archivo in args.activaciones:
+        try:
+            registros.append(leer_activaciones(archivo, tareas, costos, set(args.anidada), args.tick, avisos))
+        except OSError as error:
+            print("respuesta.py: %s" % error, file=sys.stderr)
+            return 1
+    for trabajos in registros:
+        caracterizar(trabajos, tareas)
+    for trabajos in registros:
+        simular(trabajos, tareas, args.interrupcion)
+
+    todas = list(tareas.values())
+    for tarea in todas:
+        if not tarea.interrupcion and tarea.trabajos == 0 and tarea.periodo is None:
+            avisos.add("la tarea %s no aparece en las activaciones" % tarea.nombre)
+    for tarea in todas:
+        tarea.cota = cota(tarea, todas, args.bloqueo)
+
+    perdidos = False
+    inconsistente = False
+    print("%-16s %9s %9s %9s %10s %10s %10s  %s" %
+          ("tarea", "prioridad", "costo", "periodo", "cota", "simulada", "plazo", "resultado"))
+    for tarea in sorted(todas, key=lambda tarea: -tarea.prioridad):
+        periodo = tarea.periodo or tarea.separacion
+        if tarea.cota is None:
+            resultado = "sin cota, puede perder el plazo" if tarea.plazo else "sin cota"
+            perdidos = perdidos or tarea.plazo is not None
+        elif tarea.plazo is not None and tarea.simulada > tarea.plazo:
+            resultado = "pierde el plazo"
+            perdidos = True
+        elif tarea.plazo is not None and tarea.cota > tarea.plazo:
+            resultado = "puede perder el plazo"
+            perdidos = True
+        else:
+            resultado = "cumple" if tarea.plazo is not None else "-"
+        if tarea.cota is not None and tarea.simulada > tarea.cota + 1e-6:
+            resultado += ", la simulación supera la cota"
+            inconsistente = True
+        if tarea.interrupcion:
+            prioridad = "nivel %d" % (PRIORIDAD_INTERRUPCION - tarea.prioridad)
+        else:
+            prioridad = "%d" % tarea.prioridad
+        print("%-16s %9s %9.1f %9s %10s %10.1f %10s  %s" %
+              (tarea.nombre, prioridad, tarea.costo, "%.0f" % periodo if periodo else "-",
+               "%.1f" % tarea.cota if tarea.cota is not None else "-", tarea.simulada,
+               "%.0f" % tarea.plazo if tarea.plazo is not None else "-", resultado))
+
+    for aviso in sorted(avisos):
+        print("aviso: %s" % aviso)
+
+    if inconsistente:
+        return 1
+    return 2 if perdidos else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
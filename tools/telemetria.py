@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Decodifica la telemetría que el reloj despertador envía por la UART de depuración.
+
+Cada trama está codificada con COBS y termina en un byte cero. Sin codificar contiene el tipo, el número de
+secuencia, los datos en little endian y un CRC-16/CCITT. El formato se define en src/telemetria.c.
+
+Las respuestas de la consola que comparte la UART también terminan en cero y se muestran como texto. Con la consola
+compilada la telemetría empieza deshabilitada: se habilita escribiendo telemetria si en la terminal.
+
+Uso: telemetria.py /dev/ttyUSB1 [--baudios 115200]    (o la pseudo terminal que informa tools/telemetria_pty.c)
+"""
+
+import argparse
+import os
+import struct
+import sys
+import termios
+
+from traza import EVENTOS, MODOS
+
+ESTADO = 1
+TRAZA = 2
+
+CAMPOS_ESTADO = struct.Struct("<I3s3sBBIIIH5I6II")
+EVENTO = struct.Struct("<II")
+
+
+def cobs_decodificar(datos):
+    salida = bytearray()
+    index = 0
+    while index < len(datos):
+        codigo = datos[index]
+        if codigo == 0 or index + codigo > len(datos) + 1:
+            raise ValueError("COBS inválido")
+        salida += datos[index + 1:index + codigo]
+        index += codigo
+        if codigo < 0xFF and index < len(datos):
+            salida.append(0)
+    return bytes(salida)
+
+
+def crc16(datos):
+    crc = 0xFFFF
+    for byte in datos:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def hora(bcd):
+    return "%02x:%02x:%02x" % tuple(bcd)
+
+
+def mostrar_estado(secuencia, datos):
+    (uptime, actual, alarma, modo, banderas, principal, barrido, perdidos, inactivo, muestras, minimo, promedio, p99,
+     maximo, activaciones, retrasadas, perdidas, mayor, fluctuacion_p99, fluctuacion_max, traza) = \
+        CAMPOS_ESTADO.unpack_from(datos)
+    print("[%3d] estado  t=%d ms  hora %s%s  alarma %s%s%s  modo %s" % (
+        secuencia, uptime, hora(actual), "" if banderas & 1 else " (sin ajustar)", hora(alarma),
+        " habilitada" if banderas & 2 else "", " SONANDO" if banderas & 4 else "",
+        MODOS[modo] if modo < len(MODOS) else modo))
+    print("       despertares %d/%d  eventos perdidos %d  inactivo %s  traza %d" % (
+        principal, barrido, perdidos, "-" if inactivo == 0xFFFF else "%.1f%%" % (inactivo / 10), traza))
+    if muestras:
+        print("       latencia n=%d min/prom/p99/max %d/%d/%d/%d ticks" % (muestras, minimo, promedio, p99, maximo))
+    if activaciones:
+        print("       barrido %d activaciones, %d retrasadas, %d perdidas, fluctuación p99 %.1f%% max %.1f%%" % (
+            activaciones, retrasadas, perdidas, fluctuacion_p99 / 10, fluctuacion_max / 10))
+
+
+def mostrar_traza(secuencia, datos):
+    primero, cantidad = struct.unpack_from("<IB", datos)
+    for numero in range(cantidad):
+        marca, evento = EVENTO.unpack_from(datos, 5 + numero * EVENTO.size)
+        tipo = evento & 0xFF
+        a, b, c = (evento >> 8) & 0xFF, (evento >> 16) & 0xFF, (evento >> 24) & 0xFF
+        etiqueta, formato = EVENTOS.get(tipo, ("DESCONOCIDO_%d" % tipo, lambda a, b, c: "%02x %02x %02x" % (a, b, c)))
+        print("[%3d] traza   #%d %10d  %-14s %s" % (secuencia, primero + numero, marca, etiqueta, formato(a, b, c)))
+
+
+def procesar(trama):
+    if trama.endswith(b"> "):  # Respuesta de la consola, que comparte la UART
+        print(trama[:-2].decode("ascii", errors="replace").replace("\r\n", "\n"), end="")
+        return None
+    try:
+        datos = cobs_decodificar(trama)
+    except ValueError as error:
+        return str(error)
+    if len(datos) < 4 or crc16(datos[:-2]) != struct.unpack_from("<H", datos, len(datos) - 2)[0]:
+        return "CRC inválido"
+
+    tipo, secuencia, carga = datos[0], datos[1], datos[2:-2]
+    if tipo == ESTADO and len(carga) >= CAMPOS_ESTADO.size:
+        mostrar_estado(secuencia, carga)
+    elif tipo == TRAZA and len(carga) >= 5:
+        mostrar_traza(secuencia, carga)
+    else:
+        return "trama de tipo %d desconocida" % tipo
+    return None
+
+
+def abrir(ruta, baudios, modo=os.O_RDONLY):
+    descriptor = os.open(ruta, modo | os.O_NOCTTY)
+    if os.isatty(descriptor):
+        atributos = termios.tcgetattr(descriptor)
+        velocidad = getattr(termios, "B%d" % baudios)
+        atributos[0] = 0                                 # iflag: sin traducciones de entrada
+        atributos[1] = 0                                 # oflag
+        atributos[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        atributos[3] = 0                                 # lflag: modo crudo, sin eco
+        atributos[4] = atributos[5] = velocidad
+        atributos[6][termios.VMIN] = 1
+        atributos[6][termios.VTIME] = 0
+        termios.tcsetattr(descriptor, termios.TCSANOW, atributos)
+    return descriptor
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("puerto", help="puerto serie, pseudo terminal o archivo con la captura")
+    parser.add_argument("--baudios", type=int, default=115200, help="velocidad del puerto serie")
+    args = parser.parse_args()
+
+    descriptor = abrir(args.puerto, args.baudios)
+    pendiente = bytearray()
+    sincronizado = False
+    descartadas = 0
+
+    try:
+        while True:
+            datos = os.read(descriptor, 256)
+            if not datos:
+                break
+            pendiente += datos
+            while 0 in pendiente:
+                fin = pendiente.index(0)
+                trama, pendiente = bytes(pendiente[:fin]), pendiente[fin + 1:]
+                if not sincronizado:  # Lo anterior al primer delimitador puede ser una trama incompleta
+                    sincronizado = True
+                    continue
+                error = procesar(trama)
+                if error:
+                    descartadas += 1
+                    print("trama descartada (%s), %d en total" % (error, descartadas), file=sys.stderr)
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(descriptor)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
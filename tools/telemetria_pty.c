@@ -0,0 +1,171 @@
+/************************************************************************************************
+Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+SPDX-License-Identifier: MIT
+*************************************************************************************************/
+
+/** \brief Simulador de telemetría en una pseudo terminal
+ **
+ ** Publica en una pseudo terminal las mismas tramas que envía el equipo por la UART de depuración, generadas con el
+ ** codificador de src/telemetria.c a partir de un estado simulado, para probar tools/telemetria.py sin la placa:
+ **
+ **     gcc -Iinc -o telemetria_pty tools/telemetria_pty.c src/telemetria.c src/traza.c
+ **     ./telemetria_pty &
+ **     python3 tools/telemetria.py /dev/pts/N
+ **
+ ** \addtogroup herramientas HERRAMIENTAS
+ ** \brief Herramientas para la computadora
+ ** @{ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include "telemetria.h"
+#include "traza.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/**
+ * @brief Base de tiempo simulada de la traza, en ticks de un milisegundo.
+ */
+static uint32_t Ticks(void);
+
+/**
+ * @brief Avanza un segundo una hora de seis dígitos BCD.
+ */
+static void AvanzarSegundo(uint8_t * hora);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+static uint32_t ticks = 0;
+
+/* === Private function implementation ========================================================= */
+
+static uint32_t Ticks(void)
+{
+    return ticks;
+}
+
+static void AvanzarSegundo(uint8_t * hora)
+{
+    static const uint8_t LIMITES[6] = {2, 9, 5, 9, 5, 9};
+
+    for (int digito = 5; digito >= 0; digito--)
+    {
+        if (hora[digito] < LIMITES[digito] && !(digito == 1 && hora[0] == 2 && hora[1] == 3))
+        {
+            hora[digito]++;
+            return;
+        }
+        hora[digito] = 0;
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(int argc, char * argv[])
+{
+    static uint8_t salida[2 * TELEMETRY_MAX_FRAME];
+    telemetry_status_t estado = {
+        .time = {1, 2, 5, 9, 3, 0},
+        .alarm = {1, 3, 0, 0, 0, 0},
+        .mode = 1,
+        .time_valid = true,
+        .alarm_enabled = true,
+        .idle = 975,
+    };
+    uint32_t cursor = 0;
+    uint32_t milisegundos = 0;
+    uint32_t periodo = (argc > 1) ? strtoul(argv[1], NULL, 10) : TELEMETRY_PERIOD;
+    struct termios modo;
+    int maestro, esclavo;
+
+    maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((maestro < 0) || grantpt(maestro) || unlockpt(maestro))
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+
+    // El extremo esclavo queda abierto y en modo crudo para que la terminal no altere los bytes de las tramas
+    esclavo = open(ptsname(maestro), O_RDWR | O_NOCTTY);
+    tcgetattr(esclavo, &modo);
+    cfmakeraw(&modo);
+    tcsetattr(esclavo, TCSANOW, &modo);
+    printf("%s\n", ptsname(maestro));
+    fflush(stdout);
+
+    TraceSetTimebase(Ticks);
+    while (true)
+    {
+        ticks += periodo;
+        for (milisegundos += periodo; milisegundos >= 1000; milisegundos -= 1000)
+        {
+            AvanzarSegundo(estado.time);
+        }
+
+        // Simula una pulsación de tecla y algo de actividad de la interfaz cada tanto
+        if ((ticks / periodo) % 5 == 0)
+        {
+            TraceRecord(TRACE_KEY_PRESSED, 4);
+            TraceRecord(TRACE_MODE_CHANGE, TRACE_DATA(1, 2, 0));
+            TraceRecord(TRACE_KEY_RELEASED, 4);
+            estado.latency.samples++;
+        }
+
+        estado.uptime = ticks;
+        estado.main_wakeups++;
+        estado.scan_wakeups += periodo;
+        estado.latency.min = 3;
+        estado.latency.mean = 4;
+        estado.latency.p99 = 7;
+        estado.latency.max = 9;
+        estado.scan.activations = estado.scan_wakeups;
+        estado.scan.jitter.p99 = 40;
+        estado.scan.jitter.max = 120;
+        estado.trace_written = TraceCount();
+
+        uint16_t largo = TelemetryEncodeStatus(&estado, salida, sizeof(salida));
+        largo += TelemetryEncodeTrace(&cursor, salida + largo, sizeof(salida) - largo);
+        if (write(maestro, salida, largo) < 0)
+        {
+            perror("write");
+            return 1;
+        }
+        usleep(periodo * 1000);
+    }
+}
+
+/* === End of documentation ==================================================================== */
+
+/** @} End of module definition for doxygen */
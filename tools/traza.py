@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023, Guillermo Nicolás Brito <guillermonbrito@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Decodifica el buffer de traza del reloj despertador.
+
+El archivo de entrada es una copia binaria del buffer `traza` de src/traza.c, por ejemplo obtenida en gdb con:
+
+    dump binary value traza.bin traza
+
+Uso: traza.py traza.bin [--big]
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x315A5254
+
+# Deben coincidir con modo_t y tecla_t de src/main.c
+MODOS = ["SIN_CONFIGURAR", "MOSTRANDO_HORA", "AJUSTANDO_MINUTOS_ACTUAL", "AJUSTANDO_HORAS_ACTUAL",
+         "AJUSTANDO_MINUTOS_ALARMA", "AJUSTANDO_HORAS_ALARMA", "PANTALLA_APAGADA"]
+TECLAS = ["AJUSTAR_TIEMPO", "AJUSTAR_ALARMA", "DECREMENTAR", "INCREMENTAR", "ACEPTAR", "CANCELAR"]
+TAREAS = {1: "barrido"}
+
+
+def nombre(tabla, indice):
+    if isinstance(tabla, dict):
+        return tabla.get(indice, str(indice))
+    return tabla[indice] if indice < len(tabla) else str(indice)
+
+
+def hora(a, b, c):
+    return "%02x:%02x:%02x" % (a, b, c)
+
+
+# Deben coincidir con trace_event_t de inc/traza.h
+EVENTOS = {
+    1: ("MODE_CHANGE", lambda a, b, c: "%s -> %s" % (nombre(MODOS, a), nombre(MODOS, b))),
+    2: ("KEY_PRESSED", lambda a, b, c: nombre(TECLAS, a)),
+    3: ("KEY_RELEASED", lambda a, b, c: nombre(TECLAS, a)),
+    4: ("CLOCK_SET", hora),
+    5: ("ALARM_SET", hora),
+    6: ("ALARM_FIRE", lambda a, b, c: "pospuesta" if a else "normal"),
+    7: ("ALARM_SNOOZE", lambda a, b, c: "%d min" % a),
+    8: ("ALARM_CANCEL", lambda a, b, c: ""),
+    9: ("DEADLINE_MISS", lambda a, b, c: "%s +%d periodos" % (nombre(TAREAS, a), b | (c << 8))),
+}
+
+
+def decodificar(datos, orden):
+    magic, capacidad, tamanio, escritos = struct.unpack_from(orden + "IHHI", datos, 0)
+    if magic != MAGIC:
+        raise ValueError("el archivo no comienza con el identificador de la traza")
+    if tamanio != 8 or len(datos) < 12 + capacidad * tamanio:
+        raise ValueError("el tamaño del buffer no coincide con el encabezado")
+
+    cantidad = min(escritos, capacidad)
+    for numero in range(escritos - cantidad, escritos):
+        marca, evento = struct.unpack_from(orden + "II", datos, 12 + (numero % capacidad) * tamanio)
+        tipo = evento & 0xFF
+        a, b, c = (evento >> 8) & 0xFF, (evento >> 16) & 0xFF, (evento >> 24) & 0xFF
+        etiqueta, formato = EVENTOS.get(tipo, ("DESCONOCIDO_%d" % tipo, lambda a, b, c: "%02x %02x %02x" % (a, b, c)))
+        yield numero, marca, etiqueta, formato(a, b, c)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("archivo", help="copia binaria del buffer de traza")
+    parser.add_argument("--big", action="store_const", const=">", default="<", dest="orden",
+                        help="el equipo es big endian (por defecto little endian)")
+    args = parser.parse_args()
+
+    with open(args.archivo, "rb") as archivo:
+        datos = archivo.read()
+
+    try:
+        for numero, marca, etiqueta, detalle in decodificar(datos, args.orden):
+            print("%8d %10d  %-14s %s" % (numero, marca, etiqueta, detalle))
+    except ValueError as error:
+        print("traza.py: %s" % error, file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())